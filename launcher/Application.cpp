@@ -100,6 +100,7 @@
 #include <QTranslator>
 #include <QWindow>
 
+#include "BlobStore.h"
 #include "InstanceList.h"
 #include "MTPixmapCache.h"
 
@@ -118,7 +119,10 @@
 #include "settings/INISettingsObject.h"
 #include "settings/Setting.h"
 
+#include "java/JavaProbeCache.h"
 #include "meta/Index.h"
+#include "minecraft/mod/ModDetailsCache.h"
+#include "modplatform/helpers/HashCache.h"
 #include "translations/TranslationsModel.h"
 
 #include <DesktopServices.h>
@@ -565,7 +569,9 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
     // Initialize application settings
     {
         // Provide a fallback for migration from PolyMC
-        m_settings.reset(new INISettingsObject({ BuildConfig.LAUNCHER_CONFIGFILE, "polymc.cfg", "multimc.cfg" }, this));
+        auto settings = new INISettingsObject({ BuildConfig.LAUNCHER_CONFIGFILE, "polymc.cfg", "multimc.cfg" }, this);
+        settings->setWriteBehind(true);
+        m_settings.reset(settings);
 
         // Theming
         m_settings->registerSetting("IconTheme", QString());
@@ -690,6 +696,8 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_settings->registerSetting("ModMetadataDisabled", false);
         m_settings->registerSetting("ModDependenciesDisabled", false);
         m_settings->registerSetting("SkipModpackUpdatePrompt", false);
+        // share identical mod files between instances through reflinks, where the filesystem supports them
+        m_settings->registerSetting("DeduplicateResources", false);
 
         // Minecraft offline player name
         m_settings->registerSetting("LastOfflinePlayerName", "");
@@ -896,6 +904,9 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_metacache->addBase("meta", QDir("meta").absolutePath());
         m_metacache->addBase("java", QDir("cache/java").absolutePath());
         m_metacache->Load();
+        m_hashCache.reset(new Hashing::HashCache("hashcache.json"));
+        m_modDetailsCache.reset(new ModDetailsCache("moddetails.json"));
+        m_javaProbeCache.reset(new JavaProbeCache("javaprobes.json"));
         qDebug() << "<> Cache initialized.";
     }
 
@@ -924,6 +935,8 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
             // save any remaining instance state
             m_instances->saveNow();
         }
+        // settings are written behind, make sure nothing is left pending
+        INISettingsObject::flushAll();
         if (logFile) {
             logFile->flush();
             logFile->close();
@@ -1375,6 +1388,17 @@ std::shared_ptr<JavaInstallList> Application::javalist()
     return m_javalist;
 }
 
+std::shared_ptr<BlobStore> Application::blobStore()
+{
+    if (!m_settings->get("DeduplicateResources").toBool()) {
+        return nullptr;
+    }
+    if (!m_blobStore) {
+        m_blobStore.reset(new BlobStore("blobs"));
+    }
+    return m_blobStore;
+}
+
 QIcon Application::getThemedIcon(const QString& name)
 {
     if (name == "logo") {
@@ -64,6 +64,12 @@ class AccountList;
 class IconList;
 class QNetworkAccessManager;
 class JavaInstallList;
+class BlobStore;
+namespace Hashing {
+class HashCache;
+}
+class ModDetailsCache;
+class JavaProbeCache;
 class ExternalUpdater;
 class BaseProfilerFactory;
 class BaseDetachedToolFactory;
@@ -126,6 +132,18 @@ class Application : public QApplication {
 
     std::shared_ptr<JavaInstallList> javalist();
 
+    /// the shared store for deduplicated resources, null if deduplication is disabled
+    std::shared_ptr<BlobStore> blobStore();
+
+    /// digests of local files, shared by everything that hashes them
+    std::shared_ptr<Hashing::HashCache> hashCache() const { return m_hashCache; }
+
+    /// metadata parsed out of local mod files
+    std::shared_ptr<ModDetailsCache> modDetailsCache() const { return m_modDetailsCache; }
+
+    /// what probing the java binaries on the system found out
+    std::shared_ptr<JavaProbeCache> javaProbeCache() const { return m_javaProbeCache; }
+
     std::shared_ptr<InstanceList> instances() const { return m_instances; }
 
     std::shared_ptr<IconList> icons() const { return m_icons; }
@@ -251,6 +269,10 @@ class Application : public QApplication {
     std::shared_ptr<InstanceList> m_instances;
     std::shared_ptr<IconList> m_icons;
     std::shared_ptr<JavaInstallList> m_javalist;
+    std::shared_ptr<BlobStore> m_blobStore;
+    std::shared_ptr<Hashing::HashCache> m_hashCache;
+    std::shared_ptr<ModDetailsCache> m_modDetailsCache;
+    std::shared_ptr<JavaProbeCache> m_javaProbeCache;
     std::shared_ptr<TranslationsModel> m_translations;
     std::shared_ptr<GenericPageProvider> m_globalSettingsProvider;
     std::unique_ptr<MCEditTool> m_mcedit;
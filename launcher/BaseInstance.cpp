@@ -45,7 +45,6 @@
 #include <QRegularExpression>
 
 #include "settings/INISettingsObject.h"
-#include "settings/OverrideSetting.h"
 #include "settings/Setting.h"
 
 #include "BuildConfig.h"
@@ -58,53 +57,53 @@ BaseInstance::BaseInstance(SettingsObjectPtr globalSettings, SettingsObjectPtr s
     m_global_settings = globalSettings;
     m_rootDir = rootDir;
 
-    m_settings->registerSetting("name", "Unnamed Instance");
-    m_settings->registerSetting("iconKey", "default");
-    m_settings->registerSetting("notes", "");
+    m_settings->declareSetting("name", "Unnamed Instance");
+    m_settings->declareSetting("iconKey", "default");
+    m_settings->declareSetting("notes", "");
 
-    m_settings->registerSetting("lastLaunchTime", 0);
-    m_settings->registerSetting("totalTimePlayed", 0);
+    m_settings->declareSetting("lastLaunchTime", 0);
+    m_settings->declareSetting("totalTimePlayed", 0);
     if (m_settings->get("totalTimePlayed").toLongLong() < 0)
         m_settings->reset("totalTimePlayed");
-    m_settings->registerSetting("lastTimePlayed", 0);
+    m_settings->declareSetting("lastTimePlayed", 0);
 
-    m_settings->registerSetting("linkedInstances", "[]");
+    m_settings->declareSetting("linkedInstances", "[]");
 
     // Game time override
-    auto gameTimeOverride = m_settings->registerSetting("OverrideGameTime", false);
-    m_settings->registerOverride(globalSettings->getSetting("ShowGameTime"), gameTimeOverride);
-    m_settings->registerOverride(globalSettings->getSetting("RecordGameTime"), gameTimeOverride);
+    m_settings->declareSetting("OverrideGameTime", false);
+    m_settings->declareOverride(globalSettings->getSetting("ShowGameTime"), "OverrideGameTime");
+    m_settings->declareOverride(globalSettings->getSetting("RecordGameTime"), "OverrideGameTime");
 
     // NOTE: Sometimees InstanceType is already registered, as it was used to identify the type of
     // a locally stored instance
-    if (!m_settings->getSetting("InstanceType"))
-        m_settings->registerSetting("InstanceType", "");
+    if (!m_settings->contains("InstanceType"))
+        m_settings->declareSetting("InstanceType", "");
 
     // Custom Commands
-    auto commandSetting = m_settings->registerSetting({ "OverrideCommands", "OverrideLaunchCmd" }, false);
-    m_settings->registerOverride(globalSettings->getSetting("PreLaunchCommand"), commandSetting);
-    m_settings->registerOverride(globalSettings->getSetting("WrapperCommand"), commandSetting);
-    m_settings->registerOverride(globalSettings->getSetting("PostExitCommand"), commandSetting);
+    m_settings->declareSetting({ "OverrideCommands", "OverrideLaunchCmd" }, false);
+    m_settings->declareOverride(globalSettings->getSetting("PreLaunchCommand"), "OverrideCommands");
+    m_settings->declareOverride(globalSettings->getSetting("WrapperCommand"), "OverrideCommands");
+    m_settings->declareOverride(globalSettings->getSetting("PostExitCommand"), "OverrideCommands");
 
     // Console
-    auto consoleSetting = m_settings->registerSetting("OverrideConsole", false);
-    m_settings->registerOverride(globalSettings->getSetting("ShowConsole"), consoleSetting);
-    m_settings->registerOverride(globalSettings->getSetting("AutoCloseConsole"), consoleSetting);
-    m_settings->registerOverride(globalSettings->getSetting("ShowConsoleOnError"), consoleSetting);
-    m_settings->registerOverride(globalSettings->getSetting("LogPrePostOutput"), consoleSetting);
+    m_settings->declareSetting("OverrideConsole", false);
+    m_settings->declareOverride(globalSettings->getSetting("ShowConsole"), "OverrideConsole");
+    m_settings->declareOverride(globalSettings->getSetting("AutoCloseConsole"), "OverrideConsole");
+    m_settings->declareOverride(globalSettings->getSetting("ShowConsoleOnError"), "OverrideConsole");
+    m_settings->declareOverride(globalSettings->getSetting("LogPrePostOutput"), "OverrideConsole");
 
-    m_settings->registerPassthrough(globalSettings->getSetting("ConsoleMaxLines"), nullptr);
-    m_settings->registerPassthrough(globalSettings->getSetting("ConsoleOverflowStop"), nullptr);
+    m_settings->declarePassthrough(globalSettings->getSetting("ConsoleMaxLines"));
+    m_settings->declarePassthrough(globalSettings->getSetting("ConsoleOverflowStop"));
 
     // Managed Packs
-    m_settings->registerSetting("ManagedPack", false);
-    m_settings->registerSetting("ManagedPackType", "");
-    m_settings->registerSetting("ManagedPackID", "");
-    m_settings->registerSetting("ManagedPackName", "");
-    m_settings->registerSetting("ManagedPackVersionID", "");
-    m_settings->registerSetting("ManagedPackVersionName", "");
+    m_settings->declareSetting("ManagedPack", false);
+    m_settings->declareSetting("ManagedPackType", "");
+    m_settings->declareSetting("ManagedPackID", "");
+    m_settings->declareSetting("ManagedPackName", "");
+    m_settings->declareSetting("ManagedPackVersionID", "");
+    m_settings->declareSetting("ManagedPackVersionName", "");
 
-    m_settings->registerSetting("Profiler", "");
+    m_settings->declareSetting("Profiler", "");
 }
 
 QString BaseInstance::getPreLaunchCommand()
@@ -178,11 +177,10 @@ void BaseInstance::copyManagedPack(BaseInstance& other)
 
 int BaseInstance::getConsoleMaxLines() const
 {
-    auto lineSetting = m_settings->getSetting("ConsoleMaxLines");
     bool conversionOk = false;
-    int maxLines = lineSetting->get().toInt(&conversionOk);
+    int maxLines = m_settings->get("ConsoleMaxLines").toInt(&conversionOk);
     if (!conversionOk) {
-        maxLines = lineSetting->defValue().toInt();
+        maxLines = m_settings->defValue("ConsoleMaxLines").toInt();
         qWarning() << "ConsoleMaxLines has nonsensical value, defaulting to" << maxLines;
     }
     return maxLines;
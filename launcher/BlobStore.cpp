@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BlobStore.h"
+
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSet>
+
+#include "FileSystem.h"
+#include "Json.h"
+
+namespace {
+QString algorithmName(QCryptographicHash::Algorithm algorithm)
+{
+    switch (algorithm) {
+        case QCryptographicHash::Md5:
+            return "md5";
+        case QCryptographicHash::Sha1:
+            return "sha1";
+        case QCryptographicHash::Sha256:
+            return "sha256";
+        case QCryptographicHash::Sha512:
+            return "sha512";
+        default:
+            return QString::number(static_cast<int>(algorithm));
+    }
+}
+
+// clones `src` next to `dst` and then moves it in place, so an existing `dst` is only replaced on success
+// reflinks share the data but are copy-on-write, so a write to the instance file never shows up in the blob
+bool replaceWithClone(const QString& src, const QString& dst)
+{
+    auto tmp = dst + ".blob";
+    QFile::remove(tmp);
+    std::error_code ec;
+    if (!FS::clone_file(src, tmp, ec))
+        return false;
+    if ((QFileInfo::exists(dst) && !QFile::remove(dst)) || !QFile::rename(tmp, dst)) {
+        QFile::remove(tmp);
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+BlobStore::BlobStore(QString root) : m_root(QDir(root).absolutePath()), m_indexFile(FS::PathCombine(m_root, "references.json"))
+{
+    // the root has to exist to find out which filesystem it is on
+    FS::ensureFolderPathExists(m_root);
+    load();
+}
+
+BlobStore::~BlobStore()
+{
+    save();
+}
+
+QString BlobStore::key(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const
+{
+    return algorithmName(algorithm) + "/" + QString::fromLatin1(hash.toHex());
+}
+
+QString BlobStore::blobPath(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const
+{
+    auto hex = QString::fromLatin1(hash.toHex());
+    return FS::PathCombine(m_root, algorithmName(algorithm), hex.left(2), hex);
+}
+
+bool BlobStore::contains(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const
+{
+    return !hash.isEmpty() && QFileInfo::exists(blobPath(algorithm, hash));
+}
+
+bool BlobStore::add(const QString& path, QCryptographicHash::Algorithm algorithm, const QByteArray& hash)
+{
+    if (hash.isEmpty())
+        return false;
+    auto blob = blobPath(algorithm, hash);
+    auto absolutePath = QFileInfo(path).absoluteFilePath();
+
+    QMutexLocker locker(&m_mutex);
+    if (!canDeduplicate(absolutePath))
+        return false;
+    if (QFileInfo::exists(blob)) {
+        if (!replaceWithClone(blob, absolutePath)) {
+            qWarning() << "Failed to deduplicate" << absolutePath;
+            return false;
+        }
+    } else {
+        std::error_code ec;
+        if (!FS::ensureFilePathExists(blob) || !FS::clone_file(absolutePath, blob, ec)) {
+            QFile::remove(blob);
+            return false;
+        }
+    }
+    addReference(key(algorithm, hash), absolutePath);
+    return true;
+}
+
+bool BlobStore::materialize(QCryptographicHash::Algorithm algorithm, const QByteArray& hash, const QString& dst)
+{
+    if (!contains(algorithm, hash))
+        return false;
+    auto absolutePath = QFileInfo(dst).absoluteFilePath();
+
+    QMutexLocker locker(&m_mutex);
+    if (!FS::ensureFilePathExists(absolutePath) || !canDeduplicate(absolutePath))
+        return false;
+    if (!replaceWithClone(blobPath(algorithm, hash), absolutePath)) {
+        qWarning() << "Failed to materialize blob" << key(algorithm, hash) << "at" << absolutePath;
+        return false;
+    }
+    addReference(key(algorithm, hash), absolutePath);
+    return true;
+}
+
+bool BlobStore::canDeduplicate(const QString& path)
+{
+    if (FS::canClone(m_root, QFileInfo(path).absolutePath()))
+        return true;
+    // full copies of every file would only double the disk usage
+    if (!m_unsupportedLogged) {
+        qInfo() << "Resource deduplication is unavailable: the blob store" << m_root
+                << "and the instances are not on the same filesystem with reflink support";
+        m_unsupportedLogged = true;
+    }
+    return false;
+}
+
+void BlobStore::addReference(const QString& key, const QString& path)
+{
+    auto& references = m_references[key];
+    if (!references.contains(path)) {
+        references.append(path);
+        m_dirty = true;
+    }
+}
+
+void BlobStore::relocate(const QString& from, const QString& to)
+{
+    auto fromPrefix = QDir(from).absolutePath() + '/';
+    auto toPrefix = QDir(to).absolutePath() + '/';
+
+    QMutexLocker locker(&m_mutex);
+    for (auto& references : m_references) {
+        for (auto& path : references) {
+            if (path.startsWith(fromPrefix)) {
+                path = toPrefix + path.mid(fromPrefix.size());
+                m_dirty = true;
+            }
+        }
+    }
+}
+
+qint64 BlobStore::collectGarbage()
+{
+    QMutexLocker collectLocker(&m_collectMutex);
+    QHash<QString, QStringList> references;
+    {
+        QMutexLocker locker(&m_mutex);
+        references = m_references;
+    }
+
+    // the walk only works on a snapshot of the references, so blobs can be added in the meantime
+    QSet<QString> seen;
+    QHash<QString, QStringList> alive;
+    QList<QFileInfo> unused;
+    QDirIterator iter(m_root, QDir::Files, QDirIterator::Subdirectories);
+    while (iter.hasNext()) {
+        auto blob = QFileInfo(iter.next());
+        if (blob.absoluteFilePath() == m_indexFile)
+            continue;
+        auto algorithm = blob.dir();
+        algorithm.cdUp();
+        auto blobKey = algorithm.dirName() + "/" + blob.fileName();
+        seen.insert(blobKey);
+
+        // a reference is alive as long as a file of the same size is at the recorded path
+        auto& blobAlive = alive[blobKey];
+        for (auto& path : references.value(blobKey)) {
+            QFileInfo info(path);
+            if (info.exists() && info.size() == blob.size())
+                blobAlive.append(path);
+        }
+        if (blobAlive.isEmpty())
+            unused.append(blob);
+    }
+
+    qint64 freed = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto& blob : unused) {
+            auto algorithm = blob.dir();
+            algorithm.cdUp();
+            auto blobKey = algorithm.dirName() + "/" + blob.fileName();
+            // it got used again while we were walking
+            if (m_references.value(blobKey) != references.value(blobKey) && !m_references.value(blobKey).isEmpty())
+                continue;
+            auto size = blob.size();
+            if (QFile::remove(blob.absoluteFilePath())) {
+                freed += size;
+                m_dirty |= m_references.remove(blobKey) > 0;
+            }
+            alive.remove(blobKey);
+        }
+        for (auto it = alive.constBegin(); it != alive.constEnd(); ++it) {
+            // only drop the references that were dead during the walk, new ones stay
+            auto& current = m_references[it.key()];
+            for (auto& path : references.value(it.key())) {
+                if (!it->contains(path) && current.removeAll(path) > 0)
+                    m_dirty = true;
+            }
+            if (current.isEmpty())
+                m_references.remove(it.key());
+        }
+
+        // forget about blobs that were removed behind our back
+        for (auto it = m_references.begin(); it != m_references.end();) {
+            if (!seen.contains(it.key()) && it.value() == references.value(it.key())) {
+                it = m_references.erase(it);
+                m_dirty = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    save();
+    if (freed > 0)
+        qDebug() << "Blob store garbage collection freed" << freed << "bytes";
+    return freed;
+}
+
+void BlobStore::load()
+{
+    if (!QFileInfo::exists(m_indexFile))
+        return;
+    try {
+        auto root = Json::requireObject(Json::requireDocument(m_indexFile, "blob store references"));
+        for (auto it = root.constBegin(); it != root.constEnd(); ++it) {
+            QStringList paths;
+            for (auto path : Json::ensureArray(it.value()))
+                paths.append(path.toString());
+            m_references.insert(it.key(), paths);
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Failed to read the blob store references:" << e.cause();
+        m_references.clear();
+    }
+}
+
+void BlobStore::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_dirty)
+        return;
+    QJsonObject root;
+    for (auto it = m_references.constBegin(); it != m_references.constEnd(); ++it)
+        root.insert(it.key(), QJsonArray::fromStringList(it.value()));
+    try {
+        Json::write(root, m_indexFile);
+        m_dirty = false;
+    } catch (const Exception& e) {
+        qWarning() << "Failed to write the blob store references:" << e.cause();
+    }
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QCryptographicHash>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+/* BlobStore
+ * A content addressed store for files that are identical across instances (mod jars, etc.).
+ *
+ * Blobs live in `<root>/<algorithm>/<first two hex chars>/<hex digest>`. The files inside the instances are reflinks of the
+ * blob, so they share their data on disk while writing to one never changes the other. The store only works when the
+ * instances are on the same reflink capable filesystem as the root, otherwise add() and materialize() do nothing.
+ * Every materialized path is recorded as a reference, blobs without any live reference are removed by collectGarbage().
+ */
+class BlobStore {
+   public:
+    using Ptr = std::shared_ptr<BlobStore>;
+
+    explicit BlobStore(QString root);
+    ~BlobStore();
+
+    /// path of the blob for this digest, whether it exists or not
+    QString blobPath(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const;
+    bool contains(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const;
+
+    /// make the already verified file at `path` part of the store, deduplicating it if the blob exists already
+    /// returns false if the file can not be cloned into the store
+    bool add(const QString& path, QCryptographicHash::Algorithm algorithm, const QByteArray& hash);
+
+    /// place the blob at `dst`, returns false if the blob is unknown or it could not be cloned
+    bool materialize(QCryptographicHash::Algorithm algorithm, const QByteArray& hash, const QString& dst);
+
+    /// update the references after the folder `from` was moved to `to` (e.g. when a staged instance is committed)
+    void relocate(const QString& from, const QString& to);
+
+    /// drop dead references and delete the blobs nobody uses anymore, returns the amount of freed bytes
+    /// walks the whole store, so better call it from a worker thread
+    qint64 collectGarbage();
+
+    /// writes the reference index to disk, if anything changed
+    void save();
+
+   private:
+    QString key(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const;
+    /// whether files in the folder of `path` can be reflinked with the store, logs once if they can not
+    bool canDeduplicate(const QString& path);
+    void addReference(const QString& key, const QString& path);
+    void load();
+
+   private:
+    QString m_root;
+    QString m_indexFile;
+    // "<algorithm>/<hex digest>" -> absolute paths referencing the blob
+    QHash<QString, QStringList> m_references;
+    bool m_dirty = false;
+    bool m_unsupportedLogged = false;
+    mutable QMutex m_mutex;
+    // only one collection at a time, without holding up add() and materialize() during the walk
+    QMutex m_collectMutex;
+};
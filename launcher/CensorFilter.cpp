@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CensorFilter.h"
+
+#include <algorithm>
+#include <queue>
+
+CensorFilter::CensorFilter(const QMap<QString, QString>& replacements)
+{
+    m_nodes.emplace_back();
+    for (auto it = replacements.constBegin(); it != replacements.constEnd(); ++it) {
+        if (it.key().isEmpty())
+            continue;
+        int node = 0;
+        for (auto c : it.key()) {
+            char16_t unit = c.unicode();
+            int next = child(node, unit);
+            if (next < 0) {
+                next = static_cast<int>(m_nodes.size());
+                auto& edges = m_nodes[node].next;
+                auto pos = std::lower_bound(edges.begin(), edges.end(), std::make_pair(unit, 0));
+                edges.insert(pos, { unit, next });
+                m_nodes.emplace_back();
+            }
+            node = next;
+        }
+        m_nodes[node].pattern = m_patterns.size();
+        m_patterns.append(it.key());
+        m_replacements.append(it.value());
+    }
+
+    // breadth first, so the fail target of every node is done before the node itself
+    std::queue<int> queue;
+    for (auto& edge : m_nodes[0].next)
+        queue.push(edge.second);
+    while (!queue.empty()) {
+        int node = queue.front();
+        queue.pop();
+        for (auto& [c, next] : m_nodes[node].next) {
+            int fail = m_nodes[node].fail;
+            while (fail > 0 && child(fail, c) < 0)
+                fail = m_nodes[fail].fail;
+            int target = child(fail, c);
+            m_nodes[next].fail = target >= 0 && target != next ? target : 0;
+            auto& failNode = m_nodes[m_nodes[next].fail];
+            m_nodes[next].outputLink = failNode.pattern >= 0 ? m_nodes[next].fail : failNode.outputLink;
+            queue.push(next);
+        }
+    }
+}
+
+int CensorFilter::child(int node, char16_t c) const
+{
+    auto& edges = m_nodes[node].next;
+    auto pos = std::lower_bound(edges.begin(), edges.end(), std::make_pair(c, 0));
+    return pos != edges.end() && pos->first == c ? pos->second : -1;
+}
+
+QString CensorFilter::censor(const QString& in) const
+{
+    if (isEmpty())
+        return in;
+
+    // start and pattern of every match, found in one pass over the string
+    std::vector<std::pair<int, int>> matches;
+    int node = 0;
+    auto data = in.utf16();
+    for (int i = 0; i < in.size(); i++) {
+        char16_t c = data[i];
+        int next;
+        while ((next = child(node, c)) < 0 && node > 0)
+            node = m_nodes[node].fail;
+        node = next < 0 ? 0 : next;
+        for (int out = m_nodes[node].pattern >= 0 ? node : m_nodes[node].outputLink; out >= 0; out = m_nodes[out].outputLink) {
+            int pattern = m_nodes[out].pattern;
+            matches.emplace_back(i - m_patterns[pattern].size() + 1, pattern);
+        }
+    }
+    if (matches.empty())
+        return in;
+
+    std::sort(matches.begin(), matches.end(), [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        if (a.first != b.first)
+            return a.first < b.first;
+        return m_patterns[a.second].size() > m_patterns[b.second].size();
+    });
+    QString out;
+    out.reserve(in.size());
+    int pos = 0;
+    for (auto& [start, pattern] : matches) {
+        if (start < pos)
+            continue;
+        out.append(in.constData() + pos, start - pos);
+        out.append(m_replacements[pattern]);
+        pos = start + m_patterns[pattern].size();
+    }
+    out.append(in.constData() + pos, in.size() - pos);
+    return out;
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include <utility>
+#include <vector>
+
+/* CensorFilter
+ * Replaces secrets (access tokens, session ids, ...) in text, like the game log or an uploaded log file.
+ *
+ * All the secrets are compiled into one Aho-Corasick automaton when the filter is constructed,
+ * so censoring scans every string once, no matter how many secrets there are.
+ * Overlapping secrets are resolved leftmost-longest: the longest secret starting at the first position wins.
+ */
+class CensorFilter {
+   public:
+    CensorFilter() = default;
+    /// maps every secret to its replacement. empty secrets are ignored
+    explicit CensorFilter(const QMap<QString, QString>& replacements);
+
+    bool isEmpty() const { return m_patterns.isEmpty(); }
+    QString censor(const QString& in) const;
+
+   private:
+    struct Node {
+        std::vector<std::pair<char16_t, int>> next;  // sorted by character
+        int fail = 0;
+        int pattern = -1;     // pattern that ends at this node
+        int outputLink = -1;  // closest node on the fail chain that ends a pattern
+    };
+
+    int child(int node, char16_t c) const;
+
+    std::vector<Node> m_nodes;
+    QStringList m_patterns;
+    QStringList m_replacements;
+};
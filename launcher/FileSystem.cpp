@@ -74,6 +74,7 @@
 #include <objbase.h>
 #include <shlobj.h>
 #else
+#include <sys/stat.h>
 #include <utime.h>
 #endif
 
@@ -1654,6 +1655,22 @@ uintmax_t hardLinkCount(const QString& path)
     return count;
 }
 
+FileFingerprint fingerprint(const QFileInfo& info)
+{
+    FileFingerprint result;
+    if (!info.isFile())
+        return result;
+    result.size = info.size();
+    result.modified = info.lastModified().toUTC().toMSecsSinceEpoch();
+    result.metadataChanged = info.metadataChangeTime().toUTC().toMSecsSinceEpoch();
+#ifndef Q_OS_WIN
+    struct stat st;
+    if (::stat(QFile::encodeName(info.absoluteFilePath()).constData(), &st) == 0)
+        result.inode = st.st_ino;
+#endif
+    return result;
+}
+
 #ifdef Q_OS_WIN
 // returns 8.3 file format from long path
 QString shortPathName(const QString& file)
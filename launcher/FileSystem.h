@@ -556,6 +556,29 @@ bool canLink(const QString& src, const QString& dst);
 
 uintmax_t hardLinkCount(const QString& path);
 
+/**
+ * @brief cheap identity of a file's content, without reading it
+ * if any of these changed, the content may have changed too
+ */
+struct FileFingerprint {
+    qint64 size = -1;
+    quint64 inode = 0;           // always 0 on Windows
+    qint64 modified = 0;         // msecs since epoch
+    qint64 metadataChanged = 0;  // msecs since epoch
+
+    bool isValid() const { return size >= 0; }
+    bool operator==(const FileFingerprint& other) const
+    {
+        return size == other.size && inode == other.inode && modified == other.modified && metadataChanged == other.metadataChanged;
+    }
+    bool operator!=(const FileFingerprint& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief fingerprint of the given file, invalid if it is not a file
+ */
+FileFingerprint fingerprint(const QFileInfo& info);
+
 #ifdef Q_OS_WIN
 QString getPathNameInLocal8bit(const QString& file);
 #endif
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FingerprintCache.h"
+
+#include <QDebug>
+#include <QFileInfo>
+
+QJsonArray FingerprintCacheBase::readEntries() const
+{
+    if (!QFileInfo::exists(m_settings.file))
+        return {};
+    try {
+        auto root = Json::requireObject(Json::requireDocument(m_settings.file, m_settings.name));
+        if (Json::ensureInteger(root, "version") != m_settings.version)
+            return {};
+        return Json::ensureArray(root, "entries");
+    } catch (const Exception& e) {
+        warnInvalid(e);
+        return {};
+    }
+}
+
+bool FingerprintCacheBase::writeEntries(const QJsonArray& entries) const
+{
+    QJsonObject root;
+    root.insert("version", m_settings.version);
+    root.insert("entries", entries);
+    try {
+        Json::write(root, m_settings.file);
+        return true;
+    } catch (const Exception& e) {
+        qWarning() << "Failed to write the" << m_settings.name << ":" << e.cause();
+        return false;
+    }
+}
+
+void FingerprintCacheBase::warnInvalid(const Exception& e) const
+{
+    qWarning() << "Failed to read the" << m_settings.name << ":" << e.cause();
+}
+
+void FingerprintCacheBase::fingerprintToJson(const FS::FileFingerprint& fingerprint, QJsonObject& obj)
+{
+    obj.insert("size", fingerprint.size);
+    obj.insert("modified", fingerprint.modified);
+    obj.insert("metadata_changed", fingerprint.metadataChanged);
+    // doubles can't hold every 64 bit inode
+    obj.insert("inode", QString::number(fingerprint.inode));
+}
+
+FS::FileFingerprint FingerprintCacheBase::fingerprintFromJson(const QJsonObject& obj)
+{
+    FS::FileFingerprint fingerprint;
+    fingerprint.size = Json::ensureDouble(obj, "size", -1);
+    fingerprint.modified = Json::ensureDouble(obj, "modified");
+    fingerprint.metadataChanged = Json::ensureDouble(obj, "metadata_changed");
+    fingerprint.inode = Json::ensureString(obj, "inode").toULongLong();
+    return fingerprint;
+}
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QString>
+
+#include <functional>
+#include <optional>
+
+#include "Exception.h"
+#include "FileSystem.h"
+#include "Json.h"
+
+/* FingerprintCacheBase
+ * The parts of FingerprintCache that don't depend on the cached values.
+ */
+class FingerprintCacheBase {
+   public:
+    struct Settings {
+        QString file;
+        /// what the cache is called in log messages
+        QString name;
+        /// files of any other version are ignored, bump it whenever the cached values change meaning
+        int version = 1;
+        /// entries inserted before the cache saves itself, so a crash only loses the last few. 0 to only save when asked to
+        int saveThreshold = 0;
+        /// entries not used for this long are dropped when saving, 0 to keep them
+        qint64 maxUnusedSecs = 30 * 24 * 60 * 60;
+    };
+
+   protected:
+    explicit FingerprintCacheBase(Settings settings) : m_settings(std::move(settings)) {}
+
+    /// the entries in the file, empty if it doesn't exist, can't be read or is of another version
+    QJsonArray readEntries() const;
+    bool writeEntries(const QJsonArray& entries) const;
+    void warnInvalid(const Exception& e) const;
+
+    static void fingerprintToJson(const FS::FileFingerprint& fingerprint, QJsonObject& obj);
+    static FS::FileFingerprint fingerprintFromJson(const QJsonObject& obj);
+
+   protected:
+    const Settings m_settings;
+};
+
+/* FingerprintCache
+ * Values derived from local files, persisted as JSON and kept until the file changes.
+ *
+ * Entries are keyed by a path and are only valid as long as the fingerprint (size, modification time, metadata change time and
+ * inode) of the file stays the same, so anything that touches the file makes its value get derived again.
+ * The cache is persisted to the file in its settings, and entries that were not used for a month are dropped when saving.
+ * The values are converted to and from JSON with the given functions. Every method is safe to call from several threads at once.
+ */
+template <typename Value>
+class FingerprintCache : public FingerprintCacheBase {
+   public:
+    using ToJson = std::function<QJsonObject(const Value&)>;
+    /// may throw if the object is invalid, which drops the whole file
+    using FromJson = std::function<Value(const QJsonObject&)>;
+
+    FingerprintCache(Settings settings, ToJson toJson, FromJson fromJson)
+        : FingerprintCacheBase(std::move(settings)), m_toJson(std::move(toJson)), m_fromJson(std::move(fromJson))
+    {
+        load();
+    }
+    ~FingerprintCache() { save(); }
+
+    /// the value stored for the file, if it didn't change since
+    std::optional<Value> find(const QString& path, const FS::FileFingerprint& fingerprint) const
+    {
+        if (!fingerprint.isValid())
+            return {};
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.constFind(path);
+        if (it == m_entries.constEnd() || it->fingerprint != fingerprint)
+            return {};
+        // only worth writing out once it makes a difference for the expiry
+        auto now = QDateTime::currentSecsSinceEpoch();
+        if (now - it->lastUsed >= s_lastUsedResolution) {
+            it->lastUsed = now;
+            m_dirty = true;
+        }
+        return it->value;
+    }
+
+    /// remembers the value derived from the file in the state described by \p fingerprint
+    void insert(const QString& path, const FS::FileFingerprint& fingerprint, Value value)
+    {
+        // the file is gone, so whatever was stored for it is too
+        if (!fingerprint.isValid()) {
+            remove(path);
+            return;
+        }
+        bool shouldSave;
+        {
+            QMutexLocker locker(&m_mutex);
+            m_entries.insert(path, Entry{ fingerprint, QDateTime::currentSecsSinceEpoch(), std::move(value) });
+            m_dirty = true;
+            shouldSave = m_settings.saveThreshold > 0 && ++m_unsaved >= m_settings.saveThreshold;
+        }
+        if (shouldSave)
+            save();
+    }
+
+    void remove(const QString& path)
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_entries.remove(path))
+            m_dirty = true;
+    }
+
+    /// drops the entries of all the paths not in \p paths
+    void retain(const QSet<QString>& paths)
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (paths.contains(it.key())) {
+                ++it;
+                continue;
+            }
+            it = m_entries.erase(it);
+            m_dirty = true;
+        }
+    }
+
+    /// writes the cache out if anything changed since it was last written
+    void save()
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty)
+            return;
+        auto expired = QDateTime::currentSecsSinceEpoch() - m_settings.maxUnusedSecs;
+        QJsonArray entries;
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (m_settings.maxUnusedSecs > 0 && it->lastUsed < expired) {
+                it = m_entries.erase(it);
+                continue;
+            }
+            QJsonObject obj;
+            obj.insert("path", it.key());
+            fingerprintToJson(it->fingerprint, obj);
+            obj.insert("last_used", it->lastUsed);
+            obj.insert("value", m_toJson(it->value));
+            entries.append(obj);
+            ++it;
+        }
+        if (writeEntries(entries)) {
+            m_dirty = false;
+            m_unsaved = 0;
+        }
+    }
+
+   private:
+    struct Entry {
+        FS::FileFingerprint fingerprint;
+        mutable qint64 lastUsed = 0;  // secs since epoch
+        Value value;
+    };
+
+    static constexpr qint64 s_lastUsedResolution = 24 * 60 * 60;
+
+    void load()
+    {
+        try {
+            for (auto item : readEntries()) {
+                auto obj = Json::ensureObject(item);
+                Entry entry;
+                entry.fingerprint = fingerprintFromJson(obj);
+                entry.lastUsed = Json::ensureDouble(obj, "last_used");
+                entry.value = m_fromJson(Json::ensureObject(obj, "value"));
+                m_entries.insert(Json::ensureString(obj, "path"), entry);
+            }
+        } catch (const Exception& e) {
+            warnInvalid(e);
+            m_entries.clear();
+        }
+    }
+
+   private:
+    ToJson m_toJson;
+    FromJson m_fromJson;
+    QHash<QString, Entry> m_entries;
+    mutable bool m_dirty = false;
+    int m_unsaved = 0;
+    mutable QMutex m_mutex;
+};
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "InstanceIndex.h"
+
+#include <QJsonObject>
+
+namespace {
+// bump this whenever the header keys change, so the index gets rebuilt
+constexpr int s_formatVersion = 1;
+
+bool isString(const QVariant& value)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return value.typeId() == QMetaType::QString;
+#else
+    return value.type() == QVariant::String;
+#endif
+}
+
+QJsonObject valuesToJson(const INIFile& values)
+{
+    QJsonObject obj;
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it)
+        obj.insert(it.key(), it->toString());
+    return obj;
+}
+
+INIFile valuesFromJson(const QJsonObject& obj)
+{
+    INIFile values;
+    for (auto it = obj.constBegin(); it != obj.constEnd(); ++it)
+        values.insert(it.key(), it.value().toString());
+    return values;
+}
+}  // namespace
+
+const QStringList& InstanceIndex::headerKeys()
+{
+    // what the instance list, its views and the total play time need
+    static const QStringList keys = { "InstanceType",   "name",           "iconKey",         "lastLaunchTime",
+                                      "totalTimePlayed", "lastTimePlayed", "ManagedPackName", "linkedInstances" };
+    return keys;
+}
+
+InstanceIndex::InstanceIndex(QString file) : m_cache({ file, "instance index", s_formatVersion, 0, 0 }, valuesToJson, valuesFromJson) {}
+
+std::optional<INIFile> InstanceIndex::find(const QString& path, const FS::FileFingerprint& fingerprint) const
+{
+    return m_cache.find(path, fingerprint);
+}
+
+void InstanceIndex::insert(const QString& path, const FS::FileFingerprint& fingerprint, const INIFile& config)
+{
+    INIFile values;
+    for (auto& key : headerKeys()) {
+        auto it = config.constFind(key);
+        if (it == config.constEnd())
+            continue;
+        // hand edited values can come out of the INI parser as lists, those don't survive the round trip through JSON
+        if (!isString(*it)) {
+            m_cache.remove(path);
+            return;
+        }
+        values.insert(key, *it);
+    }
+    m_cache.insert(path, fingerprint, values);
+}
+
+void InstanceIndex::retain(const QSet<QString>& paths)
+{
+    m_cache.retain(paths);
+}
+
+void InstanceIndex::save()
+{
+    m_cache.save();
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+#include "FingerprintCache.h"
+#include "settings/INIFile.h"
+
+/* InstanceIndex
+ * The few values of every instance config that are needed to list, sort and show the instances, so the launcher can start
+ * without reading every instance.cfg in full.
+ *
+ * Entries are keyed by the absolute path of the config, so anything that touches the file (including the launcher itself) makes
+ * the next start read it again. Entries are kept until their instance is gone, see retain().
+ */
+class InstanceIndex {
+   public:
+    /// the keys kept for every instance
+    static const QStringList& headerKeys();
+
+    explicit InstanceIndex(QString file);
+
+    /// the header values of the config, if they were indexed and the file didn't change since
+    /// safe to call from several threads at once
+    std::optional<INIFile> find(const QString& path, const FS::FileFingerprint& fingerprint) const;
+    /// remembers the header values of the fully read config
+    void insert(const QString& path, const FS::FileFingerprint& fingerprint, const INIFile& config);
+    /// drops the entries of all configs that are not in \p paths
+    void retain(const QSet<QString>& paths);
+
+    void save();
+
+   private:
+    FingerprintCache<INIFile> m_cache;
+};
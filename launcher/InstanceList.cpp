@@ -48,13 +48,19 @@
 #include <QStack>
 #include <QTextStream>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 #include <QUuid>
 #include <QXmlStreamReader>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
 
+#include "Application.h"
 #include "BaseInstance.h"
+#include "BlobStore.h"
 #include "ExponentialSeries.h"
 #include "FileSystem.h"
+#include "InstanceIndex.h"
 #include "InstanceList.h"
 #include "InstanceTask.h"
 #include "NullInstance.h"
@@ -62,14 +68,44 @@
 #include "minecraft/MinecraftInstance.h"
 #include "settings/INISettingsObject.h"
 
+#include <functional>
+
 #ifdef Q_OS_WIN32
 #include <Windows.h>
 #endif
 
 const static int GROUP_FILE_FORMAT_VERSION = 1;
 
+namespace {
+struct InstanceConfig {
+    InstanceId id;
+    QString path;
+    FS::FileFingerprint fingerprint;
+    INIFile values;
+    // false if only the header values came from the index
+    bool complete = false;
+};
+
+// runs on worker threads
+InstanceConfig readInstanceConfig(const QString& instDir, const InstanceId& id, const InstanceIndex& index)
+{
+    InstanceConfig config;
+    config.id = id;
+    config.path = FS::PathCombine(instDir, id, "instance.cfg");
+    // taken before reading, so a change in between makes the next start read the file again instead of missing it
+    config.fingerprint = FS::fingerprint(QFileInfo(config.path));
+    if (auto header = index.find(config.path, config.fingerprint)) {
+        config.values = *header;
+        return config;
+    }
+    config.values.loadFile(config.path);
+    config.complete = true;
+    return config;
+}
+}  // namespace
+
 InstanceList::InstanceList(SettingsObjectPtr settings, const QString& instDir, QObject* parent)
-    : QAbstractListModel(parent), m_globalSettings(settings)
+    : QAbstractListModel(parent), m_globalSettings(settings), m_index(new InstanceIndex("instanceindex.json"))
 {
     resumeWatch();
     // Create aand normalize path
@@ -341,6 +377,8 @@ bool InstanceList::trashInstance(const InstanceId& id)
 
     qDebug() << "Will trash instance" << id;
     QString trashedLoc;
+    // nothing should be written into the instance once it is gone
+    INISettingsObject::flushAll();
 
     if (m_instanceGroupIndex.remove(id)) {
         decreaseGroupCount(cachedGroupId);
@@ -403,12 +441,17 @@ void InstanceList::deleteInstance(const InstanceId& id)
     }
 
     qDebug() << "Will delete instance" << id;
+    INISettingsObject::flushAll();
     if (!FS::deletePath(inst->instanceRoot())) {
         qWarning() << "Deletion of instance" << id << "has not been completely successful ...";
         return;
     }
 
     qDebug() << "Instance" << id << "has been deleted by the launcher.";
+
+    // the instance might have been the last user of some shared files
+    if (auto store = APPLICATION->blobStore())
+        QtConcurrent::run(QThreadPool::globalInstance(), [store] { store->collectGarbage(); });
 }
 
 static QMap<InstanceId, InstanceLocator> getIdMapping(const QList<InstancePtr>& list)
@@ -429,23 +472,32 @@ static QMap<InstanceId, InstanceLocator> getIdMapping(const QList<InstancePtr>&
 QList<InstanceId> InstanceList::discoverInstances()
 {
     qDebug() << "Discovering instances in" << m_instDir;
-    QList<InstanceId> out;
+    QStringList subDirs;
     QDirIterator iter(m_instDir, QDir::Dirs | QDir::NoDot | QDir::NoDotDot | QDir::Readable | QDir::Hidden, QDirIterator::FollowSymlinks);
     while (iter.hasNext()) {
-        QString subDir = iter.next();
+        subDirs.append(iter.next());
+    }
+    // every folder costs a few stat calls, which add up on slow disks
+    std::function<InstanceId(const QString&)> probe = [instDir = m_instDir](const QString& subDir) -> InstanceId {
         QFileInfo dirInfo(subDir);
         if (!QFileInfo(FS::PathCombine(subDir, "instance.cfg")).exists())
-            continue;
+            return {};
         // if it is a symlink, ignore it if it goes to the instance folder
         if (dirInfo.isSymLink()) {
             QFileInfo targetInfo(dirInfo.symLinkTarget());
-            QFileInfo instDirInfo(m_instDir);
+            QFileInfo instDirInfo(instDir);
             if (targetInfo.canonicalPath() == instDirInfo.canonicalFilePath()) {
                 qDebug() << "Ignoring symlink" << subDir << "that leads into the instances folder";
-                continue;
+                return {};
             }
         }
-        auto id = dirInfo.fileName();
+        return dirInfo.fileName();
+    };
+    auto ids = QtConcurrent::blockingMapped<QList<InstanceId>>(subDirs, probe);
+    QList<InstanceId> out;
+    for (auto& id : ids) {
+        if (id.isEmpty())
+            continue;
         out.append(id);
         qDebug() << "Found instance ID" << id;
     }
@@ -462,20 +514,45 @@ InstanceList::InstListError InstanceList::loadList()
 {
     auto existingIds = getIdMapping(m_instances);
 
-    QList<InstancePtr> newList;
+    QList<InstanceId> newIds;
+    QSet<QString> configPaths;
 
     for (auto& id : discoverInstances()) {
+        configPaths.insert(FS::PathCombine(m_instDir, id, "instance.cfg"));
         if (existingIds.contains(id)) {
             auto instPair = existingIds[id];
             existingIds.remove(id);
             qDebug() << "Should keep and soft-reload" << id;
         } else {
-            InstancePtr instPtr = loadInstance(id);
-            if (instPtr) {
-                newList.append(instPtr);
-            }
+            newIds.append(id);
+        }
+    }
+
+    // reading the configs is what takes time with many instances, so they are read in parallel.
+    // configs that didn't change since the last start aren't read at all until something needs more than their header
+    std::function<InstanceConfig(const InstanceId&)> read = [instDir = m_instDir, index = m_index.get()](const InstanceId& id) {
+        return readInstanceConfig(instDir, id, *index);
+    };
+    auto configs = QtConcurrent::blockingMapped<QList<InstanceConfig>>(newIds, read);
+
+    // the instances themselves are still created here, everything using the list expects a complete InstancePtr.
+    // that stays cheap: their settings come from the index header, and the component list is only read when needed
+    QList<InstancePtr> newList;
+    for (auto& config : configs) {
+        std::shared_ptr<INISettingsObject> instanceSettings;
+        if (config.complete) {
+            m_index->insert(config.path, config.fingerprint, config.values);
+            instanceSettings = std::make_shared<INISettingsObject>(config.path, config.values);
+        } else {
+            instanceSettings = std::make_shared<INISettingsObject>(config.path, config.values, InstanceIndex::headerKeys());
+        }
+        InstancePtr instPtr = loadInstance(config.id, instanceSettings);
+        if (instPtr) {
+            newList.append(instPtr);
         }
     }
+    m_index->retain(configPaths);
+    m_index->save();
 
     // TODO: looks like a general algorithm with a few specifics inserted. Do something about it.
     if (!existingIds.isEmpty()) {
@@ -621,17 +698,18 @@ void InstanceList::propertiesChanged(BaseInstance* inst)
     }
 }
 
-InstancePtr InstanceList::loadInstance(const InstanceId& id)
+InstancePtr InstanceList::loadInstance(const InstanceId& id, std::shared_ptr<INISettingsObject> instanceSettings)
 {
     if (!m_groupsLoaded) {
         loadGroupList();
     }
 
     auto instanceRoot = FS::PathCombine(m_instDir, id);
-    auto instanceSettings = std::make_shared<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"));
+    // things like play time get saved a lot
+    instanceSettings->setWriteBehind(true);
     InstancePtr inst;
 
-    instanceSettings->registerSetting("InstanceType", "");
+    instanceSettings->declareSetting("InstanceType", "");
 
     QString inst_type = instanceSettings->get("InstanceType").toString();
 
@@ -1022,6 +1100,11 @@ bool InstanceList::commitStagedInstance(const QString& path,
 
         instanceSet.insert(instID);
 
+        if (auto store = APPLICATION->blobStore()) {
+            store->relocate(path, destination);
+            store->save();
+        }
+
         emit instancesChanged();
         emit instanceSelectRequest(instID);
     }
@@ -42,10 +42,14 @@
 #include <QSet>
 #include <QStack>
 
+#include <memory>
+
 #include "BaseInstance.h"
 
 class QFileSystemWatcher;
 class InstanceTask;
+class InstanceIndex;
+class INISettingsObject;
 struct InstanceName;
 
 using InstanceId = QString;
@@ -177,7 +181,7 @@ class InstanceList : public QAbstractListModel {
     void loadGroupList();
     void saveGroupList();
     QList<InstanceId> discoverInstances();
-    InstancePtr loadInstance(const InstanceId& id);
+    InstancePtr loadInstance(const InstanceId& id, std::shared_ptr<INISettingsObject> instanceSettings);
 
     void increaseGroupCount(const QString& group);
     void decreaseGroupCount(const QString& group);
@@ -199,6 +203,7 @@ class InstanceList : public QAbstractListModel {
     QSet<InstanceId> instanceSet;
     bool m_groupsLoaded = false;
     bool m_instancesProbed = false;
+    std::unique_ptr<InstanceIndex> m_index;
 
     QStack<TrashHistoryItem> m_trashHistory;
 };
@@ -40,7 +40,7 @@
 #include "MessageLevel.h"
 
 LoggedProcess::LoggedProcess(const QTextCodec* output_codec, QObject* parent)
-    : QProcess(parent), m_err_decoder(output_codec), m_out_decoder(output_codec)
+    : QProcess(parent), m_codec(output_codec), m_err_decoder(output_codec), m_out_decoder(output_codec)
 {
     // QProcess has a strange interface... let's map a lot of those into a few.
     connect(this, &QProcess::readyReadStandardOutput, this, &LoggedProcess::on_stdOut);
@@ -74,12 +74,20 @@ QStringList LoggedProcess::reprocess(const QByteArray& data, QTextDecoder& decod
 
 void LoggedProcess::on_stdErr()
 {
+    if (m_raw_output) {
+        emit output(readAllStandardError(), MessageLevel::StdErr);
+        return;
+    }
     auto lines = reprocess(readAllStandardError(), m_err_decoder);
     emit log(lines, MessageLevel::StdErr);
 }
 
 void LoggedProcess::on_stdOut()
 {
+    if (m_raw_output) {
+        emit output(readAllStandardOutput(), MessageLevel::StdOut);
+        return;
+    }
     auto lines = reprocess(readAllStandardOutput(), m_out_decoder);
     emit log(lines, MessageLevel::StdOut);
 }
@@ -178,3 +186,13 @@ void LoggedProcess::setDetachable(bool detachable)
 {
     m_is_detachable = detachable;
 }
+
+void LoggedProcess::setRawOutput(bool raw)
+{
+    m_raw_output = raw;
+}
+
+const QTextCodec* LoggedProcess::codec() const
+{
+    return m_codec;
+}
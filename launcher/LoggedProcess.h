@@ -56,9 +56,14 @@ class LoggedProcess : public QProcess {
     int exitCode() const;
 
     void setDetachable(bool detachable);
+    /// emit the output of the process as it was read instead of decoding it into lines
+    void setRawOutput(bool raw);
+    const QTextCodec* codec() const;
 
    signals:
     void log(QStringList lines, MessageLevel::Enum level);
+    /// output of the process, only emitted when raw output is enabled
+    void output(QByteArray data, MessageLevel::Enum level);
     void stateChanged(LoggedProcess::State state);
 
    public slots:
@@ -80,6 +85,7 @@ class LoggedProcess : public QProcess {
     QStringList reprocess(const QByteArray& data, QTextDecoder& decoder);
 
    private:
+    const QTextCodec* m_codec;
     QTextDecoder m_err_decoder;
     QTextDecoder m_out_decoder;
     QString m_leftover_line;
@@ -88,4 +94,5 @@ class LoggedProcess : public QProcess {
     int m_exit_code = 0;
     bool m_is_aborting = false;
     bool m_is_detachable = false;
+    bool m_raw_output = false;
 };
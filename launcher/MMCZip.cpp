@@ -47,6 +47,9 @@
 
 #if defined(LAUNCHER_APPLICATION)
 #include <QtConcurrentRun>
+
+#include "Exception.h"
+#include "modplatform/helpers/HashUtils.h"
 #endif
 
 namespace MMCZip {
@@ -70,14 +73,26 @@ bool mergeZipFiles(QuaZip* into, QFileInfo from, QSet<QString>& contained, const
         }
         contained.insert(filename);
 
-        if (!fileInsideMod.open(QIODevice::ReadOnly)) {
+        QuaZipFileInfo64 info_in;
+        if (!modZip.getCurrentFileInfo(&info_in)) {
+            qCritical() << "Failed to read the header of " << filename << " from " << from.fileName();
+            return false;
+        }
+
+        // the entry is copied as it is stored, without inflating and deflating it again
+        int method = 0;
+        int level = 0;
+        if (!fileInsideMod.open(QIODevice::ReadOnly, &method, &level, true)) {
             qCritical() << "Failed to open " << filename << " from " << from.fileName();
             return false;
         }
 
         QuaZipNewInfo info_out(fileInsideMod.getActualFileName());
+        info_out.dateTime = info_in.dateTime;
+        info_out.externalAttr = info_in.externalAttr;
+        info_out.uncompressedSize = info_in.uncompressedSize;
 
-        if (!zipOutFile.open(QIODevice::WriteOnly, info_out)) {
+        if (!zipOutFile.open(QIODevice::WriteOnly, info_out, nullptr, info_in.crc, method, level, true)) {
             qCritical() << "Failed to open " << filename << " in the jar";
             fileInsideMod.close();
             return false;
@@ -225,6 +240,79 @@ bool createModdedJar(QString sourceJarPath, QString targetJarPath, const QList<M
     }
     return true;
 }
+
+namespace {
+/*
+ * Identifies the merged jar: the hash of the vanilla jar followed by every jar mod, in order, with its hash and whether it is enabled.
+ * Empty if the jar can't be cached, like when a folder has to be merged.
+ */
+QString moddedJarKey(const QString& sourceJarPath, const QList<Mod*>& jarMods)
+{
+    auto sourceHash = Hashing::hash(sourceJarPath, Hashing::Algorithm::Sha1);
+    if (sourceHash.isEmpty()) {
+        return {};
+    }
+    QStringList key = { sourceHash };
+    for (auto mod : jarMods) {
+        if (mod->type() != ResourceType::ZIPFILE && mod->type() != ResourceType::SINGLEFILE) {
+            return {};
+        }
+        auto hash = Hashing::hash(mod->fileinfo().absoluteFilePath(), Hashing::Algorithm::Sha1);
+        if (hash.isEmpty()) {
+            return {};
+        }
+        key << QString("%1:%2").arg(hash, mod->enabled() ? "1" : "0");
+    }
+    return key.join('\n');
+}
+
+// a reflink shares the data with the cached jar, while writes to either one stay separate
+bool placeJar(const QString& src, const QString& dst)
+{
+    std::error_code ec;
+    if (FS::canClone(src, dst) && FS::clone_file(src, dst, ec)) {
+        return true;
+    }
+    return QFile::copy(src, dst);
+}
+}  // namespace
+
+bool createCachedModdedJar(const QString& sourceJarPath, const QString& finalJarPath, const QList<Mod*>& jarMods)
+{
+    auto key = moddedJarKey(sourceJarPath, jarMods);
+    if (key.isEmpty()) {
+        return createModdedJar(sourceJarPath, finalJarPath, jarMods);
+    }
+
+    // the last merged jar is kept next to the one used for the launch, together with what it was built from
+    QDir bin = QFileInfo(finalJarPath).absoluteDir();
+    auto cachedJarPath = bin.absoluteFilePath("minecraft.cached.jar");
+    auto keyPath = bin.absoluteFilePath("minecraft.cached.key");
+    bool upToDate = false;
+    try {
+        upToDate = QFileInfo::exists(cachedJarPath) && FS::read(keyPath) == key.toUtf8();
+    } catch (const Exception&) {
+    }
+
+    if (!upToDate) {
+        qDebug() << "Rebuilding the modded jar";
+        FS::deletePath(keyPath);
+        auto buildPath = cachedJarPath + ".part";
+        if (!createModdedJar(sourceJarPath, buildPath, jarMods)) {
+            return false;
+        }
+        if ((QFileInfo::exists(cachedJarPath) && !QFile::remove(cachedJarPath)) || !QFile::rename(buildPath, cachedJarPath)) {
+            FS::deletePath(buildPath);
+            return false;
+        }
+        try {
+            FS::write(keyPath, key.toUtf8());
+        } catch (const Exception& e) {
+            qWarning() << "Couldn't store the key of the modded jar:" << e.cause();
+        }
+    }
+    return placeJar(cachedJarPath, finalJarPath);
+}
 #endif
 
 // ours
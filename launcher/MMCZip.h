@@ -87,6 +87,12 @@ bool compressDirFiles(QString fileCompressed, QString dir, QFileInfoList files,
  * take a source jar, add mods to it, resulting in target jar
  */
 bool createModdedJar(QString sourceJarPath, QString targetJarPath, const QList<Mod*>& mods);
+
+/**
+ * like createModdedJar, but the merged jar is kept next to the target and only rebuilt
+ * when the source jar or any of the mods changed
+ */
+bool createCachedModdedJar(const QString& sourceJarPath, const QString& finalJarPath, const QList<Mod*>& jarMods);
 #endif
 /**
  * Find a single file in archive by file name (not path)
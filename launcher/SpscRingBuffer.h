@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/* SpscRingBuffer
+ * A bounded lock-free queue between exactly one producer thread and one consumer thread.
+ * The capacity is rounded up to a power of two. Neither side ever blocks: push fails when the buffer is full
+ * and pop returns nothing when it is empty, so the caller decides whether to wait, retry or drop.
+ */
+template <typename T>
+class SpscRingBuffer {
+   public:
+    explicit SpscRingBuffer(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    std::size_t capacity() const { return m_slots.size(); }
+    bool isEmpty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+    /// producer only. the value is left untouched if the buffer is full
+    bool push(T&& value)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+            return false;
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// consumer only
+    std::optional<T> pop()
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return std::nullopt;
+        std::optional<T> value(std::move(m_slots[head & m_mask]));
+        m_slots[head & m_mask] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+   private:
+    std::vector<T> m_slots;
+    std::size_t m_mask;
+    // keep the indices on separate cache lines, each of them is written by one side only
+    alignas(64) std::atomic<std::size_t> m_head{ 0 };
+    alignas(64) std::atomic<std::size_t> m_tail{ 0 };
+};
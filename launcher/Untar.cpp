@@ -34,6 +34,7 @@
  */
 #include "Untar.h"
 #include <quagzipfile.h>
+#include <zlib.h>
 #include <QByteArray>
 #include <QFileInfo>
 #include <QIODevice>
@@ -87,164 +88,218 @@ enum class TypeFlag : char {
 //                         /* 500 */
 // };
 
-bool readLonglink(QIODevice* in, qint64 size, QByteArray& longlink)
-{
-    qint64 n = 0;
-    size--;  // ignore trailing null
-    if (size < 0) {
-        qCritical() << "The filename size is negative";
-        return false;
-    }
-    longlink.resize(size + (BLOCKSIZE - size % BLOCKSIZE));  // make the size divisible by BLOCKSIZE
-    for (qint64 offset = 0; offset < longlink.size(); offset += BLOCKSIZE) {
-        n = in->read(longlink.data() + offset, BLOCKSIZE);
-        if (n != BLOCKSIZE) {
-            qCritical() << "The expected blocksize was not respected for the name";
-            return false;
-        }
-    }
-    longlink.truncate(qstrlen(longlink.constData()));
-    return true;
-}
-
-int getOctal(char* buffer, int maxlenght, bool* ok)
+int getOctal(const char* buffer, int maxlenght, bool* ok)
 {
     return QByteArray(buffer, qstrnlen(buffer, maxlenght)).toInt(ok, 8);
 }
 
-QString decodeName(char* name)
+QString decodeName(const char* name)
 {
     return QFile::decodeName(QByteArray(name, qstrnlen(name, 100)));
 }
+
 bool Tar::extract(QIODevice* in, QString dst)
 {
-    char buffer[BLOCKSIZE];
-    QString name, symlink, firstFolderName;
-    bool doNotReset = false, ok;
-    while (true) {
-        auto n = in->read(buffer, BLOCKSIZE);
-        if (n != BLOCKSIZE) {  // allways expect complete blocks
+    Extractor extractor(dst);
+    QByteArray buffer(64 * BLOCKSIZE, Qt::Uninitialized);
+    while (!extractor.isFinished()) {
+        auto n = in->read(buffer.data(), buffer.size());
+        if (n <= 0) {  // allways expect complete archives
             qCritical() << "The expected blocksize was not respected";
             return false;
         }
-        if (buffer[0] == 0) {  // end of archive
-            return true;
-        }
-        int mode = getOctal(buffer + 100, 8, &ok) | QFile::ReadUser | QFile::WriteUser;  // hack to ensure write and read permisions
-        if (!ok) {
-            qCritical() << "The file mode can't be read";
+        if (!extractor.feed(buffer.constData(), n)) {
             return false;
         }
-        // there are names that are exactly 100 bytes long
-        // and neither longlink nor \0 terminated (bug:101472)
+    }
+    return true;
+}
+
+Tar::Extractor::Extractor(QString dst) : m_dst(dst) {}
 
-        if (name.isEmpty()) {
-            name = decodeName(buffer);
-            if (!firstFolderName.isEmpty() && name.startsWith(firstFolderName)) {
-                name = name.mid(firstFolderName.size());
+bool Tar::Extractor::feed(const char* data, qint64 size)
+{
+    while (size > 0 && m_state != State::Finished && m_state != State::Failed) {
+        bool ok;
+        if (m_block.isEmpty() && size >= BLOCKSIZE) {
+            // fast path: a whole block is available, no need to copy it
+            ok = processBlock(data);
+            data += BLOCKSIZE;
+            size -= BLOCKSIZE;
+        } else {
+            auto missing = qMin(qint64(BLOCKSIZE - m_block.size()), size);
+            m_block.append(data, missing);
+            data += missing;
+            size -= missing;
+            if (m_block.size() != BLOCKSIZE) {
+                continue;
             }
+            ok = processBlock(m_block.constData());
+            m_block.clear();
         }
-        if (symlink.isEmpty())
-            symlink = decodeName(buffer);
-        qint64 size = getOctal(buffer + 124, 12, &ok);
         if (!ok) {
-            qCritical() << "The file size can't be read";
+            m_out.reset();
+            m_state = State::Failed;
+        }
+    }
+    return m_state != State::Failed;
+}
+
+bool Tar::Extractor::processBlock(const char* block)
+{
+    switch (m_state) {
+        case State::Header:
+            return processHeader(block);
+        case State::FileData: {
+            auto n = qMin(qint64(BLOCKSIZE), m_remaining);
+            if (m_out->write(block, n) != n) {
+                qCritical() << "Failed to write file:" << m_out->fileName();
+                return false;
+            }
+            m_remaining -= BLOCKSIZE;
+            break;
+        }
+        case State::LongName:
+            /* fallthrough */
+        case State::LongLink:
+            m_longlink.append(block, BLOCKSIZE);
+            m_remaining -= BLOCKSIZE;
+            break;
+        case State::Skip:
+            m_remaining -= BLOCKSIZE;
+            break;
+        case State::Finished:
+            /* fallthrough */
+        case State::Failed:
             return false;
+    }
+    if (m_remaining > 0) {
+        return true;
+    }
+    if (m_state == State::LongName || m_state == State::LongLink) {
+        m_longlink.truncate(qstrlen(m_longlink.constData()));
+        if (m_state == State::LongName) {
+            m_name = QFile::decodeName(m_longlink.constData());
+            if (!m_firstFolderName.isEmpty() && m_name.startsWith(m_firstFolderName)) {
+                m_name = m_name.mid(m_firstFolderName.size());
+            }
+        } else {
+            m_symlink = QFile::decodeName(m_longlink.constData());
         }
-        switch (TypeFlag(buffer[156])) {
-            case TypeFlag::Regular:
-                /* fallthrough */
-            case TypeFlag::ARegular: {
-                auto fileName = FS::PathCombine(dst, name);
-                if (!FS::ensureFilePathExists(fileName)) {
-                    qCritical() << "Can't ensure the file path to exist: " << fileName;
-                    return false;
-                }
-                QFile out(fileName);
-                if (!out.open(QFile::WriteOnly)) {
-                    qCritical() << "Can't open file:" << fileName;
-                    return false;
-                }
-                out.setPermissions(QFile::Permissions(mode));
-                while (size > 0) {
-                    QByteArray tmp(BLOCKSIZE, 0);
-                    n = in->read(tmp.data(), BLOCKSIZE);
-                    if (n != BLOCKSIZE) {
-                        qCritical() << "The expected blocksize was not respected when reading file";
-                        return false;
-                    }
-                    tmp.truncate(qMin(qint64(BLOCKSIZE), size));
-                    out.write(tmp);
-                    size -= BLOCKSIZE;
-                }
-                break;
+        m_longlink.clear();
+    }
+    m_out.reset();
+    m_state = State::Header;
+    return true;
+}
+
+bool Tar::Extractor::processHeader(const char* buffer)
+{
+    if (buffer[0] == 0) {  // end of archive
+        m_state = State::Finished;
+        return true;
+    }
+    bool ok;
+    m_mode = getOctal(buffer + 100, 8, &ok) | QFile::ReadUser | QFile::WriteUser;  // hack to ensure write and read permisions
+    if (!ok) {
+        qCritical() << "The file mode can't be read";
+        return false;
+    }
+    // there are names that are exactly 100 bytes long
+    // and neither longlink nor \0 terminated (bug:101472)
+
+    if (m_name.isEmpty()) {
+        m_name = decodeName(buffer);
+        if (!m_firstFolderName.isEmpty() && m_name.startsWith(m_firstFolderName)) {
+            m_name = m_name.mid(m_firstFolderName.size());
+        }
+    }
+    if (m_symlink.isEmpty())
+        m_symlink = decodeName(buffer);
+    qint64 size = getOctal(buffer + 124, 12, &ok);
+    if (!ok) {
+        qCritical() << "The file size can't be read";
+        return false;
+    }
+    bool doNotReset = false;
+    m_remaining = size;
+    m_state = State::Skip;  // by default the content of an entry is ignored
+    switch (TypeFlag(buffer[156])) {
+        case TypeFlag::Regular:
+            /* fallthrough */
+        case TypeFlag::ARegular: {
+            auto fileName = FS::PathCombine(m_dst, m_name);
+            if (!FS::ensureFilePathExists(fileName)) {
+                qCritical() << "Can't ensure the file path to exist: " << fileName;
+                return false;
             }
-            case TypeFlag::Directory: {
-                if (firstFolderName.isEmpty()) {
-                    firstFolderName = name;
-                    break;
-                }
-                auto folderPath = FS::PathCombine(dst, name);
-                if (!FS::ensureFolderPathExists(folderPath)) {
-                    qCritical() << "Can't ensure that folder exists: " << folderPath;
-                    return false;
-                }
-                break;
+            m_out = std::make_unique<QFile>(fileName);
+            if (!m_out->open(QFile::WriteOnly)) {
+                qCritical() << "Can't open file:" << fileName;
+                return false;
             }
-            case TypeFlag::GNULongLink: {
-                doNotReset = true;
-                QByteArray longlink;
-                if (readLonglink(in, size, longlink)) {
-                    symlink = QFile::decodeName(longlink.constData());
-                } else {
-                    qCritical() << "Failed to read long link";
-                    return false;
-                }
+            m_out->setPermissions(QFile::Permissions(m_mode));
+            m_state = State::FileData;
+            break;
+        }
+        case TypeFlag::Directory: {
+            if (m_firstFolderName.isEmpty()) {
+                m_firstFolderName = m_name;
                 break;
             }
-            case TypeFlag::GNULongName: {
-                doNotReset = true;
-                QByteArray longlink;
-                if (readLonglink(in, size, longlink)) {
-                    name = QFile::decodeName(longlink.constData());
-                } else {
-                    qCritical() << "Failed to read long name";
-                    return false;
-                }
-                break;
+            auto folderPath = FS::PathCombine(m_dst, m_name);
+            if (!FS::ensureFolderPathExists(folderPath)) {
+                qCritical() << "Can't ensure that folder exists: " << folderPath;
+                return false;
             }
-            case TypeFlag::Link:
-                /* fallthrough */
-            case TypeFlag::Symlink: {
-                auto fileName = FS::PathCombine(dst, name);
-                if (!FS::create_link(FS::PathCombine(QFileInfo(fileName).path(), symlink), fileName)()) {  // do not use symlinks
-                    qCritical() << "Can't create link for:" << fileName << " to:" << FS::PathCombine(QFileInfo(fileName).path(), symlink);
-                    return false;
-                }
-                FS::ensureFilePathExists(fileName);
-                QFile::setPermissions(fileName, QFile::Permissions(mode));
-                break;
+            break;
+        }
+        case TypeFlag::GNULongLink:
+            /* fallthrough */
+        case TypeFlag::GNULongName: {
+            doNotReset = true;
+            if (size - 1 < 0) {  // ignore trailing null
+                qCritical() << "The filename size is negative";
+                return false;
             }
-            case TypeFlag::Character:
-                /* fallthrough */
-            case TypeFlag::Block:
-                /* fallthrough */
-            case TypeFlag::FIFO:
-                /* fallthrough */
-            case TypeFlag::Contiguous:
-                /* fallthrough */
-            case TypeFlag::GlobalPosixHeader:
-                /* fallthrough */
-            case TypeFlag::ExtendedPosixHeader:
-                /* fallthrough */
-            default:
-                break;
+            m_longlink.clear();
+            m_state = TypeFlag(buffer[156]) == TypeFlag::GNULongLink ? State::LongLink : State::LongName;
+            break;
         }
-        if (!doNotReset) {
-            name.truncate(0);
-            symlink.truncate(0);
+        case TypeFlag::Link:
+            /* fallthrough */
+        case TypeFlag::Symlink: {
+            auto fileName = FS::PathCombine(m_dst, m_name);
+            if (!FS::create_link(FS::PathCombine(QFileInfo(fileName).path(), m_symlink), fileName)()) {  // do not use symlinks
+                qCritical() << "Can't create link for:" << fileName << " to:" << FS::PathCombine(QFileInfo(fileName).path(), m_symlink);
+                return false;
+            }
+            FS::ensureFilePathExists(fileName);
+            QFile::setPermissions(fileName, QFile::Permissions(m_mode));
+            break;
         }
-        doNotReset = false;
+        case TypeFlag::Character:
+            /* fallthrough */
+        case TypeFlag::Block:
+            /* fallthrough */
+        case TypeFlag::FIFO:
+            /* fallthrough */
+        case TypeFlag::Contiguous:
+            /* fallthrough */
+        case TypeFlag::GlobalPosixHeader:
+            /* fallthrough */
+        case TypeFlag::ExtendedPosixHeader:
+            /* fallthrough */
+        default:
+            break;
+    }
+    if (!doNotReset) {
+        m_name.truncate(0);
+        m_symlink.truncate(0);
+    }
+    if (m_remaining <= 0) {
+        m_out.reset();
+        m_state = State::Header;
     }
     return true;
 }
@@ -257,4 +312,59 @@ bool GZTar::extract(QString src, QString dst)
         return false;
     }
     return Tar::extract(&a, dst);
-}
\ No newline at end of file
+}
+
+struct GZTar::Extractor::Private {
+    z_stream strm;
+    bool initialized = false;
+    bool streamEnded = false;
+    QByteArray buffer;
+};
+
+GZTar::Extractor::Extractor(QString dst) : Tar::Extractor(dst), d(new Private)
+{
+    memset(&d->strm, 0, sizeof(d->strm));
+    // 16 + MAX_WBITS makes zlib expect a gzip header
+    d->initialized = inflateInit2(&d->strm, (16 + MAX_WBITS)) == Z_OK;
+    d->buffer.resize(128 * BLOCKSIZE);
+}
+
+GZTar::Extractor::~Extractor()
+{
+    if (d->initialized)
+        inflateEnd(&d->strm);
+}
+
+bool GZTar::Extractor::feed(const char* data, qint64 size)
+{
+    if (!d->initialized) {
+        qCritical() << "Failed to initialize the gzip decoder";
+        return false;
+    }
+    if (d->streamEnded || isFinished()) {  // trailing data after the archive is ignored
+        return true;
+    }
+    d->strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    d->strm.avail_in = static_cast<uInt>(size);
+    do {
+        d->strm.next_out = reinterpret_cast<Bytef*>(d->buffer.data());
+        d->strm.avail_out = static_cast<uInt>(d->buffer.size());
+        auto err = inflate(&d->strm, Z_NO_FLUSH);
+        if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR) {
+            qCritical() << "Failed to decompress gzip data:" << (d->strm.msg ? d->strm.msg : "unknown error");
+            return false;
+        }
+        auto produced = d->buffer.size() - static_cast<qint64>(d->strm.avail_out);
+        if (produced > 0 && !Tar::Extractor::feed(d->buffer.constData(), produced)) {
+            return false;
+        }
+        if (err == Z_STREAM_END) {
+            d->streamEnded = true;
+            break;
+        }
+        if (err == Z_BUF_ERROR) {  // no progress possible, wait for more input
+            break;
+        }
+    } while (d->strm.avail_in > 0 || d->strm.avail_out == 0);
+    return true;
+}
@@ -33,14 +33,60 @@
  *      limitations under the License.
  */
 #pragma once
+#include <QFile>
 #include <QIODevice>
 
+#include <memory>
+
 // this is a hack used for the java downloader (feel free to remove it in favor of a library)
 // both extract functions will extract the first folder inside dest(disregarding the prefix)
 namespace Tar {
 bool extract(QIODevice* in, QString dst);
-}
+
+// push based extractor: the archive is handed over in chunks of any size as they become available
+// used to unpack archives while they are still being downloaded
+class Extractor {
+   public:
+    explicit Extractor(QString dst);
+    virtual ~Extractor() = default;
+
+    virtual bool feed(const char* data, qint64 size);
+    // true once the end of archive marker was found
+    bool isFinished() const { return m_state == State::Finished; }
+
+   protected:
+    enum class State { Header, FileData, LongName, LongLink, Skip, Finished, Failed };
+
+    bool processBlock(const char* block);
+    bool processHeader(const char* block);
+
+    QString m_dst;
+    State m_state = State::Header;
+    QByteArray m_block;  // incomplete block carried over between feeds
+    qint64 m_remaining = 0;
+    int m_mode = 0;
+
+    QString m_name;
+    QString m_symlink;
+    QString m_firstFolderName;
+    QByteArray m_longlink;
+    std::unique_ptr<QFile> m_out;
+};
+}  // namespace Tar
 
 namespace GZTar {
 bool extract(QString src, QString dst);
-}
\ No newline at end of file
+
+// push based extractor for gzip compressed tar archives
+class Extractor : public Tar::Extractor {
+   public:
+    explicit Extractor(QString dst);
+    virtual ~Extractor();
+
+    bool feed(const char* data, qint64 size) override;
+
+   private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+}  // namespace GZTar
\ No newline at end of file
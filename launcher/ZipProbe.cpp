@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ZipProbe.h"
+
+#include <zlib.h>
+#include <QDebug>
+#include <QtEndian>
+
+namespace {
+constexpr quint32 s_localHeaderSignature = 0x04034b50;
+constexpr quint32 s_centralHeaderSignature = 0x02014b50;
+constexpr quint32 s_endOfCentralDirSignature = 0x06054b50;
+constexpr quint32 s_zip64EndOfCentralDirSignature = 0x06064b50;
+constexpr quint32 s_zip64LocatorSignature = 0x07064b50;
+
+constexpr quint64 s_localHeaderSize = 30;
+constexpr quint64 s_centralHeaderSize = 46;
+constexpr quint64 s_endOfCentralDirSize = 22;
+constexpr quint64 s_zip64EndOfCentralDirSize = 56;
+constexpr quint64 s_zip64LocatorSize = 20;
+constexpr quint64 s_maxCommentSize = 0xffff;
+
+// anything probed is metadata or an icon, a bigger entry is a broken or malicious archive
+constexpr quint64 s_maxEntrySize = 64 * 1024 * 1024;
+
+quint16 read16(const uchar* data)
+{
+    return qFromLittleEndian<quint16>(data);
+}
+
+quint32 read32(const uchar* data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+quint64 read64(const uchar* data)
+{
+    return qFromLittleEndian<quint64>(data);
+}
+}  // namespace
+
+ZipProbe::ZipProbe(const QString& path) : m_file(path) {}
+
+bool ZipProbe::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+    m_size = m_file.size();
+    if (m_size < s_endOfCentralDirSize)
+        return false;
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        m_buffer = m_file.readAll();
+        if (static_cast<quint64>(m_buffer.size()) != m_size)
+            return false;
+        m_data = reinterpret_cast<const uchar*>(m_buffer.constData());
+    }
+    if (!readCentralDirectory()) {
+        qWarning() << "Failed to read the central directory of" << m_file.fileName();
+        m_data = nullptr;
+        m_entries.clear();
+        m_foldedNames.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ZipProbe::readCentralDirectory()
+{
+    // the end of central directory record is followed by a comment of unknown size, look for it backwards
+    quint64 end = m_size - s_endOfCentralDirSize;
+    quint64 lowest = end > s_maxCommentSize ? end - s_maxCommentSize : 0;
+    while (read32(m_data + end) != s_endOfCentralDirSignature) {
+        if (end == lowest)
+            return false;
+        end--;
+    }
+
+    quint64 count = read16(m_data + end + 10);
+    quint64 directorySize = read32(m_data + end + 12);
+    quint64 directoryOffset = read32(m_data + end + 16);
+    quint64 directoryEnd = end;
+
+    if (count == 0xffff || directorySize == 0xffffffff || directoryOffset == 0xffffffff) {
+        if (end < s_zip64LocatorSize || read32(m_data + end - s_zip64LocatorSize) != s_zip64LocatorSignature)
+            return false;
+        quint64 zip64End = read64(m_data + end - s_zip64LocatorSize + 8);
+        if (zip64End + s_zip64EndOfCentralDirSize > m_size || read32(m_data + zip64End) != s_zip64EndOfCentralDirSignature)
+            return false;
+        count = read64(m_data + zip64End + 32);
+        directorySize = read64(m_data + zip64End + 40);
+        directoryOffset = read64(m_data + zip64End + 48);
+        directoryEnd = zip64End;
+    }
+
+    if (directorySize > directoryEnd || directoryOffset > directoryEnd - directorySize)
+        return false;
+    m_prefix = directoryEnd - directorySize - directoryOffset;
+
+    m_entries.reserve(static_cast<int>(qMin<quint64>(count, directorySize / s_centralHeaderSize)));
+    const uchar* pos = m_data + m_prefix + directoryOffset;
+    const uchar* limit = pos + directorySize;
+    for (quint64 i = 0; i < count; i++) {
+        if (static_cast<quint64>(limit - pos) < s_centralHeaderSize || read32(pos) != s_centralHeaderSignature)
+            return false;
+        Entry entry;
+        entry.flags = read16(pos + 8);
+        entry.method = read16(pos + 10);
+        entry.crc = read32(pos + 16);
+        entry.compressedSize = read32(pos + 20);
+        entry.uncompressedSize = read32(pos + 24);
+        quint16 nameSize = read16(pos + 28);
+        quint16 extraSize = read16(pos + 30);
+        quint16 commentSize = read16(pos + 32);
+        entry.localHeaderOffset = read32(pos + 42);
+        if (static_cast<quint64>(limit - pos) < s_centralHeaderSize + nameSize + extraSize + commentSize)
+            return false;
+
+        const uchar* name = pos + s_centralHeaderSize;
+        const uchar* extra = name + nameSize;
+        const uchar* extraEnd = extra + extraSize;
+        // zip64 sizes and offsets live in an extra field, in this order, but only those that overflowed
+        while (extraEnd - extra >= 4) {
+            quint16 id = read16(extra);
+            quint16 size = read16(extra + 2);
+            const uchar* field = extra + 4;
+            if (extraEnd - field < size)
+                break;
+            if (id == 0x0001) {
+                const uchar* fieldEnd = field + size;
+                for (auto value : { &entry.uncompressedSize, &entry.compressedSize, &entry.localHeaderOffset }) {
+                    if (*value != 0xffffffff)
+                        continue;
+                    if (fieldEnd - field < 8)
+                        break;
+                    *value = read64(field);
+                    field += 8;
+                }
+                break;
+            }
+            extra = field + size;
+        }
+
+        // jars are written with UTF-8 names, whether or not they set the flag for it
+        auto entryName = QString::fromUtf8(reinterpret_cast<const char*>(name), nameSize);
+        m_entries.insert(entryName, entry);
+#ifdef Q_OS_WIN
+        auto folded = entryName.toCaseFolded();
+        if (!m_foldedNames.contains(folded))
+            m_foldedNames.insert(folded, entryName);
+#endif
+        pos += s_centralHeaderSize + nameSize + extraSize + commentSize;
+    }
+    return true;
+}
+
+QHash<QString, ZipProbe::Entry>::const_iterator ZipProbe::findEntry(const QString& name) const
+{
+    auto it = m_entries.constFind(name);
+#ifdef Q_OS_WIN
+    if (it == m_entries.constEnd()) {
+        auto folded = m_foldedNames.constFind(name.toCaseFolded());
+        if (folded != m_foldedNames.constEnd())
+            it = m_entries.constFind(*folded);
+    }
+#endif
+    return it;
+}
+
+QByteArray ZipProbe::read(const QString& name) const
+{
+    auto it = findEntry(name);
+    if (!m_data || it == m_entries.constEnd())
+        return {};
+    const Entry& entry = *it;
+
+    // encrypted entries can't be read
+    if (entry.flags & 0x1 || entry.uncompressedSize > s_maxEntrySize)
+        return {};
+
+    quint64 header = m_prefix + entry.localHeaderOffset;
+    if (header > m_size || m_size - header < s_localHeaderSize || read32(m_data + header) != s_localHeaderSignature)
+        return {};
+    // the local header may have a different extra field than the central one
+    quint64 dataOffset = header + s_localHeaderSize + read16(m_data + header + 26) + read16(m_data + header + 28);
+    if (dataOffset > m_size || m_size - dataOffset < entry.compressedSize)
+        return {};
+    const uchar* data = m_data + dataOffset;
+
+    QByteArray result;
+    switch (entry.method) {
+        case 0: {  // stored
+            if (entry.compressedSize != entry.uncompressedSize)
+                return {};
+            result = QByteArray(reinterpret_cast<const char*>(data), static_cast<int>(entry.compressedSize));
+            break;
+        }
+        case 8: {  // deflated
+            result.resize(static_cast<int>(entry.uncompressedSize));
+            z_stream stream;
+            memset(&stream, 0, sizeof(stream));
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                return {};
+            stream.next_in = const_cast<Bytef*>(data);
+            stream.avail_in = static_cast<uInt>(entry.compressedSize);
+            stream.next_out = reinterpret_cast<Bytef*>(result.data());
+            stream.avail_out = static_cast<uInt>(entry.uncompressedSize);
+            int status = inflate(&stream, Z_FINISH);
+            inflateEnd(&stream);
+            if (status != Z_STREAM_END || stream.total_out != entry.uncompressedSize)
+                return {};
+            break;
+        }
+        default:
+            qWarning() << "Unsupported compression method" << entry.method << "for" << name << "in" << m_file.fileName();
+            return {};
+    }
+
+    if (crc32(0L, reinterpret_cast<const Bytef*>(result.constData()), static_cast<uInt>(result.size())) != entry.crc) {
+        qWarning() << "CRC mismatch for" << name << "in" << m_file.fileName();
+        return {};
+    }
+    // empty entries still read as non-null
+    if (result.isNull())
+        result = QByteArray("");
+    return result;
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+/* ZipProbe
+ * Read-only view of a zip archive, for picking a few small files out of it, like mod metadata.
+ *
+ * The archive is memory mapped and only its central directory is parsed, into a hash of the entry names.
+ * Looking up entries doesn't touch the rest of the file, and only the entries that are read get inflated.
+ * Only stored and deflated entries are supported, which is all that jars use.
+ * Names are looked up like QuaZip does by default: case sensitive, except on Windows where an exact match wins and any
+ * other casing is accepted otherwise.
+ */
+class ZipProbe {
+   public:
+    explicit ZipProbe(const QString& path);
+
+    /// maps the archive and reads its central directory
+    bool open();
+    bool isOpen() const { return m_data != nullptr; }
+
+    bool contains(const QString& name) const { return findEntry(name) != m_entries.constEnd(); }
+    QStringList fileNames() const { return m_entries.keys(); }
+
+    /// contents of the entry, null if it doesn't exist or can't be extracted
+    QByteArray read(const QString& name) const;
+
+   private:
+    struct Entry {
+        quint16 flags = 0;
+        quint16 method = 0;
+        quint32 crc = 0;
+        quint64 compressedSize = 0;
+        quint64 uncompressedSize = 0;
+        quint64 localHeaderOffset = 0;
+    };
+
+    bool readCentralDirectory();
+    QHash<QString, Entry>::const_iterator findEntry(const QString& name) const;
+
+   private:
+    QFile m_file;
+    QByteArray m_buffer;  // used when the file can't be mapped
+    const uchar* m_data = nullptr;
+    quint64 m_size = 0;
+    // bytes in front of the archive, like in self-extracting ones
+    quint64 m_prefix = 0;
+    QHash<QString, Entry> m_entries;
+    // case folded name -> first entry with that name, only filled on Windows
+    QHash<QString, QString> m_foldedNames;
+};
@@ -36,18 +36,90 @@
 #include "JavaChecker.h"
 
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QMap>
 #include <QProcess>
+#include <QSysInfo>
 
 #include "Commandline.h"
 #include "FileSystem.h"
 #include "java/JavaUtils.h"
 
+namespace {
+bool is64BitArch(const QString& arch)
+{
+    return arch == "x86_64" || arch == "amd64" || arch == "aarch64" || arch == "arm64" || arch == "riscv64";
+}
+}  // namespace
+
+bool JavaChecker::canRunArch(const QString& arch, const QString& hostArch)
+{
+    // what the CPU runs without emulation, by the names QSysInfo uses for it
+    static const QHash<QString, QStringList> s_nativeArchs = {
+        { "x86_64", { "amd64", "x86_64", "x86" } },
+        { "i386", { "x86" } },
+        { "arm64", { "aarch64", "arm64" } },
+    };
+    return s_nativeArchs.value(hostArch, { hostArch }).contains(arch);
+}
+
 JavaChecker::JavaChecker(QString path, QString args, int minMem, int maxMem, int permGen, int id)
     : Task(), m_path(path), m_args(args), m_minMem(minMem), m_maxMem(maxMem), m_permGen(permGen), m_id(id)
 {}
 
+std::optional<JavaChecker::Result> JavaChecker::readReleaseFile(const QString& path, int id)
+{
+    // <java home>/bin/java -> <java home>/release
+    QFile file(QFileInfo(path).absoluteDir().absoluteFilePath("../release"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return {};
+
+    // lines of KEY="value", written by the JDK build
+    QMap<QString, QString> values;
+    while (!file.atEnd()) {
+        auto line = QString::fromUtf8(file.readLine()).trimmed();
+        auto separator = line.indexOf('=');
+        if (separator <= 0)
+            continue;
+        auto value = line.mid(separator + 1).trimmed();
+        if (value.size() >= 2 && value.startsWith('"') && value.endsWith('"'))
+            value = value.mid(1, value.size() - 2);
+        values.insert(line.left(separator).trimmed(), value);
+    }
+
+    auto version = values.value("JAVA_VERSION");
+    auto vendor = values.value("IMPLEMENTOR");
+    auto arch = values.value("OS_ARCH");
+    if (version.isEmpty() || vendor.isEmpty() || arch.isEmpty())
+        return {};
+
+    // match what os.arch reports at runtime
+#ifndef Q_OS_MACOS
+    if (arch == "x86_64")
+        arch = "amd64";
+#endif
+    if (arch == "i386" || arch == "i586" || arch == "i686")
+        arch = "x86";
+    // a runtime for another CPU may still start through emulation, or not at all. only starting it tells
+    if (!canRunArch(arch, QSysInfo::currentCpuArchitecture()))
+        return {};
+
+    Result result = {
+        path,
+        id,
+    };
+    result.validity = Result::Validity::Valid;
+    result.is_64bit = is64BitArch(arch);
+    result.mojangPlatform = result.is_64bit ? "64" : "32";
+    result.realPlatform = arch;
+    result.javaVersion = version;
+    result.javaVendor = vendor;
+    return result;
+}
+
 void JavaChecker::executeTask()
 {
     QString checkerJar = JavaUtils::getJavaCheckPath();
@@ -171,7 +243,7 @@ void JavaChecker::finished(int exitcode, QProcess::ExitStatus status)
     auto os_arch = results["os.arch"];
     auto java_version = results["java.version"];
     auto java_vendor = results["java.vendor"];
-    bool is_64 = os_arch == "x86_64" || os_arch == "amd64" || os_arch == "aarch64" || os_arch == "arm64" || os_arch == "riscv64";
+    bool is_64 = is64BitArch(os_arch);
 
     result.validity = Result::Validity::Valid;
     result.is_64bit = is_64;
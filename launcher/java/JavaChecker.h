@@ -2,6 +2,8 @@
 #include <QProcess>
 #include <QTimer>
 
+#include <optional>
+
 #include "JavaVersion.h"
 #include "QObjectPtr.h"
 #include "tasks/Task.h"
@@ -27,6 +29,15 @@ class JavaChecker : public Task {
 
     explicit JavaChecker(QString path, QString args, int minMem = 0, int maxMem = 0, int permGen = 0, int id = 0);
 
+    /*!
+     * \brief What the checker would report for the java binary at \p path, read from the `release` file of the runtime it
+     * belongs to instead of starting it.
+     * \return nothing if there is no release file, it lacks any of the needed values or is for a CPU this one can't run
+     */
+    static std::optional<Result> readReleaseFile(const QString& path, int id = 0);
+    /// whether a runtime for \p arch, as os.arch names it, runs natively on a CPU that QSysInfo calls \p hostArch
+    static bool canRunArch(const QString& arch, const QString& hostArch);
+
    signals:
     void checkFinished(const Result& result);
 
@@ -38,11 +38,15 @@
 #include <QtXml>
 
 #include <QDebug>
+#include <QFileInfo>
+#include <QSet>
+#include <QStandardPaths>
 #include <algorithm>
 
 #include "Application.h"
 #include "java/JavaChecker.h"
 #include "java/JavaInstallList.h"
+#include "java/JavaProbeCache.h"
 #include "java/JavaUtils.h"
 #include "tasks/ConcurrentTask.h"
 
@@ -168,11 +172,42 @@ void JavaListLoadTask::executeTask()
     connect(m_job.get(), &Task::finished, this, &JavaListLoadTask::javaCheckerFinished);
     connect(m_job.get(), &Task::progress, this, &Task::setProgress);
 
+    auto cache = APPLICATION->javaProbeCache();
+    // the same runtime is usually reachable through several symlinks, e.g. /usr/bin/java and /usr/lib/jvm/default-java
+    QSet<QString> seen;
     qDebug() << "Probing the following Java paths: ";
     int id = 0;
     for (QString candidate : candidate_paths) {
+        auto path = candidate;
+        if (!path.contains('/') && !path.contains('\\'))
+            path = QStandardPaths::findExecutable(path);
+        path = QFileInfo(path).canonicalFilePath();
+        if (path.isEmpty() || seen.contains(path))
+            continue;
+        seen.insert(path);
+
+        std::optional<JavaChecker::Result> known;
+        if (cache)
+            known = cache->find(path);
+        if (!known) {
+            known = JavaChecker::readReleaseFile(path);
+            if (known && cache)
+                cache->insert(path, *known);
+        }
+        if (known) {
+            qDebug() << candidate << "is known, not starting it";
+            known->path = candidate;
+            known->id = id++;
+            m_results << *known;
+            continue;
+        }
+
         auto checker = new JavaChecker(candidate, "", 0, 0, 0, id);
-        connect(checker, &JavaChecker::checkFinished, [this](const JavaChecker::Result& result) { m_results << result; });
+        connect(checker, &JavaChecker::checkFinished, [this, cache, path](const JavaChecker::Result& result) {
+            m_results << result;
+            if (cache)
+                cache->insert(path, result);
+        });
         job->addTask(Task::Ptr(checker));
         id++;
     }
@@ -211,5 +246,7 @@ void JavaListLoadTask::javaCheckerFinished()
     }
 
     m_list->updateListData(javas_bvp);
+    if (auto cache = APPLICATION->javaProbeCache())
+        cache->save();
     emitSucceeded();
 }
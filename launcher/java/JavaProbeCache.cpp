@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "JavaProbeCache.h"
+
+#include <QFileInfo>
+
+namespace {
+// bump this whenever the checker reports different values, so stale results get probed again
+constexpr int s_formatVersion = 1;
+}  // namespace
+
+JavaProbeCache::JavaProbeCache(QString file)
+    : m_cache({ file, "java probe cache", s_formatVersion },
+              [](const JavaChecker::Result& result) {
+                  QJsonObject obj;
+                  obj.insert("is_64bit", result.is_64bit);
+                  obj.insert("arch", result.realPlatform);
+                  obj.insert("java_version", result.javaVersion.toString());
+                  obj.insert("java_vendor", result.javaVendor);
+                  return obj;
+              },
+              [](const QJsonObject& obj) {
+                  JavaChecker::Result result = {};
+                  result.validity = JavaChecker::Result::Validity::Valid;
+                  result.is_64bit = Json::requireBoolean(obj, "is_64bit");
+                  result.mojangPlatform = result.is_64bit ? "64" : "32";
+                  result.realPlatform = Json::requireString(obj, "arch");
+                  result.javaVersion = Json::requireString(obj, "java_version");
+                  result.javaVendor = Json::requireString(obj, "java_vendor");
+                  return result;
+              })
+{}
+
+std::optional<JavaChecker::Result> JavaProbeCache::find(const QString& path) const
+{
+    auto result = m_cache.find(path, FS::fingerprint(QFileInfo(path)));
+    if (result)
+        result->path = path;
+    return result;
+}
+
+void JavaProbeCache::insert(const QString& path, const JavaChecker::Result& result)
+{
+    if (result.validity != JavaChecker::Result::Validity::Valid)
+        return;
+    m_cache.insert(path, FS::fingerprint(QFileInfo(path)), result);
+}
+
+void JavaProbeCache::save()
+{
+    m_cache.save();
+}
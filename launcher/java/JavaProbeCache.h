@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <optional>
+
+#include "FingerprintCache.h"
+#include "java/JavaChecker.h"
+
+/* JavaProbeCache
+ * Results of probing java binaries, so the Java list doesn't have to start every runtime on the system each time it loads.
+ *
+ * Entries are keyed by the canonical path of the binary, so an update of the runtime gets it probed again.
+ * Only working runtimes are cached, failures and invalid output can be temporary.
+ */
+class JavaProbeCache {
+   public:
+    explicit JavaProbeCache(QString file);
+
+    /// the probe result for the binary at the canonical \p path, if it was probed and didn't change since
+    std::optional<JavaChecker::Result> find(const QString& path) const;
+    /// remembers the result of probing the binary at the canonical \p path in its current state
+    void insert(const QString& path, const JavaChecker::Result& result);
+
+    void save();
+
+   private:
+    FingerprintCache<JavaChecker::Result> m_cache;
+};
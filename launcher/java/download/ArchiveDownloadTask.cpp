@@ -21,8 +21,8 @@
 #include "MMCZip.h"
 
 #include "Application.h"
-#include "Untar.h"
 #include "net/ChecksumValidator.h"
+#include "net/Download.h"
 #include "net/NetJob.h"
 #include "tasks/Task.h"
 
@@ -33,13 +33,24 @@ ArchiveDownloadTask::ArchiveDownloadTask(QUrl url, QString final_path, QString c
 
 void ArchiveDownloadTask::executeTask()
 {
-    // JRE found ! download the zip
-    setStatus(tr("Downloading Java"));
-
-    MetaEntryPtr entry = APPLICATION->metacache()->resolveEntry("java", m_url.fileName());
+    auto fileName = m_url.fileName();
+    auto isTar = fileName.endsWith("tar");
+    auto isGZTar = fileName.endsWith("tar.gz") || fileName.endsWith("taz") || fileName.endsWith("tgz");
 
     auto download = makeShared<NetJob>(QString("JRE::DownloadJava"), APPLICATION->network());
-    auto action = Net::Download::makeCached(m_url, entry);
+    Net::Download::Ptr action;
+    QString fullPath;
+    if (isTar || isGZTar) {
+        // tar archives are read sequentially, so they can be unpacked while they are still downloading
+        setStatus(tr("Downloading and extracting Java"));
+        action = Net::Download::makeExtract(m_url, QDir(m_final_path).absolutePath(), isGZTar);
+    } else {
+        // JRE found ! download the zip
+        setStatus(tr("Downloading Java"));
+        MetaEntryPtr entry = APPLICATION->metacache()->resolveEntry("java", fileName);
+        action = Net::Download::makeCached(m_url, entry);
+        fullPath = entry->getFullPath();
+    }
     if (!m_checksum_hash.isEmpty() && !m_checksum_type.isEmpty()) {
         auto hashType = QCryptographicHash::Algorithm::Sha1;
         if (m_checksum_type == "sha256") {
@@ -48,17 +59,20 @@ void ArchiveDownloadTask::executeTask()
         action->addValidator(new Net::ChecksumValidator(hashType, QByteArray::fromHex(m_checksum_hash.toUtf8())));
     }
     download->addNetAction(action);
-    auto fullPath = entry->getFullPath();
 
     connect(download.get(), &Task::failed, this, &ArchiveDownloadTask::emitFailed);
     connect(download.get(), &Task::progress, this, &ArchiveDownloadTask::setProgress);
     connect(download.get(), &Task::stepProgress, this, &ArchiveDownloadTask::propagateStepProgress);
     connect(download.get(), &Task::status, this, &ArchiveDownloadTask::setStatus);
     connect(download.get(), &Task::details, this, &ArchiveDownloadTask::setDetails);
-    connect(download.get(), &Task::succeeded, [this, fullPath] {
-        // This should do all of the extracting and creating folders
-        extractJava(fullPath);
-    });
+    if (fullPath.isEmpty()) {
+        connect(download.get(), &Task::succeeded, this, &ArchiveDownloadTask::emitSucceeded);
+    } else {
+        connect(download.get(), &Task::succeeded, [this, fullPath] {
+            // This should do all of the extracting and creating folders
+            extractJava(fullPath);
+        });
+    }
     m_task = download;
     m_task->start();
 }
@@ -66,28 +80,7 @@ void ArchiveDownloadTask::executeTask()
 void ArchiveDownloadTask::extractJava(QString input)
 {
     setStatus(tr("Extracting Java"));
-    if (input.endsWith("tar")) {
-        setStatus(tr("Extracting Java (Progress is not reported for tar archives)"));
-        QFile in(input);
-        if (!in.open(QFile::ReadOnly)) {
-            emitFailed(tr("Unable to open supplied tar file."));
-            return;
-        }
-        if (!Tar::extract(&in, QDir(m_final_path).absolutePath())) {
-            emitFailed(tr("Unable to extract supplied tar file."));
-            return;
-        }
-        emitSucceeded();
-        return;
-    } else if (input.endsWith("tar.gz") || input.endsWith("taz") || input.endsWith("tgz")) {
-        setStatus(tr("Extracting Java (Progress is not reported for tar archives)"));
-        if (!GZTar::extract(input, QDir(m_final_path).absolutePath())) {
-            emitFailed(tr("Unable to extract supplied tar file."));
-            return;
-        }
-        emitSucceeded();
-        return;
-    } else if (input.endsWith("zip")) {
+    if (input.endsWith("zip")) {
         auto zip = std::make_shared<QuaZip>(input);
         if (!zip->open(QuaZip::mdUnzip)) {
             emitFailed(tr("Unable to open supplied zip file."));
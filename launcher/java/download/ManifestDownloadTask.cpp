@@ -28,6 +28,7 @@ struct File {
     QString url;
     QByteArray hash;
     bool isExec;
+    bool isCompressed;
 };
 
 namespace Java {
@@ -92,19 +93,32 @@ void ManifestDownloadTask::downloadJava(const QJsonDocument& doc)
                 QFile::link(path, file);
             }
         } else if (type == "file") {
-            // TODO download compressed version if it exists ?
-            auto raw = Json::ensureObject(Json::ensureObject(meta, "downloads"), "raw");
+            auto downloads = Json::ensureObject(meta, "downloads");
+            auto raw = Json::ensureObject(downloads, "raw");
             auto isExec = Json::ensureBoolean(meta, "executable", false);
             auto url = Json::ensureString(raw, "url");
+            auto isCompressed = false;
+#if defined(WITH_LIBLZMA)
+            // prefer the compressed version, the checksum still refers to the raw file
+            auto lzmaUrl = Json::ensureString(Json::ensureObject(downloads, "lzma"), "url");
+            if (!lzmaUrl.isEmpty() && QUrl(lzmaUrl).isValid()) {
+                url = lzmaUrl;
+                isCompressed = true;
+            }
+#endif
             if (!url.isEmpty() && QUrl(url).isValid()) {
-                auto f = File{ file, url, QByteArray::fromHex(Json::ensureString(raw, "sha1").toLatin1()), isExec };
+                auto f = File{ file, url, QByteArray::fromHex(Json::ensureString(raw, "sha1").toLatin1()), isExec, isCompressed };
                 toDownload.push_back(f);
             }
         }
     }
     auto elementDownload = makeShared<NetJob>("JRE::FileDownload", APPLICATION->network());
     for (const auto& file : toDownload) {
+#if defined(WITH_LIBLZMA)
+        auto dl = file.isCompressed ? Net::Download::makeLzmaFile(file.url, file.path) : Net::Download::makeFile(file.url, file.path);
+#else
         auto dl = Net::Download::makeFile(file.url, file.path);
+#endif
         if (!file.hash.isEmpty()) {
             dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, file.hash));
         }
@@ -18,9 +18,10 @@
 
 LaunchStep::LaunchStep(LaunchTask* parent) : Task(), m_parent(parent)
 {
-    connect(this, &LaunchStep::readyForLaunch, parent, &LaunchTask::onReadyForLaunch);
+    connect(this, &LaunchStep::readyForLaunch, parent, [this, parent] { parent->onReadyForLaunch(this); });
     connect(this, &LaunchStep::logLine, parent, &LaunchTask::onLogLine);
     connect(this, &LaunchStep::logLines, parent, &LaunchTask::onLogLines);
-    connect(this, &LaunchStep::finished, parent, &LaunchTask::onStepFinished);
-    connect(this, &LaunchStep::progressReportingRequest, parent, &LaunchTask::onProgressReportingRequested);
+    connect(this, &LaunchStep::logData, parent, &LaunchTask::onLogData);
+    connect(this, &LaunchStep::finished, parent, [this, parent] { parent->onStepFinished(this); });
+    connect(this, &LaunchStep::progressReportingRequest, parent, [this, parent] { parent->onProgressReportingRequested(this); });
 }
@@ -20,6 +20,7 @@
 
 #include <QStringList>
 
+class QTextCodec;
 class LaunchTask;
 class LaunchStep : public Task {
     Q_OBJECT
@@ -27,9 +28,13 @@ class LaunchStep : public Task {
     explicit LaunchStep(LaunchTask* parent);
     virtual ~LaunchStep() = default;
 
+    /// used when logging how long the step took
+    virtual QString name() const { return metaObject()->className(); }
+
    signals:
     void logLines(QStringList lines, MessageLevel::Enum level);
     void logLine(QString line, MessageLevel::Enum level);
+    void logData(QByteArray data, MessageLevel::Enum level, const QTextCodec* codec);
     void readyForLaunch();
     void progressReportingRequest();
 
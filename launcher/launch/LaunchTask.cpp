@@ -42,6 +42,9 @@
 #include <QDir>
 #include <QRegularExpression>
 #include <QStandardPaths>
+
+#include <algorithm>
+
 #include "MessageLevel.h"
 #include "tasks/Task.h"
 
@@ -57,13 +60,29 @@ shared_qobject_ptr<LaunchTask> LaunchTask::create(MinecraftInstancePtr inst)
     return proc;
 }
 
-LaunchTask::LaunchTask(MinecraftInstancePtr instance) : m_instance(instance) {}
+LaunchTask::LaunchTask(MinecraftInstancePtr instance) : m_instance(instance)
+{
+    m_logPipeline.setClassifier(&MinecraftInstance::guessLogLevel);
+    connect(&m_logPipeline, &LogPipeline::linesReady, this, [this](const QVector<LogModel::Line>& lines) { getLogModel()->append(lines); });
+}
 
 void LaunchTask::appendStep(shared_qobject_ptr<LaunchStep> step)
 {
     m_steps.append(step);
 }
 
+void LaunchTask::appendStep(shared_qobject_ptr<LaunchStep> step, const QList<shared_qobject_ptr<LaunchStep>>& dependencies)
+{
+    QList<LaunchStep*> deps;
+    for (auto& dependency : dependencies) {
+        if (dependency) {
+            deps.append(dependency.get());
+        }
+    }
+    m_dependencies.insert(step.get(), deps);
+    m_steps.append(step);
+}
+
 void LaunchTask::prependStep(shared_qobject_ptr<LaunchStep> step)
 {
     m_steps.prepend(step);
@@ -75,45 +94,189 @@ void LaunchTask::executeTask()
     if (!m_steps.size()) {
         state = LaunchTask::Finished;
         emitSucceeded();
+        return;
     }
     state = LaunchTask::Running;
-    onStepFinished();
+
+    m_runs.resize(m_steps.size());
+    for (int i = 0; i < m_steps.size(); i++) {
+        auto& run = m_runs[i];
+        auto explicitDeps = m_dependencies.find(m_steps[i].get());
+        if (explicitDeps == m_dependencies.end()) {
+            for (int j = 0; j < i; j++) {
+                run.dependencies.append(j);
+            }
+            continue;
+        }
+        for (auto dependency : *explicitDeps) {
+            int index = -1;
+            for (int j = 0; j < i; j++) {
+                if (m_steps[j].get() == dependency) {
+                    index = j;
+                    break;
+                }
+            }
+            if (index < 0) {
+                qWarning() << "Launch step" << m_steps[i]->name() << "depends on a step that does not run before it";
+                index = i - 1;
+            }
+            if (index >= 0) {
+                run.dependencies.append(index);
+            }
+        }
+    }
+    scheduleSteps();
 }
 
-void LaunchTask::onReadyForLaunch()
+void LaunchTask::scheduleSteps()
 {
-    state = LaunchTask::Waiting;
-    emit readyForLaunch();
+    // starting, aborting or finishing steps can lead back here, the outermost call does the work
+    if (m_scheduling) {
+        m_reschedule = true;
+        return;
+    }
+    m_scheduling = true;
+    do {
+        m_reschedule = false;
+        if (m_failing && !m_abortedSteps) {
+            // nothing new is started after a failure, and whatever can be stopped is stopped
+            m_abortedSteps = true;
+            for (int i = 0; i < m_runs.size(); i++) {
+                if (m_runs[i].state == StepState::Running && m_steps[i]->canAbort()) {
+                    m_steps[i]->abort();
+                }
+            }
+        }
+        for (int i = 0; i < m_runs.size() && !m_failing; i++) {
+            auto& run = m_runs[i];
+            if (run.state != StepState::Pending) {
+                continue;
+            }
+            bool ready = std::all_of(run.dependencies.begin(), run.dependencies.end(),
+                                     [this](int dependency) { return m_runs[dependency].state == StepState::Succeeded; });
+            if (ready) {
+                run.state = StepState::Starting;
+                // start from the event loop, so one step blocking in a nested event loop does not hold up the others
+                QMetaObject::invokeMethod(this, [this, i] { startStep(i); }, Qt::QueuedConnection);
+            }
+        }
+    } while (m_reschedule);
+    m_scheduling = false;
+
+    bool busy = std::any_of(m_runs.begin(), m_runs.end(), [](const StepRun& run) {
+        return run.state == StepState::Starting || run.state == StepState::Running;
+    });
+    if (busy || m_finalized) {
+        return;
+    }
+    if (m_failing) {
+        finalizeSteps(false, m_failReason);
+    } else if (std::all_of(m_runs.begin(), m_runs.end(), [](const StepRun& run) { return run.state == StepState::Succeeded; })) {
+        finalizeSteps(true, QString());
+    } else {
+        finalizeSteps(false, tr("Some launch steps could not be run because of their dependencies."));
+    }
+}
+
+void LaunchTask::startStep(int index)
+{
+    auto& run = m_runs[index];
+    if (run.state != StepState::Starting) {
+        return;
+    }
+    if (m_failing) {
+        run.state = StepState::Skipped;
+        scheduleSteps();
+        return;
+    }
+    run.state = StepState::Running;
+    run.timer.start();
+    m_startOrder.append(index);
+    m_steps[index]->start();
+}
+
+void LaunchTask::onReadyForLaunch(LaunchStep* step)
+{
+    requestProceed(step, false);
+}
+
+void LaunchTask::onProgressReportingRequested(LaunchStep* step)
+{
+    requestProceed(step, true);
 }
 
-void LaunchTask::onStepFinished()
+void LaunchTask::requestProceed(LaunchStep* step, bool progress)
 {
-    // initial -> just start the first step
-    if (currentStep == -1) {
-        currentStep++;
-        m_steps[currentStep]->start();
+    // steps running side by side must not open their progress dialogs on top of each other
+    m_proceedRequests.append({ step, progress });
+    if (m_proceedRequests.size() == 1) {
+        announceProceedRequest();
+    }
+}
+
+void LaunchTask::announceProceedRequest()
+{
+    // still announced after a failure, some steps only get going once their progress is shown
+    if (m_proceedRequests.isEmpty()) {
         return;
     }
+    auto [step, progress] = m_proceedRequests.first();
+    state = LaunchTask::Waiting;
+    if (progress) {
+        emit requestProgress(step);
+    } else {
+        emit readyForLaunch();
+    }
+}
 
-    auto step = m_steps[currentStep];
+void LaunchTask::onStepFinished(LaunchStep* step)
+{
+    int index = -1;
+    for (int i = 0; i < m_steps.size(); i++) {
+        if (m_steps[i].get() == step) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0 || m_runs[index].state != StepState::Running) {
+        return;
+    }
+    auto& run = m_runs[index];
+    qDebug() << "Launch step" << step->name() << (step->wasSuccessful() ? "succeeded" : "failed") << "after" << run.timer.elapsed()
+             << "ms";
     if (step->wasSuccessful()) {
-        // end?
-        if (currentStep == m_steps.size() - 1) {
-            finalizeSteps(true, QString());
-        } else {
-            currentStep++;
-            step = m_steps[currentStep];
-            step->start();
+        run.state = StepState::Succeeded;
+    } else {
+        run.state = StepState::Failed;
+        if (!m_failing) {
+            m_failing = true;
+            m_failReason = step->failReason();
+        }
+    }
+
+    if (!m_proceedRequests.isEmpty() && m_proceedRequests.first().first == step) {
+        m_proceedRequests.removeFirst();
+        if (state == LaunchTask::Waiting) {
+            state = LaunchTask::Running;
         }
+        // after the dialog of the finished step had a chance to close
+        QMetaObject::invokeMethod(this, &LaunchTask::announceProceedRequest, Qt::QueuedConnection);
     } else {
-        finalizeSteps(false, step->failReason());
+        for (int i = 0; i < m_proceedRequests.size(); i++) {
+            if (m_proceedRequests[i].first == step) {
+                m_proceedRequests.removeAt(i);
+                break;
+            }
+        }
     }
+    scheduleSteps();
 }
 
 void LaunchTask::finalizeSteps(bool successful, const QString& error)
 {
-    for (auto step = currentStep; step >= 0; step--) {
-        m_steps[step]->finalize();
+    m_finalized = true;
+    for (int i = m_startOrder.size() - 1; i >= 0; i--) {
+        m_steps[m_startOrder[i]]->finalize();
     }
     if (successful) {
         emitSucceeded();
@@ -122,33 +285,23 @@ void LaunchTask::finalizeSteps(bool successful, const QString& error)
     }
 }
 
-void LaunchTask::onProgressReportingRequested()
-{
-    state = LaunchTask::Waiting;
-    emit requestProgress(m_steps[currentStep].get());
-}
-
 void LaunchTask::setCensorFilter(QMap<QString, QString> filter)
 {
-    m_censorFilter = filter;
+    m_censorFilter = CensorFilter(filter);
+    m_logPipeline.setCensorFilter(m_censorFilter);
 }
 
 QString LaunchTask::censorPrivateInfo(QString in)
 {
-    auto iter = m_censorFilter.begin();
-    while (iter != m_censorFilter.end()) {
-        in.replace(iter.key(), iter.value());
-        iter++;
-    }
-    return in;
+    return m_censorFilter.censor(in);
 }
 
 void LaunchTask::proceed()
 {
-    if (state != LaunchTask::Waiting) {
+    if (state != LaunchTask::Waiting || m_proceedRequests.isEmpty()) {
         return;
     }
-    m_steps[currentStep]->proceed();
+    m_proceedRequests.first().first->proceed();
 }
 
 bool LaunchTask::canAbort() const
@@ -162,8 +315,12 @@ bool LaunchTask::canAbort() const
             return true;
         case LaunchTask::Running:
         case LaunchTask::Waiting: {
-            auto step = m_steps[currentStep];
-            return step->canAbort();
+            for (int i = 0; i < m_runs.size(); i++) {
+                if (m_runs[i].state == StepState::Running && !m_steps[i]->canAbort()) {
+                    return false;
+                }
+            }
+            return true;
         }
     }
     return false;
@@ -183,14 +340,29 @@ bool LaunchTask::abort()
         }
         case LaunchTask::Running:
         case LaunchTask::Waiting: {
-            auto step = m_steps[currentStep];
-            if (!step->canAbort()) {
+            if (!canAbort()) {
                 return false;
             }
-            if (step->abort()) {
+            // keep the steps that are already queued from starting
+            m_failing = true;
+            if (m_failReason.isEmpty()) {
+                m_failReason = tr("Aborted");
+            }
+            bool aborted = true;
+            // steps finishing right away must not finalize the launch while the others are still running
+            m_abortedSteps = true;
+            m_scheduling = true;
+            for (int i = 0; i < m_runs.size(); i++) {
+                if (m_runs[i].state == StepState::Running) {
+                    aborted = m_steps[i]->abort() && aborted;
+                }
+            }
+            m_scheduling = false;
+            if (aborted) {
                 state = LaunchTask::Aborted;
-                return true;
             }
+            scheduleSteps();
+            return aborted;
         }
         default:
             break;
@@ -215,39 +387,30 @@ shared_qobject_ptr<LogModel> LaunchTask::getLogModel()
 
 void LaunchTask::onLogLines(const QStringList& lines, MessageLevel::Enum defaultLevel)
 {
-    for (auto& line : lines) {
-        onLogLine(line, defaultLevel);
-    }
+    m_logPipeline.addLines(lines, defaultLevel);
 }
 
 void LaunchTask::onLogLine(QString line, MessageLevel::Enum level)
 {
-    // if the launcher part set a log level, use it
-    auto innerLevel = MessageLevel::fromLine(line);
-    if (innerLevel != MessageLevel::Unknown) {
-        level = innerLevel;
-    }
-
-    // If the level is still undetermined, guess level
-    if (level == MessageLevel::StdErr || level == MessageLevel::StdOut || level == MessageLevel::Unknown) {
-        level = m_instance->guessLevel(line, level);
-    }
-
-    // censor private user info
-    line = censorPrivateInfo(line);
+    m_logPipeline.addLines({ line }, level);
+}
 
-    auto& model = *getLogModel();
-    model.append(level, line);
+void LaunchTask::onLogData(const QByteArray& data, MessageLevel::Enum level, const QTextCodec* codec)
+{
+    m_logPipeline.addData(data, level, codec);
 }
 
 void LaunchTask::emitSucceeded()
 {
+    // make sure the last lines are in the log before anyone looks at it
+    m_logPipeline.flush();
     m_instance->setRunning(false);
     Task::emitSucceeded();
 }
 
 void LaunchTask::emitFailed(QString reason)
 {
+    m_logPipeline.flush();
     m_instance->setRunning(false);
     m_instance->setCrashed(true);
     Task::emitFailed(reason);
@@ -38,10 +38,14 @@
 #pragma once
 #include <QObjectPtr.h>
 #include <minecraft/MinecraftInstance.h>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QProcess>
 #include "BaseInstance.h"
+#include "CensorFilter.h"
 #include "LaunchStep.h"
 #include "LogModel.h"
+#include "LogPipeline.h"
 #include "MessageLevel.h"
 
 class LaunchTask : public Task {
@@ -57,7 +61,15 @@ class LaunchTask : public Task {
     static shared_qobject_ptr<LaunchTask> create(MinecraftInstancePtr inst);
     virtual ~LaunchTask() = default;
 
+    /// the step runs after all the steps added before it finished
     void appendStep(shared_qobject_ptr<LaunchStep> step);
+    /**
+     * @brief the step runs as soon as all its dependencies succeeded, possibly alongside other steps
+     * The dependencies have to be added before the step. They are the complete list, so they should lead back to an
+     * ordinary step added with appendStep, or the step could run before the steps prepended later.
+     */
+    void appendStep(shared_qobject_ptr<LaunchStep> step, const QList<shared_qobject_ptr<LaunchStep>>& dependencies);
+    /// the step runs before all the other steps
     void prependStep(shared_qobject_ptr<LaunchStep> step);
     void setCensorFilter(QMap<QString, QString> filter);
 
@@ -85,10 +97,13 @@ class LaunchTask : public Task {
     bool canAbort() const override;
 
     shared_qobject_ptr<LogModel> getLogModel();
+    /// the decoded lines of the launch come out of here, on the GUI thread
+    LogPipeline& logPipeline() { return m_logPipeline; }
 
    public:
     QString substituteVariables(QString& cmd, bool isLaunch = false) const;
     QString censorPrivateInfo(QString in);
+    const CensorFilter& censorFilter() const { return m_censorFilter; }
 
    protected: /* methods */
     virtual void emitFailed(QString reason) override;
@@ -107,19 +122,44 @@ class LaunchTask : public Task {
    public slots:
     void onLogLines(const QStringList& lines, MessageLevel::Enum defaultLevel = MessageLevel::Launcher);
     void onLogLine(QString line, MessageLevel::Enum defaultLevel = MessageLevel::Launcher);
-    void onReadyForLaunch();
-    void onStepFinished();
-    void onProgressReportingRequested();
+    void onLogData(const QByteArray& data, MessageLevel::Enum level, const QTextCodec* codec);
+    void onReadyForLaunch(LaunchStep* step);
+    void onStepFinished(LaunchStep* step);
+    void onProgressReportingRequested(LaunchStep* step);
 
    private: /*methods */
+    void scheduleSteps();
+    void startStep(int index);
+    void requestProceed(LaunchStep* step, bool progress);
+    void announceProceedRequest();
     void finalizeSteps(bool successful, const QString& error);
 
    protected: /* data */
     MinecraftInstancePtr m_instance;
     shared_qobject_ptr<LogModel> m_logModel;
+    LogPipeline m_logPipeline;
     QList<shared_qobject_ptr<LaunchStep>> m_steps;
-    QMap<QString, QString> m_censorFilter;
-    int currentStep = -1;
+    // explicit dependencies, the steps that are not in here depend on all the steps before them
+    QHash<LaunchStep*, QList<LaunchStep*>> m_dependencies;
+    CensorFilter m_censorFilter;
     State state = NotStarted;
+
+    enum class StepState { Pending, Starting, Running, Succeeded, Failed, Skipped };
+    struct StepRun {
+        StepState state = StepState::Pending;
+        QVector<int> dependencies;
+        QElapsedTimer timer;
+    };
+    QVector<StepRun> m_runs;
+    // indices of the steps in the order they started, to finalize them in reverse
+    QVector<int> m_startOrder;
+    // steps waiting for proceed(), only the first one is announced at a time
+    QList<std::pair<LaunchStep*, bool>> m_proceedRequests;
+    bool m_scheduling = false;
+    bool m_reschedule = false;
+    bool m_failing = false;
+    bool m_abortedSteps = false;
+    bool m_finalized = false;
+    QString m_failReason;
     qint64 m_pid = -1;
 };
@@ -1,5 +1,9 @@
 #include "LogModel.h"
 
+namespace {
+constexpr int ChunkSize = 64 * 1024;
+}
+
 LogModel::LogModel(QObject* parent) : QAbstractListModel(parent)
 {
     m_content.resize(m_maxLines);
@@ -21,7 +25,8 @@ QVariant LogModel::data(const QModelIndex& index, int role) const
     auto row = index.row();
     auto realRow = (row + m_firstLine) % m_maxLines;
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        return m_content[realRow].line;
+        auto& entry = m_content[realRow];
+        return QString::fromUtf8(chunk(entry.chunk).constData() + entry.offset, entry.size);
     }
     if (role == LevelRole) {
         return m_content[realRow].level;
@@ -32,31 +37,93 @@ QVariant LogModel::data(const QModelIndex& index, int role) const
 
 void LogModel::append(MessageLevel::Enum level, QString line)
 {
-    if (m_suspended) {
+    append(QVector<Line>{ { level, line } });
+}
+
+void LogModel::append(const QVector<Line>& lines)
+{
+    if (m_suspended || lines.isEmpty()) {
         return;
     }
-    int lineNum = (m_firstLine + m_numLines) % m_maxLines;
-    // overflow
-    if (m_numLines == m_maxLines) {
-        if (m_stopOnOverflow) {
+    int first = 0;
+    int count = lines.size();
+    bool overflowed = false;
+    if (m_stopOnOverflow) {
+        int free = m_maxLines - m_numLines;
+        if (free == 0) {
             // nothing more to do, the buffer is full
             return;
         }
-        beginRemoveRows(QModelIndex(), 0, 0);
-        m_firstLine = (m_firstLine + 1) % m_maxLines;
-        m_numLines--;
-        endRemoveRows();
-    } else if (m_numLines == m_maxLines - 1 && m_stopOnOverflow) {
-        level = MessageLevel::Fatal;
-        line = m_overflowMessage;
+        // the last free line is taken by the overflow message
+        if (count >= free) {
+            count = free;
+            overflowed = true;
+        }
+    } else {
+        // only the newest lines survive a batch larger than the whole buffer
+        if (count > m_maxLines) {
+            first = count - m_maxLines;
+            count = m_maxLines;
+        }
+        int overflow = m_numLines + count - m_maxLines;
+        if (overflow > 0) {
+            beginRemoveRows(QModelIndex(), 0, overflow - 1);
+            m_firstLine = (m_firstLine + overflow) % m_maxLines;
+            m_numLines -= overflow;
+            releaseChunks();
+            endRemoveRows();
+        }
     }
-    beginInsertRows(QModelIndex(), m_numLines, m_numLines);
-    m_numLines++;
-    m_content[lineNum].level = level;
-    m_content[lineNum].line = line;
+    beginInsertRows(QModelIndex(), m_numLines, m_numLines + count - 1);
+    for (int i = 0; i < count; i++) {
+        auto& entry = m_content[(m_firstLine + m_numLines + i) % m_maxLines];
+        if (overflowed && i == count - 1) {
+            store(entry, MessageLevel::Fatal, m_overflowMessage);
+        } else {
+            store(entry, lines[first + i].level, lines[first + i].text);
+        }
+    }
+    m_numLines += count;
     endInsertRows();
 }
 
+void LogModel::store(entry& entry, MessageLevel::Enum level, const QString& line)
+{
+    auto utf8 = line.toUtf8();
+    int needed = utf8.size() + 1;
+    if (m_chunks.empty() || m_chunks.back().size() + needed > m_chunks.back().capacity()) {
+        // lines never cross chunks, a line longer than a chunk gets one of its own
+        QByteArray chunk;
+        chunk.reserve(qMax(ChunkSize, needed));
+        m_chunks.push_back(chunk);
+    }
+    auto& chunk = m_chunks.back();
+    entry.chunk = m_firstChunk + static_cast<quint32>(m_chunks.size() - 1);
+    entry.offset = chunk.size();
+    entry.size = utf8.size();
+    entry.level = level;
+    chunk.append(utf8);
+    chunk.append('\n');
+}
+
+void LogModel::releaseChunks()
+{
+    // the last chunk is kept around to be filled further
+    while (m_chunks.size() > 1 && (m_numLines == 0 || m_content[m_firstLine].chunk != m_firstChunk)) {
+        m_chunks.pop_front();
+        m_firstChunk++;
+    }
+}
+
+qint64 LogModel::memoryUsage() const
+{
+    qint64 usage = m_content.capacity() * sizeof(entry);
+    for (auto& chunk : m_chunks) {
+        usage += chunk.capacity();
+    }
+    return usage;
+}
+
 void LogModel::suspend(bool suspend)
 {
     m_suspended = suspend;
@@ -72,19 +139,29 @@ void LogModel::clear()
     beginResetModel();
     m_firstLine = 0;
     m_numLines = 0;
+    m_chunks.clear();
+    m_firstChunk = 0;
     endResetModel();
 }
 
 QString LogModel::toPlainText()
 {
-    QString out;
-    out.reserve(m_numLines * 80);
-    for (int i = 0; i < m_numLines; i++) {
-        QString& line = m_content[(m_firstLine + i) % m_maxLines].line;
-        out.append(line + '\n');
+    if (m_numLines == 0) {
+        return {};
+    }
+    // lines are only ever removed from the front, so everything from the first line on is the log, newlines included
+    auto& first = m_content[m_firstLine];
+    qint64 size = -static_cast<qint64>(first.offset);
+    for (auto id = first.chunk; id < m_firstChunk + m_chunks.size(); id++) {
+        size += chunk(id).size();
+    }
+    QByteArray out;
+    out.reserve(size);
+    out.append(chunk(first.chunk).constData() + first.offset, chunk(first.chunk).size() - first.offset);
+    for (auto id = first.chunk + 1; id < m_firstChunk + m_chunks.size(); id++) {
+        out.append(chunk(id));
     }
-    out.squeeze();
-    return out;
+    return QString::fromUtf8(out);
 }
 
 void LogModel::setMaxLines(int maxLines)
@@ -94,7 +171,7 @@ void LogModel::setMaxLines(int maxLines)
         return;
     }
     // if it all still fits in the buffer, just resize it
-    if (m_firstLine + m_numLines < m_maxLines) {
+    if (m_firstLine + m_numLines <= qMin(m_maxLines, maxLines)) {
         m_maxLines = maxLines;
         m_content.resize(maxLines);
         return;
@@ -115,8 +192,10 @@ void LogModel::setMaxLines(int maxLines)
         for (int i = 0; i < maxLines; i++) {
             newContent[i] = m_content[(m_firstLine + lead + i) % m_maxLines];
         }
-        m_numLines = m_maxLines;
+        m_numLines = maxLines;
         m_content.swap(newContent);
+        m_firstLine = 0;
+        releaseChunks();
         endRemoveRows();
     }
     m_firstLine = 0;
@@ -1,24 +1,37 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QByteArray>
 #include <QString>
+#include <QVector>
 #include "MessageLevel.h"
 
+#include <deque>
+
 class LogModel : public QAbstractListModel {
     Q_OBJECT
    public:
+    struct Line {
+        MessageLevel::Enum level = MessageLevel::Unknown;
+        QString text;
+    };
+
     explicit LogModel(QObject* parent = 0);
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const;
     QVariant data(const QModelIndex& index, int role) const;
 
     void append(MessageLevel::Enum, QString line);
+    /// appends all the lines with a single row insertion
+    void append(const QVector<Line>& lines);
     void clear();
 
     void suspend(bool suspend);
     bool suspended();
 
     QString toPlainText();
+    /// bytes allocated for the stored lines
+    qint64 memoryUsage() const;
 
     int getMaxLines();
     void setMaxLines(int maxLines);
@@ -31,13 +44,25 @@ class LogModel : public QAbstractListModel {
     enum Roles { LevelRole = Qt::UserRole };
 
    private /* types */:
+    // where a line lives in the arena. the text is followed by a newline there, which is not part of the size
     struct entry {
+        quint32 chunk = 0;
+        quint32 offset = 0;
+        quint32 size = 0;
         MessageLevel::Enum level = MessageLevel::Enum::Unknown;
-        QString line;
     };
 
+   private: /* methods */
+    void store(entry& entry, MessageLevel::Enum level, const QString& line);
+    const QByteArray& chunk(quint32 id) const { return m_chunks[id - m_firstChunk]; }
+    void releaseChunks();
+
    private: /* data */
     QVector<entry> m_content;
+    // the text of all the lines as UTF-8, in the order they were added. chunks are dropped once their lines are gone
+    std::deque<QByteArray> m_chunks;
+    // id of the first chunk in m_chunks
+    quint32 m_firstChunk = 0;
     int m_maxLines = 1000;
     // first line in the circular buffer
     int m_firstLine = 0;
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "LogPipeline.h"
+
+#include <QSemaphore>
+#include <QTextCodec>
+#include <QTextDecoder>
+
+namespace {
+// upper bound for how often the GUI thread is bothered with new lines
+constexpr int FrameInterval = 33;
+constexpr std::size_t BatchCapacity = 1024;
+}  // namespace
+
+LogPipeline::LogPipeline(QObject* parent) : QObject(parent), m_context(new QObject), m_batches(BatchCapacity)
+{
+    m_thread.setObjectName("LogPipeline");
+    m_context->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_context, &QObject::deleteLater);
+    m_thread.start();
+
+    m_drainTimer.setSingleShot(true);
+    connect(&m_drainTimer, &QTimer::timeout, this, &LogPipeline::drain);
+    m_sinceDrain.start();
+}
+
+LogPipeline::~LogPipeline()
+{
+    m_stopping = true;
+    m_thread.quit();
+    m_thread.wait();
+}
+
+template <typename F>
+void LogPipeline::post(F&& job)
+{
+    QMetaObject::invokeMethod(m_context, std::forward<F>(job), Qt::QueuedConnection);
+}
+
+void LogPipeline::setClassifier(Classifier classifier)
+{
+    post([this, classifier] { m_classifier = classifier; });
+}
+
+void LogPipeline::setCensorFilter(const CensorFilter& filter)
+{
+    post([this, filter] { m_censorFilter = filter; });
+}
+
+void LogPipeline::addLines(const QStringList& lines, MessageLevel::Enum level)
+{
+    post([this, lines, level] { process(lines, level); });
+}
+
+void LogPipeline::addData(const QByteArray& data, MessageLevel::Enum level, const QTextCodec* codec)
+{
+    post([this, data, level, codec] {
+        auto& stream = m_streams[level];
+        if (!stream.decoder || stream.codec != codec) {
+            stream.codec = codec;
+            stream.decoder.reset(new QTextDecoder(codec));
+        }
+        auto str = stream.decoder->toUnicode(data);
+        if (!stream.leftover.isEmpty()) {
+            str.prepend(stream.leftover);
+            stream.leftover.clear();
+        }
+        auto lines = str.remove(QChar::CarriageReturn).split(QChar::LineFeed);
+        stream.leftover = lines.takeLast();
+        if (!lines.isEmpty())
+            process(lines, level);
+    });
+}
+
+void LogPipeline::process(QStringList lines, MessageLevel::Enum defaultLevel)
+{
+    QVector<LogModel::Line> batch;
+    batch.reserve(lines.size());
+    for (auto& line : lines) {
+        auto level = defaultLevel;
+
+        // if the launcher part set a log level, use it
+        auto innerLevel = MessageLevel::fromLine(line);
+        if (innerLevel != MessageLevel::Unknown) {
+            level = innerLevel;
+        }
+
+        // If the level is still undetermined, guess level
+        if (m_classifier && (level == MessageLevel::StdErr || level == MessageLevel::StdOut || level == MessageLevel::Unknown)) {
+            level = m_classifier(line, level);
+        }
+
+        // censor private user info
+        batch.append({ level, m_censorFilter.censor(line) });
+    }
+    push(std::move(batch));
+}
+
+void LogPipeline::push(QVector<LogModel::Line>&& batch)
+{
+    // the GUI thread fell behind a whole buffer of batches, so wait for it instead of dropping lines
+    while (!m_batches.push(std::move(batch))) {
+        if (m_stopping)
+            return;
+        QThread::msleep(1);
+    }
+    if (!m_drainScheduled.exchange(true)) {
+        QMetaObject::invokeMethod(this, &LogPipeline::scheduleDrain, Qt::QueuedConnection);
+    }
+}
+
+void LogPipeline::scheduleDrain()
+{
+    if (m_drainTimer.isActive())
+        return;
+    auto wait = FrameInterval - m_sinceDrain.elapsed();
+    if (wait <= 0) {
+        drain();
+    } else {
+        m_drainTimer.start(static_cast<int>(wait));
+    }
+}
+
+void LogPipeline::drain()
+{
+    m_drainTimer.stop();
+    // anything pushed from now on needs another drain
+    m_drainScheduled = false;
+    QVector<LogModel::Line> lines;
+    while (auto batch = m_batches.pop()) {
+        lines += *batch;
+    }
+    m_sinceDrain.restart();
+    if (!lines.isEmpty()) {
+        emit linesReady(lines);
+    }
+}
+
+void LogPipeline::flush()
+{
+    QSemaphore done;
+    post([&done] { done.release(); });
+    // keep draining while waiting, the worker may be waiting for room in the ring buffer
+    while (!done.tryAcquire(1, 5)) {
+        drain();
+    }
+    drain();
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include "CensorFilter.h"
+#include "MessageLevel.h"
+#include "SpscRingBuffer.h"
+#include "launch/LogModel.h"
+
+class QTextCodec;
+class QTextDecoder;
+
+/* LogPipeline
+ * Turns the raw output of a launch into log model lines without blocking the GUI thread.
+ *
+ * Decoding, line splitting, level classification and censoring happen on a dedicated worker thread.
+ * The finished batches are handed back through a lock-free ring buffer and picked up on the GUI thread
+ * at most once per frame, so a game spamming its log costs one model insertion per frame instead of one per line.
+ * Everything added to the pipeline comes out in the same order.
+ */
+class LogPipeline : public QObject {
+    Q_OBJECT
+   public:
+    using Classifier = std::function<MessageLevel::Enum(const QString& line, MessageLevel::Enum level)>;
+
+    explicit LogPipeline(QObject* parent = nullptr);
+    virtual ~LogPipeline();
+
+    /// runs on the worker thread, so it must not touch anything that lives on the GUI thread
+    void setClassifier(Classifier classifier);
+    /// applies to everything added after this call
+    void setCensorFilter(const CensorFilter& filter);
+
+    void addLines(const QStringList& lines, MessageLevel::Enum level);
+    /// raw process output. level is the stream it came from, either MessageLevel::StdOut or MessageLevel::StdErr
+    void addData(const QByteArray& data, MessageLevel::Enum level, const QTextCodec* codec);
+
+    /// blocks until everything added so far went through the pipeline and was handed out
+    void flush();
+
+   signals:
+    void linesReady(const QVector<LogModel::Line>& lines);
+
+   private:
+    // worker thread
+    void process(QStringList lines, MessageLevel::Enum defaultLevel);
+    void push(QVector<LogModel::Line>&& batch);
+
+    // GUI thread
+    void scheduleDrain();
+    void drain();
+
+    template <typename F>
+    void post(F&& job);
+
+   private:
+    struct Stream {
+        const QTextCodec* codec = nullptr;
+        std::unique_ptr<QTextDecoder> decoder;
+        QString leftover;
+    };
+
+    QThread m_thread;
+    QObject* m_context;
+    SpscRingBuffer<QVector<LogModel::Line>> m_batches;
+    std::atomic<bool> m_drainScheduled{ false };
+    std::atomic<bool> m_stopping{ false };
+
+    // only used on the worker thread
+    Classifier m_classifier;
+    CensorFilter m_censorFilter;
+    std::map<MessageLevel::Enum, Stream> m_streams;
+
+    // only used on the GUI thread
+    QTimer m_drainTimer;
+    QElapsedTimer m_sinceDrain;
+};
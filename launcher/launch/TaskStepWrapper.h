@@ -24,9 +24,11 @@
 class TaskStepWrapper : public LaunchStep {
     Q_OBJECT
    public:
-    explicit TaskStepWrapper(LaunchTask* parent, Task::Ptr task) : LaunchStep(parent), m_task(task) {};
+    explicit TaskStepWrapper(LaunchTask* parent, Task::Ptr task) : LaunchStep(parent), m_task(task), m_name(task->metaObject()->className()) {};
     virtual ~TaskStepWrapper() = default;
 
+    QString name() const override { return m_name; }
+
     void executeTask() override;
     bool canAbort() const override;
     void proceed() override;
@@ -38,4 +40,5 @@ class TaskStepWrapper : public LaunchStep {
 
    private:
     Task::Ptr m_task;
+    QString m_name;
 };
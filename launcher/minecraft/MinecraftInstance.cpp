@@ -178,77 +178,77 @@ void MinecraftInstance::loadSpecificSettings()
         return;
 
     // Java Settings
-    auto locationOverride = m_settings->registerSetting("OverrideJavaLocation", false);
-    auto argsOverride = m_settings->registerSetting("OverrideJavaArgs", false);
-    m_settings->registerSetting("AutomaticJava", false);
+    m_settings->declareSetting("OverrideJavaLocation", false);
+    m_settings->declareSetting("OverrideJavaArgs", false);
+    m_settings->declareSetting("AutomaticJava", false);
 
     if (auto global_settings = globalSettings()) {
-        m_settings->registerOverride(global_settings->getSetting("JavaPath"), locationOverride);
-        m_settings->registerOverride(global_settings->getSetting("JvmArgs"), argsOverride);
-        m_settings->registerOverride(global_settings->getSetting("IgnoreJavaCompatibility"), locationOverride);
+        m_settings->declareOverride(global_settings->getSetting("JavaPath"), "OverrideJavaLocation");
+        m_settings->declareOverride(global_settings->getSetting("JvmArgs"), "OverrideJavaArgs");
+        m_settings->declareOverride(global_settings->getSetting("IgnoreJavaCompatibility"), "OverrideJavaLocation");
 
         // special!
-        m_settings->registerPassthrough(global_settings->getSetting("JavaSignature"), locationOverride);
-        m_settings->registerPassthrough(global_settings->getSetting("JavaArchitecture"), locationOverride);
-        m_settings->registerPassthrough(global_settings->getSetting("JavaRealArchitecture"), locationOverride);
-        m_settings->registerPassthrough(global_settings->getSetting("JavaVersion"), locationOverride);
-        m_settings->registerPassthrough(global_settings->getSetting("JavaVendor"), locationOverride);
+        m_settings->declarePassthrough(global_settings->getSetting("JavaSignature"), "OverrideJavaLocation");
+        m_settings->declarePassthrough(global_settings->getSetting("JavaArchitecture"), "OverrideJavaLocation");
+        m_settings->declarePassthrough(global_settings->getSetting("JavaRealArchitecture"), "OverrideJavaLocation");
+        m_settings->declarePassthrough(global_settings->getSetting("JavaVersion"), "OverrideJavaLocation");
+        m_settings->declarePassthrough(global_settings->getSetting("JavaVendor"), "OverrideJavaLocation");
 
         // Window Size
-        auto windowSetting = m_settings->registerSetting("OverrideWindow", false);
-        m_settings->registerOverride(global_settings->getSetting("LaunchMaximized"), windowSetting);
-        m_settings->registerOverride(global_settings->getSetting("MinecraftWinWidth"), windowSetting);
-        m_settings->registerOverride(global_settings->getSetting("MinecraftWinHeight"), windowSetting);
+        m_settings->declareSetting("OverrideWindow", false);
+        m_settings->declareOverride(global_settings->getSetting("LaunchMaximized"), "OverrideWindow");
+        m_settings->declareOverride(global_settings->getSetting("MinecraftWinWidth"), "OverrideWindow");
+        m_settings->declareOverride(global_settings->getSetting("MinecraftWinHeight"), "OverrideWindow");
 
         // Memory
-        auto memorySetting = m_settings->registerSetting("OverrideMemory", false);
-        m_settings->registerOverride(global_settings->getSetting("MinMemAlloc"), memorySetting);
-        m_settings->registerOverride(global_settings->getSetting("MaxMemAlloc"), memorySetting);
-        m_settings->registerOverride(global_settings->getSetting("PermGen"), memorySetting);
+        m_settings->declareSetting("OverrideMemory", false);
+        m_settings->declareOverride(global_settings->getSetting("MinMemAlloc"), "OverrideMemory");
+        m_settings->declareOverride(global_settings->getSetting("MaxMemAlloc"), "OverrideMemory");
+        m_settings->declareOverride(global_settings->getSetting("PermGen"), "OverrideMemory");
 
         // Native library workarounds
-        auto nativeLibraryWorkaroundsOverride = m_settings->registerSetting("OverrideNativeWorkarounds", false);
-        m_settings->registerOverride(global_settings->getSetting("UseNativeOpenAL"), nativeLibraryWorkaroundsOverride);
-        m_settings->registerOverride(global_settings->getSetting("CustomOpenALPath"), nativeLibraryWorkaroundsOverride);
-        m_settings->registerOverride(global_settings->getSetting("UseNativeGLFW"), nativeLibraryWorkaroundsOverride);
-        m_settings->registerOverride(global_settings->getSetting("CustomGLFWPath"), nativeLibraryWorkaroundsOverride);
+        m_settings->declareSetting("OverrideNativeWorkarounds", false);
+        m_settings->declareOverride(global_settings->getSetting("UseNativeOpenAL"), "OverrideNativeWorkarounds");
+        m_settings->declareOverride(global_settings->getSetting("CustomOpenALPath"), "OverrideNativeWorkarounds");
+        m_settings->declareOverride(global_settings->getSetting("UseNativeGLFW"), "OverrideNativeWorkarounds");
+        m_settings->declareOverride(global_settings->getSetting("CustomGLFWPath"), "OverrideNativeWorkarounds");
 
         // Performance related options
-        auto performanceOverride = m_settings->registerSetting("OverridePerformance", false);
-        m_settings->registerOverride(global_settings->getSetting("EnableFeralGamemode"), performanceOverride);
-        m_settings->registerOverride(global_settings->getSetting("EnableMangoHud"), performanceOverride);
-        m_settings->registerOverride(global_settings->getSetting("UseDiscreteGpu"), performanceOverride);
-        m_settings->registerOverride(global_settings->getSetting("UseZink"), performanceOverride);
+        m_settings->declareSetting("OverridePerformance", false);
+        m_settings->declareOverride(global_settings->getSetting("EnableFeralGamemode"), "OverridePerformance");
+        m_settings->declareOverride(global_settings->getSetting("EnableMangoHud"), "OverridePerformance");
+        m_settings->declareOverride(global_settings->getSetting("UseDiscreteGpu"), "OverridePerformance");
+        m_settings->declareOverride(global_settings->getSetting("UseZink"), "OverridePerformance");
 
         // Miscellaneous
-        auto miscellaneousOverride = m_settings->registerSetting("OverrideMiscellaneous", false);
-        m_settings->registerOverride(global_settings->getSetting("CloseAfterLaunch"), miscellaneousOverride);
-        m_settings->registerOverride(global_settings->getSetting("QuitAfterGameStop"), miscellaneousOverride);
+        m_settings->declareSetting("OverrideMiscellaneous", false);
+        m_settings->declareOverride(global_settings->getSetting("CloseAfterLaunch"), "OverrideMiscellaneous");
+        m_settings->declareOverride(global_settings->getSetting("QuitAfterGameStop"), "OverrideMiscellaneous");
 
         // Legacy-related options
-        auto legacySettings = m_settings->registerSetting("OverrideLegacySettings", false);
-        m_settings->registerOverride(global_settings->getSetting("OnlineFixes"), legacySettings);
+        m_settings->declareSetting("OverrideLegacySettings", false);
+        m_settings->declareOverride(global_settings->getSetting("OnlineFixes"), "OverrideLegacySettings");
 
-        auto envSetting = m_settings->registerSetting("OverrideEnv", false);
-        m_settings->registerOverride(global_settings->getSetting("Env"), envSetting);
+        m_settings->declareSetting("OverrideEnv", false);
+        m_settings->declareOverride(global_settings->getSetting("Env"), "OverrideEnv");
 
         m_settings->set("InstanceType", "OneSix");
     }
 
     // Join server on launch, this does not have a global override
-    m_settings->registerSetting("JoinServerOnLaunch", false);
-    m_settings->registerSetting("JoinServerOnLaunchAddress", "");
-    m_settings->registerSetting("JoinWorldOnLaunch", "");
+    m_settings->declareSetting("JoinServerOnLaunch", false);
+    m_settings->declareSetting("JoinServerOnLaunchAddress", "");
+    m_settings->declareSetting("JoinWorldOnLaunch", "");
 
     // Use account for instance, this does not have a global override
-    m_settings->registerSetting("UseAccountForInstance", false);
-    m_settings->registerSetting("InstanceAccountId", "");
+    m_settings->declareSetting("UseAccountForInstance", false);
+    m_settings->declareSetting("InstanceAccountId", "");
 
-    m_settings->registerSetting("ExportName", "");
-    m_settings->registerSetting("ExportVersion", "1.0.0");
-    m_settings->registerSetting("ExportSummary", "");
-    m_settings->registerSetting("ExportAuthor", "");
-    m_settings->registerSetting("ExportOptionalFiles", true);
+    m_settings->declareSetting("ExportName", "");
+    m_settings->declareSetting("ExportVersion", "1.0.0");
+    m_settings->declareSetting("ExportSummary", "");
+    m_settings->declareSetting("ExportAuthor", "");
+    m_settings->declareSetting("ExportOptionalFiles", true);
 
     qDebug() << "Instance-type specific settings were loaded!";
 
@@ -1012,14 +1012,39 @@ QMap<QString, QString> MinecraftInstance::createCensorFilterFromSession(AuthSess
     return filter;
 }
 
+namespace {
+// the patterns are compiled and JIT optimized once, not for every line
+QRegularExpression optimizedRegex(const QString& pattern)
+{
+    QRegularExpression re(pattern);
+    re.optimize();
+    return re;
+}
+}  // namespace
+
 MessageLevel::Enum MinecraftInstance::guessLevel(const QString& line, MessageLevel::Enum level)
 {
-    QRegularExpression re("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
-    auto match = re.match(line);
+    return guessLogLevel(line, level);
+}
+
+MessageLevel::Enum MinecraftInstance::guessLogLevel(const QString& line, MessageLevel::Enum level)
+{
+    // NOTE: this diverges from the real regexp. no unicode, the first section is + instead of *
+    static const QString javaSymbol = "([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$][a-zA-Z\\d_$]*";
+    static const auto s_log4jHeader = optimizedRegex("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
+    static const auto s_stackFrame = optimizedRegex("\\s+at " + javaSymbol);
+    static const auto s_causedBy = optimizedRegex("Caused by: " + javaSymbol);
+    static const auto s_exception =
+        optimizedRegex("([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$]?[a-zA-Z\\d_$]*(Exception|Error|Throwable)");
+    static const auto s_more = optimizedRegex("... \\d+ more$");
+
+    // every regex only runs if the line contains a piece of text the pattern can't match without
+    QRegularExpressionMatch match;
+    if (line.contains(QLatin1String("] [")))
+        match = s_log4jHeader.match(line);
     if (match.hasMatch()) {
         // New style logs from log4j
-        QString timestamp = match.captured("timestamp");
-        QString levelStr = match.captured("level");
+        auto levelStr = match.captured("level");
         if (levelStr == "INFO")
             level = MessageLevel::Message;
         if (levelStr == "WARN")
@@ -1030,7 +1055,7 @@ MessageLevel::Enum MinecraftInstance::guessLevel(const QString& line, MessageLev
             level = MessageLevel::Fatal;
         if (levelStr == "TRACE" || levelStr == "DEBUG")
             level = MessageLevel::Debug;
-    } else {
+    } else if (line.contains('[')) {
         // Old style forge logs
         if (line.contains("[INFO]") || line.contains("[CONFIG]") || line.contains("[FINE]") || line.contains("[FINER]") ||
             line.contains("[FINEST]"))
@@ -1044,12 +1069,11 @@ MessageLevel::Enum MinecraftInstance::guessLevel(const QString& line, MessageLev
     }
     if (line.contains("overwriting existing"))
         return MessageLevel::Fatal;
-    // NOTE: this diverges from the real regexp. no unicode, the first section is + instead of *
-    static const QString javaSymbol = "([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$][a-zA-Z\\d_$]*";
-    if (line.contains("Exception in thread") || line.contains(QRegularExpression("\\s+at " + javaSymbol)) ||
-        line.contains(QRegularExpression("Caused by: " + javaSymbol)) ||
-        line.contains(QRegularExpression("([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$]?[a-zA-Z\\d_$]*(Exception|Error|Throwable)")) ||
-        line.contains(QRegularExpression("... \\d+ more$")))
+    if (line.contains("Exception in thread") || (line.contains(QLatin1String("at ")) && line.contains(s_stackFrame)) ||
+        (line.contains(QLatin1String("Caused by: ")) && line.contains(s_causedBy)) ||
+        ((line.contains(QLatin1String("Exception")) || line.contains(QLatin1String("Error")) || line.contains(QLatin1String("Throwable"))) &&
+         line.contains(s_exception)) ||
+        (line.contains(QLatin1String(" more")) && line.contains(s_more)))
         return MessageLevel::Error;
     return level;
 }
@@ -1159,65 +1183,76 @@ shared_qobject_ptr<LaunchTask> MinecraftInstance::createLaunchTask(AuthSessionPt
         process->appendStep(step);
     }
 
-    // load meta
+    // load meta, everything after this needs the loaded profile
+    shared_qobject_ptr<LaunchStep> prepared;
     {
         auto mode = session->status != AuthSession::PlayableOffline ? Net::Mode::Online : Net::Mode::Offline;
-        process->appendStep(makeShared<TaskStepWrapper>(pptr, makeShared<MinecraftLoadAndCheck>(this, mode)));
+        prepared = makeShared<TaskStepWrapper>(pptr, makeShared<MinecraftLoadAndCheck>(this, mode));
+        process->appendStep(prepared);
     }
 
-    // check java
+    // check java, alongside the downloads
+    shared_qobject_ptr<LaunchStep> javaChecked;
     {
-        process->appendStep(makeShared<AutoInstallJava>(pptr));
-        process->appendStep(makeShared<CheckJava>(pptr));
+        auto autoInstall = makeShared<AutoInstallJava>(pptr);
+        process->appendStep(autoInstall, { prepared });
+        javaChecked = makeShared<CheckJava>(pptr);
+        process->appendStep(javaChecked, { autoInstall });
     }
 
-    // run pre-launch command if that's needed
+    // run pre-launch command if that's needed. it may change anything in the instance, so it runs on its own
     if (getPreLaunchCommand().size()) {
         auto step = makeShared<PreLaunchCommand>(pptr);
         step->setWorkingDirectory(gameRoot());
         process->appendStep(step);
+        prepared = step;
     }
 
     // if we aren't in offline mode,.
+    auto downloaded = prepared;
     if (session->status != AuthSession::PlayableOffline) {
         if (!session->demo) {
-            process->appendStep(makeShared<ClaimAccount>(pptr, session));
+            auto step = makeShared<ClaimAccount>(pptr, session);
+            process->appendStep(step, { prepared });
         }
         for (auto t : createUpdateTask()) {
-            process->appendStep(makeShared<TaskStepWrapper>(pptr, t));
+            auto step = makeShared<TaskStepWrapper>(pptr, t);
+            process->appendStep(step, { downloaded });
+            downloaded = step;
         }
     }
 
     // if there are any jar mods
     {
-        process->appendStep(makeShared<ModMinecraftJar>(pptr));
+        process->appendStep(makeShared<ModMinecraftJar>(pptr), { downloaded });
     }
 
     // Scan mods folders for mods
-    {
-        process->appendStep(makeShared<ScanModFolders>(pptr));
-    }
+    shared_qobject_ptr<LaunchStep> modsScanned = makeShared<ScanModFolders>(pptr);
+    process->appendStep(modsScanned, { prepared });
 
     // print some instance info here...
     {
-        process->appendStep(makeShared<PrintInstanceInfo>(pptr, session, targetToJoin));
+        process->appendStep(makeShared<PrintInstanceInfo>(pptr, session, targetToJoin), { downloaded, modsScanned, javaChecked });
     }
 
     // extract native jars if needed
     {
-        process->appendStep(makeShared<ExtractNatives>(pptr));
+        process->appendStep(makeShared<ExtractNatives>(pptr), { downloaded });
     }
 
     // reconstruct assets if needed
     {
-        process->appendStep(makeShared<ReconstructAssets>(pptr));
+        process->appendStep(makeShared<ReconstructAssets>(pptr), { downloaded });
     }
 
     // verify that minimum Java requirements are met
     {
-        process->appendStep(makeShared<VerifyJavaInstall>(pptr));
+        process->appendStep(makeShared<VerifyJavaInstall>(pptr), { javaChecked });
     }
 
+    // the launch itself waits for all the steps above
+
     {
         // actually launch the game
         auto step = makeShared<LauncherPartLaunch>(pptr);
@@ -141,6 +141,7 @@ class MinecraftInstance : public BaseInstance {
 
     /// guess log level from a line of minecraft log
     MessageLevel::Enum guessLevel(const QString& line, MessageLevel::Enum level) override;
+    static MessageLevel::Enum guessLogLevel(const QString& line, MessageLevel::Enum level);
 
     IPathMatcher::Ptr getLogFileMatcher() override;
 
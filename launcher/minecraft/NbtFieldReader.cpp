@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "NbtFieldReader.h"
+
+#include <zlib.h>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+// the same nesting limit as Minecraft itself
+constexpr int s_maxDepth = 512;
+constexpr size_t s_chunkSize = 16 * 1024;
+
+size_t fixedSize(NbtFieldReader::TagType type)
+{
+    switch (type) {
+        case NbtFieldReader::TagType::Byte:
+            return 1;
+        case NbtFieldReader::TagType::Short:
+            return 2;
+        case NbtFieldReader::TagType::Int:
+        case NbtFieldReader::TagType::Float:
+            return 4;
+        case NbtFieldReader::TagType::Long:
+        case NbtFieldReader::TagType::Double:
+            return 8;
+        default:
+            return 0;
+    }
+}
+}  // namespace
+
+// sequential reader over the NBT data, inflating it one chunk at a time when it is compressed
+class NbtFieldReader::Input {
+   public:
+    explicit Input(const QByteArray& data) : m_data(data)
+    {
+        // uncompressed NBT starts with the type of the root tag, gzip with its magic
+        m_compressed = data.size() >= 2 && static_cast<uchar>(data[0]) == 0x1f && static_cast<uchar>(data[1]) == 0x8b;
+        if (!m_compressed)
+            return;
+        memset(&m_stream, 0, sizeof(m_stream));
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+        m_stream.avail_in = static_cast<uInt>(data.size());
+        m_ok = inflateInit2(&m_stream, 16 + MAX_WBITS) == Z_OK;
+        m_inflating = m_ok;
+    }
+
+    ~Input()
+    {
+        if (m_inflating)
+            inflateEnd(&m_stream);
+    }
+
+    bool read(void* out, size_t size) { return consume(static_cast<char*>(out), size); }
+    bool skip(size_t size) { return consume(nullptr, size); }
+
+    template <typename T>
+    bool readNumber(T& value)
+    {
+        uchar raw[sizeof(T)];
+        if (!read(raw, sizeof(T)))
+            return false;
+        value = qFromBigEndian<T>(raw);
+        return true;
+    }
+
+   private:
+    bool consume(char* out, size_t size)
+    {
+        if (!m_ok)
+            return false;
+        if (!m_compressed) {
+            if (size > static_cast<size_t>(m_data.size()) - m_rawPos)
+                return m_ok = false;
+            if (out)
+                memcpy(out, m_data.constData() + m_rawPos, size);
+            m_rawPos += size;
+            return true;
+        }
+        while (size > 0) {
+            if (m_pos == m_end && !fill())
+                return m_ok = false;
+            size_t count = qMin(size, m_end - m_pos);
+            if (out) {
+                memcpy(out, m_buffer + m_pos, count);
+                out += count;
+            }
+            m_pos += count;
+            size -= count;
+        }
+        return true;
+    }
+
+    bool fill()
+    {
+        if (m_finished)
+            return false;
+        m_stream.next_out = reinterpret_cast<Bytef*>(m_buffer);
+        m_stream.avail_out = static_cast<uInt>(s_chunkSize);
+        int status = inflate(&m_stream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END)
+            m_finished = true;
+        else if (status != Z_OK)
+            return false;
+        m_pos = 0;
+        m_end = s_chunkSize - m_stream.avail_out;
+        return m_end > 0;
+    }
+
+   private:
+    const QByteArray& m_data;
+    bool m_compressed = false;
+    bool m_ok = true;
+    size_t m_rawPos = 0;
+
+    z_stream m_stream;
+    bool m_inflating = false;
+    bool m_finished = false;
+    char m_buffer[s_chunkSize];
+    size_t m_pos = 0;
+    size_t m_end = 0;
+};
+
+NbtFieldReader::NbtFieldReader(const QList<QByteArray>& paths)
+{
+    for (auto& path : paths) {
+        m_wanted.insert(path);
+        for (int dot = path.indexOf('.'); dot >= 0; dot = path.indexOf('.', dot + 1))
+            m_prefixes.insert(path.left(dot));
+    }
+}
+
+bool NbtFieldReader::read(const QByteArray& data)
+{
+    m_fields.clear();
+    Input input(data);
+
+    quint8 type;
+    quint16 nameSize;
+    // the root is an unnamed compound
+    if (!input.readNumber(type) || static_cast<TagType>(type) != TagType::Compound || !input.readNumber(nameSize) || nameSize != 0)
+        return false;
+    return readCompound(input, {}, 0);
+}
+
+bool NbtFieldReader::readCompound(Input& input, const QByteArray& path, int depth)
+{
+    if (depth > s_maxDepth)
+        return false;
+    while (true) {
+        quint8 rawType;
+        if (!input.readNumber(rawType))
+            return false;
+        if (rawType > static_cast<quint8>(TagType::LongArray))
+            return false;
+        auto type = static_cast<TagType>(rawType);
+        if (type == TagType::End)
+            return true;
+
+        quint16 nameSize;
+        if (!input.readNumber(nameSize))
+            return false;
+        QByteArray childPath = path;
+        if (!path.isEmpty())
+            childPath.append('.');
+        int nameOffset = childPath.size();
+        childPath.resize(nameOffset + nameSize);
+        if (!input.read(childPath.data() + nameOffset, nameSize))
+            return false;
+
+        bool ok;
+        if (m_wanted.contains(childPath)) {
+            ok = readField(input, type, childPath, depth + 1);
+        } else if (type == TagType::Compound && m_prefixes.contains(childPath)) {
+            m_fields.insert(childPath, { type, {} });
+            ok = readCompound(input, childPath, depth + 1);
+        } else {
+            ok = skipPayload(input, type, depth + 1);
+        }
+        if (!ok)
+            return false;
+    }
+}
+
+bool NbtFieldReader::readField(Input& input, TagType type, const QByteArray& path, int depth)
+{
+    Field field{ type, {} };
+    switch (type) {
+        case TagType::Byte: {
+            qint8 value;
+            if (!input.readNumber(value))
+                return false;
+            field.value = value;
+            break;
+        }
+        case TagType::Short: {
+            qint16 value;
+            if (!input.readNumber(value))
+                return false;
+            field.value = value;
+            break;
+        }
+        case TagType::Int: {
+            qint32 value;
+            if (!input.readNumber(value))
+                return false;
+            field.value = value;
+            break;
+        }
+        case TagType::Long: {
+            qint64 value;
+            if (!input.readNumber(value))
+                return false;
+            field.value = value;
+            break;
+        }
+        case TagType::String: {
+            quint16 size;
+            if (!input.readNumber(size))
+                return false;
+            QByteArray value(size, Qt::Uninitialized);
+            if (!input.read(value.data(), size))
+                return false;
+            // NBT uses modified UTF-8, which only differs for NUL and characters outside of the BMP
+            field.value = QString::fromUtf8(value);
+            break;
+        }
+        default:
+            // not a value, or nothing anyone needs yet
+            if (!skipPayload(input, type, depth))
+                return false;
+            break;
+    }
+    m_fields.insert(path, field);
+    return true;
+}
+
+bool NbtFieldReader::skipPayload(Input& input, TagType type, int depth)
+{
+    if (depth > s_maxDepth)
+        return false;
+    if (auto size = fixedSize(type))
+        return input.skip(size);
+    switch (type) {
+        case TagType::ByteArray:
+        case TagType::IntArray:
+        case TagType::LongArray: {
+            qint32 count;
+            if (!input.readNumber(count) || count < 0)
+                return false;
+            size_t elementSize = type == TagType::ByteArray ? 1 : type == TagType::IntArray ? 4 : 8;
+            return input.skip(static_cast<size_t>(count) * elementSize);
+        }
+        case TagType::String: {
+            quint16 size;
+            return input.readNumber(size) && input.skip(size);
+        }
+        case TagType::List: {
+            quint8 rawType;
+            qint32 count;
+            if (!input.readNumber(rawType) || !input.readNumber(count) || rawType > static_cast<quint8>(TagType::LongArray))
+                return false;
+            auto elementType = static_cast<TagType>(rawType);
+            if (count <= 0)
+                return true;
+            if (auto size = fixedSize(elementType))
+                return input.skip(static_cast<size_t>(count) * size);
+            for (qint32 i = 0; i < count; i++) {
+                if (!skipPayload(input, elementType, depth + 1))
+                    return false;
+            }
+            return true;
+        }
+        case TagType::Compound: {
+            while (true) {
+                quint8 rawType;
+                quint16 nameSize;
+                if (!input.readNumber(rawType) || rawType > static_cast<quint8>(TagType::LongArray))
+                    return false;
+                if (static_cast<TagType>(rawType) == TagType::End)
+                    return true;
+                if (!input.readNumber(nameSize) || !input.skip(nameSize) || !skipPayload(input, static_cast<TagType>(rawType), depth + 1))
+                    return false;
+            }
+        }
+        case TagType::End:
+            // only valid as the type of empty lists
+            return true;
+        default:
+            return false;
+    }
+}
+
+const NbtFieldReader::Field* NbtFieldReader::field(const QByteArray& path, TagType type) const
+{
+    auto it = m_fields.constFind(path);
+    if (it == m_fields.constEnd() || it->type != type)
+        return nullptr;
+    return &*it;
+}
+
+bool NbtFieldReader::hasCompound(const QByteArray& path) const
+{
+    return field(path, TagType::Compound) != nullptr;
+}
+
+std::optional<QString> NbtFieldReader::string(const QByteArray& path) const
+{
+    if (auto value = field(path, TagType::String))
+        return value->value.toString();
+    return std::nullopt;
+}
+
+std::optional<qint32> NbtFieldReader::intValue(const QByteArray& path) const
+{
+    if (auto value = field(path, TagType::Int))
+        return value->value.toInt();
+    return std::nullopt;
+}
+
+std::optional<qint64> NbtFieldReader::longValue(const QByteArray& path) const
+{
+    if (auto value = field(path, TagType::Long))
+        return value->value.toLongLong();
+    return std::nullopt;
+}
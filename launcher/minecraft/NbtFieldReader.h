@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+
+#include <optional>
+
+/* NbtFieldReader
+ * Picks a few fields out of an NBT file, like level.dat, without building its tag tree.
+ *
+ * Fields are addressed by dotted paths from the root compound, for example "Data.WorldGenSettings.seed".
+ * The data is inflated in small chunks as it is read, compounds leading to a wanted field are descended into
+ * and everything else is skipped over without being allocated.
+ */
+class NbtFieldReader {
+   public:
+    enum class TagType : quint8 { End, Byte, Short, Int, Long, Float, Double, ByteArray, String, List, Compound, IntArray, LongArray };
+
+    explicit NbtFieldReader(const QList<QByteArray>& paths);
+
+    /// reads gzip compressed or uncompressed NBT data, false if it is malformed
+    bool read(const QByteArray& data);
+
+    /// whether the compound at path was found. only compounds that lead to a wanted field are tracked
+    bool hasCompound(const QByteArray& path) const;
+
+    std::optional<QString> string(const QByteArray& path) const;
+    std::optional<qint32> intValue(const QByteArray& path) const;
+    std::optional<qint64> longValue(const QByteArray& path) const;
+
+   private:
+    class Input;
+
+    struct Field {
+        TagType type = TagType::End;
+        QVariant value;
+    };
+
+    bool readCompound(Input& input, const QByteArray& path, int depth);
+    bool readField(Input& input, TagType type, const QByteArray& path, int depth);
+    bool skipPayload(Input& input, TagType type, int depth);
+    const Field* field(const QByteArray& path, TagType type) const;
+
+   private:
+    QSet<QByteArray> m_wanted;
+    QSet<QByteArray> m_prefixes;
+    QHash<QByteArray, Field> m_fields;
+};
@@ -57,9 +57,7 @@
 
 #include "FileSystem.h"
 #include "PSaveFile.h"
-
-using std::nullopt;
-using std::optional;
+#include "minecraft/NbtFieldReader.h"
 
 GameType::GameType(std::optional<int> original) : original(original)
 {
@@ -198,7 +196,7 @@ bool putLevelDatDataToFS(const QFileInfo& file, QByteArray& data)
     return f.commit();
 }
 
-int64_t calculateWorldSize(const QFileInfo& file)
+int64_t World::calculateSize(const QFileInfo& file, const std::atomic<bool>* stop)
 {
     if (file.isFile() && file.suffix() == "zip") {
         return file.size();
@@ -206,6 +204,8 @@ int64_t calculateWorldSize(const QFileInfo& file)
         QDirIterator it(file.absoluteFilePath(), QDir::Files, QDirIterator::Subdirectories);
         int64_t total = 0;
         while (it.hasNext()) {
+            if (stop && *stop)
+                return -1;
             it.next();
             total += it.fileInfo().size();
         }
@@ -223,7 +223,7 @@ void World::repath(const QFileInfo& file)
 {
     m_containerFile = file;
     m_folderName = file.fileName();
-    m_size = calculateWorldSize(file);
+    m_size = -1;
     if (file.isFile() && file.suffix() == "zip") {
         m_iconFile = QString();
         readFromZip(file);
@@ -357,113 +357,34 @@ bool World::rename(const QString& newName)
     return true;
 }
 
-namespace {
-
-optional<QString> read_string(nbt::value& parent, const char* name)
-{
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::String) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_string>();
-        return QString::fromStdString(tag_str.get());
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "String NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to string.";
-        return nullopt;
-    }
-}
-
-optional<int64_t> read_long(nbt::value& parent, const char* name)
-{
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Long) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_long>();
-        return tag_str.get();
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Long NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to long.";
-        return nullopt;
-    }
-}
-
-optional<int> read_int(nbt::value& parent, const char* name)
-{
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Int) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_int>();
-        return tag_str.get();
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Int NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to int.";
-        return nullopt;
-    }
-}
-
-GameType read_gametype(nbt::value& parent, const char* name)
-{
-    return GameType(read_int(parent, name));
-}
-
-}  // namespace
-
 void World::loadFromLevelDat(QByteArray data)
 {
-    auto levelData = parseLevelDat(data);
-    if (!levelData) {
+    // modded level.dat files can carry huge registries, only the few fields shown are read out of it
+    NbtFieldReader reader({ "Data.LevelName", "Data.LastPlayed", "Data.GameType", "Data.WorldGenSettings.seed", "Data.RandomSeed" });
+    if (!reader.read(data)) {
+        qWarning() << "Unable to parse level.dat of" << m_folderName;
         is_valid = false;
         return;
     }
 
-    nbt::value* valPtr = nullptr;
-    try {
-        valPtr = &levelData->at("Data");
-    } catch (const std::out_of_range& e) {
-        qWarning() << "Unable to read NBT tags from " << m_folderName << ":" << e.what();
-        is_valid = false;
+    is_valid = reader.hasCompound("Data");
+    if (!is_valid) {
+        qWarning() << "Unable to read NBT tags from" << m_folderName << ": no Data compound";
         return;
     }
-    nbt::value& val = *valPtr;
-
-    is_valid = val.get_type() == nbt::tag_type::Compound;
-    if (!is_valid)
-        return;
 
-    auto name = read_string(val, "LevelName");
+    auto name = reader.string("Data.LevelName");
     m_actualName = name ? *name : m_folderName;
 
-    auto timestamp = read_long(val, "LastPlayed");
+    auto timestamp = reader.longValue("Data.LastPlayed");
     m_lastPlayed = timestamp ? QDateTime::fromMSecsSinceEpoch(*timestamp) : levelDatTime;
 
-    m_gameType = read_gametype(val, "GameType");
+    m_gameType = GameType(reader.intValue("Data.GameType"));
 
-    optional<int64_t> randomSeed;
-    try {
-        auto& WorldGen_val = val.at("WorldGenSettings");
-        randomSeed = read_long(WorldGen_val, "seed");
-    } catch (const std::out_of_range&) {
-    }
+    // newer versions moved the seed into the world generation settings
+    auto randomSeed = reader.longValue("Data.WorldGenSettings.seed");
     if (!randomSeed) {
-        randomSeed = read_long(val, "RandomSeed");
+        randomSeed = reader.longValue("Data.RandomSeed");
     }
     m_randomSeed = randomSeed ? *randomSeed : 0;
 
@@ -472,7 +393,6 @@ void World::loadFromLevelDat(QByteArray data)
     if (randomSeed) {
         qDebug() << "Seed:" << *randomSeed;
     }
-    qDebug() << "Size:" << m_size;
     qDebug() << "GameType:" << m_gameType.toLogString();
 }
 
@@ -16,6 +16,7 @@
 #pragma once
 #include <QDateTime>
 #include <QFileInfo>
+#include <atomic>
 #include <optional>
 
 struct GameType {
@@ -35,7 +36,9 @@ class World {
     QString folderName() const { return m_folderName; }
     QString name() const { return m_actualName; }
     QString iconFile() const { return m_iconFile; }
+    /// size on disk, -1 until it is calculated
     int64_t bytes() const { return m_size; }
+    void setBytes(int64_t bytes) { m_size = bytes; }
     QDateTime lastPlayed() const { return m_lastPlayed; }
     GameType gameType() const { return m_gameType; }
     int64_t seed() const { return m_randomSeed; }
@@ -72,6 +75,9 @@ class World {
 
     QString canonicalFilePath() const { return m_containerFile.canonicalFilePath(); }
 
+    /// walks the whole world, which can take a while for big ones. gives up with -1 as soon as \p stop is set
+    static int64_t calculateSize(const QFileInfo& file, const std::atomic<bool>* stop = nullptr);
+
    private:
     void readFromZip(const QFileInfo& file);
     void readFromFS(const QFileInfo& file);
@@ -85,7 +91,7 @@ class World {
     QString m_iconFile;
     QDateTime levelDatTime;
     QDateTime m_lastPlayed;
-    int64_t m_size;
+    int64_t m_size = -1;
     int64_t m_randomSeed = 0;
     GameType m_gameType;
     bool is_valid = false;
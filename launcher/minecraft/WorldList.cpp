@@ -36,15 +36,48 @@
 #include "WorldList.h"
 
 #include <FileSystem.h>
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QDirIterator>
 #include <QFileSystemWatcher>
 #include <QMimeData>
+#include <QMutexLocker>
 #include <QString>
 #include <QUrl>
 #include <QUuid>
 #include <Qt>
+#include <QtConcurrentRun>
 #include "Application.h"
 
+namespace {
+// Minecraft rewrites level.dat whenever it saves the world, a zipped world can only change as a whole
+FS::FileFingerprint worldStamp(const QFileInfo& world)
+{
+    if (world.isFile())
+        return FS::fingerprint(world);
+    return FS::fingerprint(QFileInfo(QDir(world.absoluteFilePath()).filePath("level.dat")));
+}
+
+// files get added to region folders as the world grows, and level.dat is saved along with any chunk. empty once \p stop is set
+QByteArray worldSizeKey(const QFileInfo& world, const std::atomic<bool>& stop)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    auto stamp = worldStamp(world);
+    hash.addData(QByteArray::number(stamp.size));
+    hash.addData(QByteArray::number(stamp.modified));
+    hash.addData(QByteArray::number(world.lastModified().toMSecsSinceEpoch()));
+    QDirIterator it(world.absoluteFilePath(), QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        if (stop)
+            return {};
+        it.next();
+        hash.addData(it.filePath().toUtf8());
+        hash.addData(QByteArray::number(it.fileInfo().lastModified().toMSecsSinceEpoch()));
+    }
+    return hash.result();
+}
+}  // namespace
+
 WorldList::WorldList(const QString& dir, BaseInstance* instance) : QAbstractListModel(), m_instance(instance), m_dir(dir)
 {
     FS::ensureFolderPathExists(m_dir.absolutePath());
@@ -53,6 +86,17 @@ WorldList::WorldList(const QString& dir, BaseInstance* instance) : QAbstractList
     m_watcher = new QFileSystemWatcher(this);
     is_watching = false;
     connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &WorldList::directoryChanged);
+    m_scanPool.setMaxThreadCount(1);
+    m_sizePool.setMaxThreadCount(1);
+}
+
+WorldList::~WorldList()
+{
+    m_stopping = true;
+    m_scanPool.clear();
+    m_sizePool.clear();
+    m_scanPool.waitForDone();
+    m_sizePool.waitForDone();
 }
 
 void WorldList::startWatching()
@@ -87,23 +131,146 @@ bool WorldList::update()
     if (!isValid())
         return false;
 
-    QList<World> newWorlds;
-    m_dir.refresh();
-    auto folderContents = m_dir.entryInfoList();
-    // if there are any untracked files...
-    for (QFileInfo entry : folderContents) {
-        if (!entry.isDir())
+    int generation = ++m_generation;
+    auto dir = m_dir;
+    auto stamps = m_stamps;
+    QtConcurrent::run(&m_scanPool, [this, generation, dir, stamps]() mutable {
+        dir.refresh();
+        ScanResult done;
+        done.generation = generation;
+        done.done = true;
+        for (auto& entry : dir.entryInfoList()) {
+            // a newer scan is queued, no point in finishing this one
+            if (m_stopping || generation != m_generation)
+                return;
+            if (!entry.isDir())
+                continue;
+
+            ScanResult result;
+            result.generation = generation;
+            result.folderName = entry.fileName();
+            result.stamp = worldStamp(entry);
+            done.seen.insert(result.folderName);
+            if (auto known = stamps.constFind(result.folderName); known != stamps.constEnd() && *known == result.stamp)
+                continue;
+
+            World world(entry);
+            if (world.isValid())
+                result.world = world;
+            queueScanResult(std::move(result));
+        }
+        queueScanResult(std::move(done));
+    });
+    return true;
+}
+
+void WorldList::waitForUpdate()
+{
+    m_scanPool.waitForDone();
+    applyScanResults();
+}
+
+void WorldList::queueScanResult(ScanResult&& result)
+{
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending.append(std::move(result));
+    if (m_applyQueued)
+        return;
+    m_applyQueued = true;
+    QMetaObject::invokeMethod(this, &WorldList::applyScanResults, Qt::QueuedConnection);
+}
+
+void WorldList::applyScanResults()
+{
+    QList<ScanResult> results;
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        results.swap(m_pending);
+        m_applyQueued = false;
+    }
+
+    auto removeRow = [this](int row) {
+        m_stamps.remove(worlds[row].folderName());
+        beginRemoveRows(QModelIndex(), row, row);
+        worlds.removeAt(row);
+        endRemoveRows();
+    };
+
+    for (auto& result : results) {
+        if (result.generation != m_generation)
             continue;
 
-        World w(entry);
-        if (w.isValid()) {
-            newWorlds.append(w);
+        if (result.done) {
+            for (int row = worlds.size() - 1; row >= 0; row--) {
+                if (!result.seen.contains(worlds[row].folderName()))
+                    removeRow(row);
+            }
+            continue;
+        }
+
+        int row = findWorld(result.folderName);
+        if (!result.world) {
+            m_stamps.remove(result.folderName);
+            if (row >= 0)
+                removeRow(row);
+            continue;
+        }
+
+        m_stamps.insert(result.folderName, result.stamp);
+        if (row >= 0) {
+            worlds[row] = *result.world;
+            emit dataChanged(index(row, 0), index(row, columnCount(QModelIndex()) - 1));
+        } else {
+            beginInsertRows(QModelIndex(), worlds.size(), worlds.size());
+            worlds.append(*result.world);
+            endInsertRows();
         }
     }
-    beginResetModel();
-    worlds.swap(newWorlds);
-    endResetModel();
-    return true;
+}
+
+int WorldList::findWorld(const QString& folderName) const
+{
+    for (int row = 0; row < worlds.size(); row++) {
+        if (worlds[row].folderName() == folderName)
+            return row;
+    }
+    return -1;
+}
+
+void WorldList::requestSize(int row)
+{
+    if (row < 0 || row >= worlds.size() || worlds[row].bytes() >= 0)
+        return;
+    auto folderName = worlds[row].folderName();
+    if (m_sizeRequests.contains(folderName))
+        return;
+    m_sizeRequests.insert(folderName);
+
+    QtConcurrent::run(&m_sizePool, [this, folderName, container = worlds[row].container()] {
+        auto key = worldSizeKey(container, m_stopping);
+        // the list is going away, the walk is not worth finishing
+        if (m_stopping)
+            return;
+        auto& cached = m_sizes[folderName];
+        if (cached.key != key || cached.bytes < 0) {
+            cached.key = key;
+            cached.bytes = World::calculateSize(container, &m_stopping);
+        }
+        if (m_stopping)
+            return;
+        QMetaObject::invokeMethod(this, [this, folderName, bytes = cached.bytes] { applySize(folderName, bytes); }, Qt::QueuedConnection);
+    });
+}
+
+void WorldList::applySize(const QString& folderName, int64_t bytes)
+{
+    m_sizeRequests.remove(folderName);
+    int row = findWorld(folderName);
+    // nothing to report if the world couldn't be measured
+    if (row < 0 || bytes < 0)
+        return;
+    worlds[row].setBytes(bytes);
+    emit dataChanged(index(row, SizeColumn), index(row, SizeColumn));
 }
 
 void WorldList::directoryChanged(QString path)
@@ -127,6 +294,7 @@ bool WorldList::deleteWorld(int index)
         return false;
     World& m = worlds[index];
     if (m.destroy()) {
+        m_stamps.remove(m.folderName());
         beginRemoveRows(QModelIndex(), index, index);
         worlds.removeAt(index);
         endRemoveRows();
@@ -141,6 +309,7 @@ bool WorldList::deleteWorlds(int first, int last)
     for (int i = first; i <= last; i++) {
         World& m = worlds[i];
         m.destroy();
+        m_stamps.remove(m.folderName());
     }
     beginRemoveRows(QModelIndex(), first, last);
     worlds.erase(worlds.begin() + first, worlds.begin() + last + 1);
@@ -193,6 +362,8 @@ QVariant WorldList::data(const QModelIndex& index, int role) const
                     return world.lastPlayed();
 
                 case SizeColumn:
+                    if (world.bytes() < 0)
+                        return tr("Calculating...");
                     return locale.formattedDataSize(world.bytes());
 
                 case InfoColumn:
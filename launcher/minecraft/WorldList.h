@@ -17,10 +17,17 @@
 
 #include <QAbstractListModel>
 #include <QDir>
+#include <QHash>
 #include <QList>
 #include <QMimeData>
+#include <QMutex>
+#include <QSet>
 #include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <optional>
 #include "BaseInstance.h"
+#include "FileSystem.h"
 #include "minecraft/World.h"
 
 class QFileSystemWatcher;
@@ -33,6 +40,7 @@ class WorldList : public QAbstractListModel {
     enum Roles { ObjectRole = Qt::UserRole + 1, FolderRole, SeedRole, NameRole, GameModeRole, LastPlayedRole, SizeRole, IconFileRole };
 
     WorldList(const QString& dir, BaseInstance* instance);
+    virtual ~WorldList();
 
     virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
 
@@ -44,8 +52,13 @@ class WorldList : public QAbstractListModel {
     bool empty() const { return size() == 0; }
     World& operator[](size_t index) { return worlds[index]; }
 
-    /// Reloads the mod list and returns true if the list changed.
+    /**
+     * Rescans the worlds folder in the background, returns false if it can't be scanned.
+     * Worlds are added to the model as they are found, only the ones whose level.dat changed get parsed again.
+     */
     virtual bool update();
+    /// Blocks until the running scan is done and its results are in the model.
+    void waitForUpdate();
 
     /// Install a world from location
     void installWorld(QFileInfo filename);
@@ -84,16 +97,59 @@ class WorldList : public QAbstractListModel {
 
     const QList<World>& allWorlds() const { return worlds; }
 
+   public slots:
+    /// Calculates the size of the world in the background, the model reports it once it is known.
+    /// Meant to be called by whatever shows the sizes, so they are only calculated when they are needed.
+    void requestSize(int row);
+
    private slots:
     void directoryChanged(QString path);
 
    signals:
     void changed();
 
+   private:
+    struct ScanResult {
+        int generation = 0;
+        QString folderName;
+        FS::FileFingerprint stamp;
+        /// the parsed world, empty if it isn't valid
+        std::optional<World> world;
+        /// the last result of a scan, carrying every folder that was seen
+        bool done = false;
+        QSet<QString> seen;
+    };
+
+    int findWorld(const QString& folderName) const;
+    void queueScanResult(ScanResult&& result);
+    void applyScanResults();
+    void applySize(const QString& folderName, int64_t bytes);
+
    protected:
     BaseInstance* m_instance;
     QFileSystemWatcher* m_watcher;
     bool is_watching;
     QDir m_dir;
     QList<World> worlds;
+
+   private:
+    // both run a single thread, so scans don't overlap and big worlds are not walked in parallel
+    QThreadPool m_scanPool;
+    QThreadPool m_sizePool;
+    std::atomic<bool> m_stopping = false;
+    std::atomic<int> m_generation = 0;
+    /// fingerprints of the level.dat files (or the zips) of the worlds in the model, to skip the unchanged ones
+    QHash<QString, FS::FileFingerprint> m_stamps;
+
+    QMutex m_pendingMutex;
+    QList<ScanResult> m_pending;
+    bool m_applyQueued = false;
+
+    struct SizeEntry {
+        QByteArray key;
+        int64_t bytes = -1;
+    };
+    /// world sizes, keyed by the modification times of the world's directories and level.dat. only used by the size thread
+    QHash<QString, SizeEntry> m_sizes;
+    QSet<QString> m_sizeRequests;
 };
@@ -19,9 +19,15 @@
 
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
+#include <QDateTime>
 #include <QDir>
+#include <QDebug>
+#include <QDirIterator>
+#include <QTemporaryDir>
+#include <QtConcurrent>
 #include "FileSystem.h"
 #include "MMCZip.h"
+#include "modplatform/helpers/HashUtils.h"
 
 #ifdef major
 #undef major
@@ -67,6 +73,98 @@ static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibH
     return true;
 }
 
+// extracts into a staging folder and moves it in place, so a half extracted entry is never used
+static bool populateCacheEntry(const QString& source, const QString& entry, bool applyJnilibHack)
+{
+    if (QFileInfo(entry).isDir()) {
+        return true;
+    }
+    QTemporaryDir staging(entry + "-XXXXXX");
+    if (!staging.isValid() || !unzipNatives(source, staging.path(), applyJnilibHack)) {
+        return false;
+    }
+    // another launch may have been faster, its entry is just as good
+    return QDir().rename(staging.path(), entry) || QFileInfo(entry).isDir();
+}
+
+// cache entries no launch used for a month are removed
+static const qint64 s_maxUnusedSecs = 30 * 24 * 60 * 60;
+
+// the modification time of the stamp next to an entry is when a launch used it last
+static void markUsed(const QString& entry)
+{
+    QFile stamp(entry + ".used");
+    if (stamp.open(QIODevice::WriteOnly)) {
+        stamp.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    }
+}
+
+static void removeUnusedEntries(const QString& cacheFolder)
+{
+    auto expired = QDateTime::currentDateTimeUtc().addSecs(-s_maxUnusedSecs);
+    // staging folders left behind by a crash have no stamp, they go once they are old enough
+    for (const auto& entry : QDir(cacheFolder).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QFileInfo stamp(entry.absoluteFilePath() + ".used");
+        auto lastUsed = stamp.exists() ? stamp.lastModified() : entry.lastModified();
+        if (lastUsed >= expired) {
+            continue;
+        }
+        qDebug() << "Removing unused natives cache entry" << entry.fileName();
+        if (QDir(entry.absoluteFilePath()).removeRecursively()) {
+            QFile::remove(stamp.absoluteFilePath());
+        }
+    }
+}
+
+static bool placeCacheEntry(const QString& entry, const QString& targetFolder)
+{
+    QDir entryDir(entry);
+    bool clone = FS::canClone(entry, targetFolder);
+    QDirIterator iter(entry, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (iter.hasNext()) {
+        auto src = iter.next();
+        auto dst = FS::PathCombine(targetFolder, entryDir.relativeFilePath(src));
+        // files of later jars replace the ones of earlier jars, same as when they were extracted over each other
+        if (!FS::ensureFilePathExists(dst) || (QFileInfo::exists(dst) && !QFile::remove(dst))) {
+            return false;
+        }
+        std::error_code ec;
+        if (clone && FS::clone_file(src, dst, ec)) {
+            continue;
+        }
+        // a hard link would let the game write through to the cache
+        if (!QFile::copy(src, dst)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * The extracted natives are kept in a cache keyed by the SHA-1 of the jar and whether the jnilib hack is applied,
+ * so every launch after the first one only has to clone or copy the files into the natives folder.
+ */
+static bool extractNatives(const QString& source, const QString& targetFolder, const QString& cacheFolder, bool applyJnilibHack)
+{
+    auto sha1 = Hashing::hash(source, Hashing::Algorithm::Sha1);
+    if (!sha1.isEmpty()) {
+        auto entry = FS::PathCombine(cacheFolder, applyJnilibHack ? sha1 + "-jnilib" : sha1);
+        if (populateCacheEntry(source, entry, applyJnilibHack)) {
+            markUsed(entry);
+            if (placeCacheEntry(entry, targetFolder)) {
+                return true;
+            }
+        }
+        qWarning() << "Couldn't use the natives cache for" << source << "extracting it directly";
+    }
+    return unzipNatives(source, targetFolder, applyJnilibHack);
+}
+
+ExtractNatives::ExtractNatives(LaunchTask* parent) : LaunchStep(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<QString>::finished, this, &ExtractNatives::extractFinished);
+}
+
 void ExtractNatives::executeTask()
 {
     auto instance = m_parent->instance();
@@ -75,18 +173,37 @@ void ExtractNatives::executeTask()
         emitSucceeded();
         return;
     }
-    auto settings = instance->settings();
 
-    auto outputPath = instance->getNativePath();
-    FS::ensureFolderPathExists(outputPath);
+    m_outputPath = instance->getNativePath();
     auto javaVersion = instance->getJavaVersion();
     bool jniHackEnabled = javaVersion.major() >= 8;
-    for (const auto& source : toExtract) {
-        if (!unzipNatives(source, outputPath, jniHackEnabled)) {
-            const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
-            emit logLine(QString(reason).arg(source, outputPath), MessageLevel::Fatal);
-            emitFailed(tr(reason).arg(source, outputPath));
+    auto cacheFolder = QDir("cache/natives").absolutePath();
+    // unzip on a worker thread, the launch steps that don't need the natives keep going meanwhile
+    m_future = QtConcurrent::run(QThreadPool::globalInstance(), [toExtract, outputPath = m_outputPath, cacheFolder, jniHackEnabled] {
+        FS::ensureFolderPathExists(outputPath);
+        FS::ensureFolderPathExists(cacheFolder);
+        QString failed;
+        for (const auto& source : toExtract) {
+            if (!extractNatives(source, outputPath, cacheFolder, jniHackEnabled)) {
+                failed = source;
+                break;
+            }
         }
+        // the entries of this launch were just marked as used, so they stay
+        removeUnusedEntries(cacheFolder);
+        return failed;
+    });
+    m_watcher.setFuture(m_future);
+}
+
+void ExtractNatives::extractFinished()
+{
+    auto source = m_future.result();
+    if (!source.isEmpty()) {
+        const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
+        emit logLine(QString(reason).arg(source, m_outputPath), MessageLevel::Fatal);
+        emitFailed(tr(reason).arg(source, m_outputPath));
+        return;
     }
     emitSucceeded();
 }
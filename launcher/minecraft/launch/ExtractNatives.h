@@ -17,14 +17,26 @@
 
 #include <launch/LaunchStep.h>
 
+#include <QFuture>
+#include <QFutureWatcher>
+
 // FIXME: temporary wrapper for existing task.
 class ExtractNatives : public LaunchStep {
     Q_OBJECT
    public:
-    explicit ExtractNatives(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit ExtractNatives(LaunchTask* parent);
     virtual ~ExtractNatives() {};
 
     void executeTask() override;
     bool canAbort() const override { return false; }
     void finalize() override;
+
+   private:
+    void extractFinished();
+
+   private:
+    QString m_outputPath;
+    // the jar that failed to extract, empty on success
+    QFuture<QString> m_future;
+    QFutureWatcher<QString> m_watcher;
 };
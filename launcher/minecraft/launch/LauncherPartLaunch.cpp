@@ -35,7 +35,6 @@
 
 #include "LauncherPartLaunch.h"
 
-#include <QRegularExpression>
 #include <QStandardPaths>
 
 #include "Application.h"
@@ -53,17 +52,23 @@ LauncherPartLaunch::LauncherPartLaunch(LaunchTask* parent)
     , m_process(parent->instance()->getJavaVersion().defaultsToUtf8() ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForLocale())
 {
     if (parent->instance()->settings()->get("CloseAfterLaunch").toBool()) {
+        // look at whole decoded lines, the raw output may split the marker or be in a multi-byte encoding
         std::shared_ptr<QMetaObject::Connection> connection{ new QMetaObject::Connection };
-        *connection = connect(
-            &m_process, &LoggedProcess::log, this, [connection](const QStringList& lines, [[maybe_unused]] MessageLevel::Enum level) {
-                qDebug() << lines;
-                if (lines.filter(QRegularExpression(".*Setting user.+", QRegularExpression::CaseInsensitiveOption)).length() != 0) {
+        *connection = connect(&parent->logPipeline(), &LogPipeline::linesReady, this, [connection](const QVector<LogModel::Line>& lines) {
+            for (auto& line : lines) {
+                if (line.level != MessageLevel::Launcher && line.text.contains("setting user", Qt::CaseInsensitive)) {
                     APPLICATION->closeAllWindows();
                     disconnect(*connection);
+                    return;
                 }
-            });
+            }
+        });
     }
 
+    // the game output is decoded and split into lines on the log pipeline thread of the launch
+    m_process.setRawOutput(true);
+    connect(&m_process, &LoggedProcess::output, this,
+            [this](const QByteArray& data, MessageLevel::Enum level) { emit logData(data, level, m_process.codec()); });
     connect(&m_process, &LoggedProcess::log, this, &LauncherPartLaunch::logLines);
     connect(&m_process, &LoggedProcess::stateChanged, this, &LauncherPartLaunch::on_state);
 }
@@ -39,6 +39,14 @@
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
+#include "minecraft/mod/Mod.h"
+
+#include <QtConcurrent>
+
+ModMinecraftJar::ModMinecraftJar(LaunchTask* parent) : LaunchStep(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<bool>::finished, this, &ModMinecraftJar::createFinished);
+}
 
 void ModMinecraftJar::executeTask()
 {
@@ -51,11 +59,13 @@ void ModMinecraftJar::executeTask()
     // nuke obsolete stripped jar(s) if needed
     if (!FS::ensureFolderPathExists(m_inst->binRoot())) {
         emitFailed(tr("Couldn't create the bin folder for Minecraft.jar"));
+        return;
     }
 
     auto finalJarPath = QDir(m_inst->binRoot()).absoluteFilePath("minecraft.jar");
     if (!removeJar()) {
         emitFailed(tr("Couldn't remove stale jar file: %1").arg(finalJarPath));
+        return;
     }
 
     // create temporary modded jar, if needed
@@ -67,10 +77,21 @@ void ModMinecraftJar::executeTask()
         QStringList jars, temp1, temp2, temp3, temp4;
         mainJar->getApplicableFiles(m_inst->runtimeContext(), jars, temp1, temp2, temp3, m_inst->getLocalLibraryPath());
         auto sourceJarPath = jars[0];
-        if (!MMCZip::createModdedJar(sourceJarPath, finalJarPath, jarMods)) {
-            emitFailed(tr("Failed to create the custom Minecraft jar file."));
-            return;
-        }
+        // the jar is written on a worker thread, the launch steps that don't need it keep going meanwhile
+        m_future = QtConcurrent::run(QThreadPool::globalInstance(), [sourceJarPath, finalJarPath, jarMods] {
+            return MMCZip::createCachedModdedJar(sourceJarPath, finalJarPath, jarMods);
+        });
+        m_watcher.setFuture(m_future);
+        return;
+    }
+    emitSucceeded();
+}
+
+void ModMinecraftJar::createFinished()
+{
+    if (!m_future.result()) {
+        emitFailed(tr("Failed to create the custom Minecraft jar file."));
+        return;
     }
     emitSucceeded();
 }
@@ -16,12 +16,14 @@
 #pragma once
 
 #include <launch/LaunchStep.h>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <memory>
 
 class ModMinecraftJar : public LaunchStep {
     Q_OBJECT
    public:
-    explicit ModMinecraftJar(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit ModMinecraftJar(LaunchTask* parent);
     virtual ~ModMinecraftJar() {};
 
     virtual void executeTask() override;
@@ -30,4 +32,9 @@ class ModMinecraftJar : public LaunchStep {
 
    private:
     bool removeJar();
+    void createFinished();
+
+   private:
+    QFuture<bool> m_future;
+    QFutureWatcher<bool> m_watcher;
 };
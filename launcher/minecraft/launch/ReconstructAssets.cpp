@@ -19,6 +19,13 @@
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
 
+#include <QtConcurrent>
+
+ReconstructAssets::ReconstructAssets(LaunchTask* parent) : LaunchStep(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<bool>::finished, this, &ReconstructAssets::reconstructFinished);
+}
+
 void ReconstructAssets::executeTask()
 {
     auto instance = m_parent->instance();
@@ -26,7 +33,13 @@ void ReconstructAssets::executeTask()
     auto profile = components->getProfile();
     auto assets = profile->getMinecraftAssets();
 
-    if (!AssetsUtils::reconstructAssets(assets->id, instance->resourcesDir())) {
+    m_future = QtConcurrent::run(QThreadPool::globalInstance(), AssetsUtils::reconstructAssets, assets->id, instance->resourcesDir());
+    m_watcher.setFuture(m_future);
+}
+
+void ReconstructAssets::reconstructFinished()
+{
+    if (!m_future.result()) {
         emit logLine("Failed to reconstruct Minecraft assets.", MessageLevel::Error);
     }
 
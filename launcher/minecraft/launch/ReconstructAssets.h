@@ -16,14 +16,23 @@
 #pragma once
 
 #include <launch/LaunchStep.h>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <memory>
 
 class ReconstructAssets : public LaunchStep {
     Q_OBJECT
    public:
-    explicit ReconstructAssets(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit ReconstructAssets(LaunchTask* parent);
     virtual ~ReconstructAssets() {};
 
     void executeTask() override;
     bool canAbort() const override { return false; }
+
+   private:
+    void reconstructFinished();
+
+   private:
+    QFuture<bool> m_future;
+    QFutureWatcher<bool> m_watcher;
 };
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ModDetailsCache.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+namespace {
+// bump this whenever the mod parsers change what they extract, so stale details get parsed again
+constexpr int s_formatVersion = 1;
+constexpr int s_saveThreshold = 64;
+
+QJsonObject detailsToJson(const ModDetails& details)
+{
+    QJsonObject obj;
+    obj.insert("mod_id", details.mod_id);
+    obj.insert("name", details.name);
+    obj.insert("version", details.version);
+    obj.insert("mcversion", details.mcversion);
+    obj.insert("homeurl", details.homeurl);
+    obj.insert("description", details.description);
+    obj.insert("authors", QJsonArray::fromStringList(details.authors));
+    obj.insert("issue_tracker", details.issue_tracker);
+    QJsonArray licenses;
+    for (auto& license : details.licenses) {
+        QJsonObject licenseObj;
+        licenseObj.insert("name", license.name);
+        licenseObj.insert("id", license.id);
+        licenseObj.insert("url", license.url);
+        licenseObj.insert("description", license.description);
+        licenses.append(licenseObj);
+    }
+    obj.insert("licenses", licenses);
+    obj.insert("icon_file", details.icon_file);
+    return obj;
+}
+
+ModDetails detailsFromJson(const QJsonObject& obj)
+{
+    ModDetails details;
+    details.mod_id = Json::ensureString(obj, "mod_id");
+    details.name = Json::ensureString(obj, "name");
+    details.version = Json::ensureString(obj, "version");
+    details.mcversion = Json::ensureString(obj, "mcversion");
+    details.homeurl = Json::ensureString(obj, "homeurl");
+    details.description = Json::ensureString(obj, "description");
+    for (auto author : Json::ensureArray(obj, "authors"))
+        details.authors.append(author.toString());
+    details.issue_tracker = Json::ensureString(obj, "issue_tracker");
+    for (auto value : Json::ensureArray(obj, "licenses")) {
+        auto licenseObj = Json::ensureObject(value);
+        details.licenses.append(ModLicense(Json::ensureString(licenseObj, "name"), Json::ensureString(licenseObj, "id"),
+                                           Json::ensureString(licenseObj, "url"), Json::ensureString(licenseObj, "description")));
+    }
+    details.icon_file = Json::ensureString(obj, "icon_file");
+    return details;
+}
+}  // namespace
+
+ModDetailsCache::ModDetailsCache(QString file)
+    : m_cache({ file, "mod details cache", s_formatVersion, s_saveThreshold }, detailsToJson, detailsFromJson)
+{}
+
+std::optional<ModDetails> ModDetailsCache::find(const QFileInfo& file)
+{
+    // the caller's file info may hold stale stat data
+    QFileInfo info(file.absoluteFilePath());
+    return m_cache.find(info.absoluteFilePath(), FS::fingerprint(info));
+}
+
+void ModDetailsCache::insert(const QFileInfo& file, const ModDetails& details)
+{
+    QFileInfo info(file.absoluteFilePath());
+    m_cache.insert(info.absoluteFilePath(), FS::fingerprint(info), details);
+}
+
+void ModDetailsCache::save()
+{
+    m_cache.save();
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFileInfo>
+#include <QString>
+
+#include <optional>
+
+#include "FingerprintCache.h"
+#include "minecraft/mod/ModDetails.h"
+
+/* ModDetailsCache
+ * Metadata parsed out of mod files, so unchanged jars don't have to be opened again every time a mod folder is loaded.
+ *
+ * Entries are keyed by the absolute path. Folder mods are not cached, as their contents can change without the folder itself
+ * changing.
+ */
+class ModDetailsCache {
+   public:
+    explicit ModDetailsCache(QString file);
+
+    /// details of the mod file, if they were cached and the file didn't change since
+    std::optional<ModDetails> find(const QFileInfo& file);
+    /// remembers the details parsed out of the mod file in its current state
+    void insert(const QFileInfo& file, const ModDetails& details);
+
+    void save();
+
+   private:
+    FingerprintCache<ModDetails> m_cache;
+};
@@ -239,8 +239,12 @@ void ModFolderModel::onParseSucceeded(int ticket, QString mod_id)
     auto resource = find(mod_id);
 
     auto result = cast_task->result();
-    if (result && resource)
-        static_cast<Mod*>(resource.get())->finishResolvingWithDetails(std::move(result->details));
+    if (result && resource) {
+        auto mod = static_cast<Mod*>(resource.get());
+        mod->finishResolvingWithDetails(std::move(result->details));
+        if (!result->icon.isNull())
+            mod->setIcon(result->icon);
+    }
 
     emit dataChanged(index(row), index(row, columnCount(QModelIndex()) - 1));
 }
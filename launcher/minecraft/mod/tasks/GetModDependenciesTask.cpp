@@ -21,6 +21,7 @@
 #include <QDebug>
 #include <algorithm>
 #include <memory>
+#include "Application.h"
 #include "Json.h"
 #include "QObjectPtr.h"
 #include "minecraft/PackProfile.h"
@@ -29,7 +30,6 @@
 #include "modplatform/ResourceAPI.h"
 #include "modplatform/flame/FlameAPI.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
-#include "tasks/SequentialTask.h"
 #include "ui/pages/modplatform/ModModel.h"
 #include "ui/pages/modplatform/flame/FlameResourceModels.h"
 #include "ui/pages/modplatform/modrinth/ModrinthResourceModels.h"
@@ -55,14 +55,14 @@ static bool checkDependencies(std::shared_ptr<GetModDependenciesTask::PackDepend
 GetModDependenciesTask::GetModDependenciesTask(BaseInstance* instance,
                                                ModFolderModel* folder,
                                                QList<std::shared_ptr<PackDependency>> selected)
-    : SequentialTask(tr("Get dependencies"))
-    , m_selected(selected)
-    , m_flame_provider{ ModPlatform::ResourceProvider::FLAME, std::make_shared<ResourceDownload::FlameModModel>(*instance),
-                        std::make_shared<FlameAPI>() }
-    , m_modrinth_provider{ ModPlatform::ResourceProvider::MODRINTH, std::make_shared<ResourceDownload::ModrinthModModel>(*instance),
-                           std::make_shared<ModrinthAPI>() }
-    , m_version(mcVersion(instance))
-    , m_loaderType(mcLoaders(instance))
+    : GetModDependenciesTask(selected,
+                             { ModPlatform::ResourceProvider::FLAME, std::make_shared<ResourceDownload::FlameModModel>(*instance),
+                               std::make_shared<FlameAPI>() },
+                             { ModPlatform::ResourceProvider::MODRINTH, std::make_shared<ResourceDownload::ModrinthModModel>(*instance),
+                               std::make_shared<ModrinthAPI>() },
+                             mcVersion(instance),
+                             mcLoaders(instance),
+                             APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt())
 {
     for (auto mod : folder->allMods()) {
         m_mods_file_names << mod->fileinfo().fileName();
@@ -72,16 +72,56 @@ GetModDependenciesTask::GetModDependenciesTask(BaseInstance* instance,
     prepare();
 }
 
+GetModDependenciesTask::GetModDependenciesTask(QList<std::shared_ptr<PackDependency>> selected,
+                                               Provider flame,
+                                               Provider modrinth,
+                                               Version version,
+                                               ModPlatform::ModLoaderTypes loaders,
+                                               int maxConcurrent)
+    : ConcurrentTask(tr("Get dependencies"), maxConcurrent)
+    , m_selected(selected)
+    , m_flame_provider(flame)
+    , m_modrinth_provider(modrinth)
+    , m_version(version)
+    , m_loaderType(loaders)
+{}
+
 void GetModDependenciesTask::prepare()
 {
     for (auto sel : m_selected) {
         if (checkDependencies(sel, m_version, m_loaderType))
             for (auto dep : getDependenciesForVersion(sel->version, sel->pack->provider)) {
-                addTask(prepareDependencyTask(dep, sel->pack->provider, 20));
+                addDependency(dep, sel->pack->provider, 20);
             }
     }
 }
 
+void GetModDependenciesTask::executeNextSubTask()
+{
+    // the project info is only needed for the dependencies that are left once everything is resolved
+    if (isRunning() && m_queue.isEmpty() && m_doing.isEmpty() && !m_projectInfoRequested) {
+        m_projectInfoRequested = true;
+        for (auto provider : { m_flame_provider, m_modrinth_provider }) {
+            if (auto task = getProjectInfoTask(provider))
+                addTask(task);
+        }
+    }
+    ConcurrentTask::executeNextSubTask();
+}
+
+void GetModDependenciesTask::addDependency(const ModPlatform::Dependency& dep, ModPlatform::ResourceProvider providerName, int level)
+{
+    // shared dependencies (e.g. Fabric API) are required by many mods, but are the same for all of them
+    auto project = dep.addonId.toString().isEmpty() ? "version:" + dep.version : dep.addonId.toString();
+    auto key = QString("%1:%2:%3:%4")
+                   .arg(QString(ModPlatform::ProviderCapabilities::name(providerName)), project,
+                        QString::number(static_cast<int>(m_loaderType)), m_version.toString());
+    if (m_requested.contains(key))
+        return;
+    m_requested.insert(key);
+    addTask(prepareDependencyTask(dep, providerName, level));
+}
+
 ModPlatform::Dependency GetModDependenciesTask::getOverride(const ModPlatform::Dependency& dep,
                                                             const ModPlatform::ResourceProvider providerName)
 {
@@ -142,30 +182,64 @@ QList<ModPlatform::Dependency> GetModDependenciesTask::getDependenciesForVersion
     return c_dependencies;
 }
 
-Task::Ptr GetModDependenciesTask::getProjectInfoTask(std::shared_ptr<PackDependency> pDep)
+Task::Ptr GetModDependenciesTask::getProjectInfoTask(const Provider& provider)
 {
-    auto provider = pDep->pack->provider == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
+    // several dependencies can point at the same project, e.g. different versions of it, and each has its own pack to fill in
+    QHash<QString, QList<std::shared_ptr<PackDependency>>> pending;
+    for (auto& pDep : m_pack_dependencies) {
+        if (pDep->pack->provider == provider.name && !pDep->pack->addonId.toString().isEmpty())
+            pending[pDep->pack->addonId.toString()].append(pDep);
+    }
+    if (pending.isEmpty())
+        return nullptr;
+
     auto responseInfo = std::make_shared<QByteArray>();
-    auto info = provider.api->getProject(pDep->pack->addonId.toString(), responseInfo);
-    QObject::connect(info.get(), &NetJob::succeeded, [this, responseInfo, provider, pDep] {
+    auto single = pending.size() == 1;
+    auto info = single ? provider.api->getProject(pending.constBegin().key(), responseInfo)
+                       : provider.api->getProjects(pending.keys(), responseInfo);
+    QObject::connect(info.get(), &Task::succeeded, [this, responseInfo, provider, pending, single] {
+        auto removeAll = [this, &pending] {
+            for (auto& deps : pending)
+                removePack(deps.constFirst()->pack->addonId);
+        };
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*responseInfo, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
-            removePack(pDep->pack->addonId);
+            removeAll();
             qWarning() << "Error while parsing JSON response for mod info at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qDebug() << *responseInfo;
             return;
         }
+        auto isFlame = provider.name == ModPlatform::ResourceProvider::FLAME;
+        QJsonArray entries;
         try {
-            auto obj = provider.name == ModPlatform::ResourceProvider::FLAME ? Json::requireObject(Json::requireObject(doc), "data")
-                                                                             : Json::requireObject(doc);
-            provider.mod->loadIndexedPack(*pDep->pack, obj);
+            if (single)
+                entries = { isFlame ? Json::requireObject(Json::requireObject(doc), "data") : Json::requireObject(doc) };
+            else
+                entries = isFlame ? Json::requireArray(Json::requireObject(doc), "data") : Json::requireArray(doc);
         } catch (const JSONValidationError& e) {
-            removePack(pDep->pack->addonId);
+            removeAll();
             qDebug() << doc;
             qWarning() << "Error while reading mod info: " << e.cause();
+            return;
+        }
+
+        auto missing = pending;
+        for (auto entry : entries) {
+            try {
+                auto obj = Json::requireObject(entry);
+                auto id = isFlame ? QString::number(Json::requireInteger(obj, "id")) : Json::requireString(obj, "id");
+                for (auto& pDep : missing.take(id))
+                    provider.mod->loadIndexedPack(*pDep->pack, obj);
+            } catch (const JSONValidationError& e) {
+                qDebug() << entry;
+                qWarning() << "Error while reading mod info: " << e.cause();
+            }
         }
+        // the ones that failed or weren't in the response
+        for (auto& deps : missing)
+            removePack(deps.constFirst()->pack->addonId);
     });
     return info;
 }
@@ -183,13 +257,6 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
     m_pack_dependencies.append(pDep);
     auto provider = providerName == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
 
-    auto tasks = makeShared<SequentialTask>(
-        QString("DependencyInfo: %1").arg(dep.addonId.toString().isEmpty() ? dep.version : dep.addonId.toString()));
-
-    if (!dep.addonId.toString().isEmpty()) {
-        tasks->addTask(getProjectInfoTask(pDep));
-    }
-
     ResourceAPI::DependencySearchArgs args = { dep, m_version, m_loaderType };
     ResourceAPI::DependencySearchCallbacks callbacks;
     callbacks.on_fail = [](QString reason, int) {
@@ -211,7 +278,7 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
                                              [dep, provider](auto o) { return o.provider == provider.name && dep.addonId == o.quilt; });
                     if (over != overide.cend()) {
                         removePack(dep.addonId);
-                        addTask(prepareDependencyTask({ over->fabric, dep.type }, provider.name, level));
+                        addDependency({ over->fabric, dep.type }, provider.name, level);
                         return;
                     }
                 }
@@ -238,11 +305,10 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
         if (dep.addonId.toString().isEmpty() && !pDep->version.addonId.toString().isEmpty()) {
             pDep->pack->addonId = pDep->version.addonId;
             auto dep_ = getOverride({ pDep->version.addonId, pDep->dependency.type }, provider.name);
+            // the project info is fetched together with all the others at the end
             if (dep_.addonId != pDep->version.addonId) {
                 removePack(pDep->version.addonId);
-                addTask(prepareDependencyTask(dep_, provider.name, level));
-            } else {
-                addTask(getProjectInfoTask(pDep));
+                addDependency(dep_, provider.name, level);
             }
         }
         if (isLocalyInstalled(pDep)) {
@@ -250,13 +316,11 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
             return;
         }
         for (auto dep_ : getDependenciesForVersion(pDep->version, provider.name)) {
-            addTask(prepareDependencyTask(dep_, provider.name, level - 1));
+            addDependency(dep_, provider.name, level - 1);
         }
     };
 
-    auto version = provider.api->getDependencyVersion(std::move(args), std::move(callbacks));
-    tasks->addTask(version);
-    return tasks;
+    return provider.api->getDependencyVersion(std::move(args), std::move(callbacks));
 }
 
 void GetModDependenciesTask::removePack(const QVariant& addonId)
@@ -20,6 +20,7 @@
 
 #include <QDir>
 #include <QList>
+#include <QSet>
 #include <QVariant>
 #include <functional>
 #include <memory>
@@ -28,11 +29,17 @@
 #include "minecraft/mod/ModFolderModel.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/ResourceAPI.h"
-#include "tasks/SequentialTask.h"
+#include "tasks/ConcurrentTask.h"
 #include "tasks/Task.h"
 #include "ui/pages/modplatform/ModModel.h"
 
-class GetModDependenciesTask : public SequentialTask {
+/* GetModDependenciesTask
+ * Resolves the required dependencies of the selected mods, and theirs in turn.
+ *
+ * Independent dependencies are looked up in parallel and every dependency is only looked up once, however many mods need it.
+ * The project info of the dependencies that are left is fetched at the end, in a single request per provider.
+ */
+class GetModDependenciesTask : public ConcurrentTask {
     Q_OBJECT
    public:
     using Ptr = shared_qobject_ptr<GetModDependenciesTask>;
@@ -65,12 +72,26 @@ class GetModDependenciesTask : public SequentialTask {
     auto getDependecies() const -> QList<std::shared_ptr<PackDependency>> { return m_pack_dependencies; }
     QHash<QString, PackDependencyExtraInfo> getExtraInfo();
 
+   protected:
+    /// looks the dependencies up through the given providers, with no installed mods; prepare() queues the lookups
+    GetModDependenciesTask(QList<std::shared_ptr<PackDependency>> selected,
+                           Provider flame,
+                           Provider modrinth,
+                           Version version,
+                           ModPlatform::ModLoaderTypes loaders,
+                           int maxConcurrent);
+
    protected slots:
+    void executeNextSubTask() override;
+
     Task::Ptr prepareDependencyTask(const ModPlatform::Dependency&, ModPlatform::ResourceProvider, int);
+    /// queues the lookup of the dependency, unless it was looked up already
+    void addDependency(const ModPlatform::Dependency&, ModPlatform::ResourceProvider, int);
     QList<ModPlatform::Dependency> getDependenciesForVersion(const ModPlatform::IndexedVersion&,
                                                              ModPlatform::ResourceProvider providerName);
     void prepare();
-    Task::Ptr getProjectInfoTask(std::shared_ptr<PackDependency> pDep);
+    /// fetches the project info of all dependencies of the provider at once
+    Task::Ptr getProjectInfoTask(const Provider& provider);
     ModPlatform::Dependency getOverride(const ModPlatform::Dependency&, ModPlatform::ResourceProvider providerName);
     void removePack(const QVariant& addonId);
 
@@ -87,4 +108,8 @@ class GetModDependenciesTask : public SequentialTask {
 
     Version m_version;
     ModPlatform::ModLoaderTypes m_loaderType;
+
+    // (provider, project or version, loaders, minecraft version) of every dependency that was looked up
+    QSet<QString> m_requested;
+    bool m_projectInfoRequested = false;
 };
@@ -1,8 +1,6 @@
 #include "LocalModParseTask.h"
 
 #include <qdcss.h>
-#include <quazip/quazip.h>
-#include <quazip/quazipfile.h>
 #include <toml++/toml.h>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -11,9 +9,12 @@
 #include <QRegularExpression>
 #include <QString>
 
+#include "Application.h"
 #include "FileSystem.h"
 #include "Json.h"
+#include "ZipProbe.h"
 #include "minecraft/mod/ModDetails.h"
+#include "minecraft/mod/ModDetailsCache.h"
 #include "settings/INIFile.h"
 
 static QRegularExpression newlineRegex("\r\n|\n|\r");
@@ -447,13 +448,13 @@ ModDetails ReadNilModInfo(QByteArray contents, QString fname)
     return details;
 }
 
-bool process(Mod& mod, ProcessingLevel level)
+bool process(Mod& mod, ProcessingLevel level, QImage* icon)
 {
     switch (mod.type()) {
         case ResourceType::FOLDER:
             return processFolder(mod, level);
         case ResourceType::ZIPFILE:
-            return processZIP(mod, level);
+            return processZIP(mod, level, icon);
         case ResourceType::LITEMOD:
             return processLitemod(mod);
         default:
@@ -462,113 +463,71 @@ bool process(Mod& mod, ProcessingLevel level)
     }
 }
 
-bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
+bool processZIP(Mod& mod, ProcessingLevel level, QImage* icon)
 {
     ModDetails details;
 
-    QuaZip zip(mod.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipProbe zip(mod.fileinfo().filePath());
+    if (!zip.open())
         return false;
 
-    QuaZipFile file(&zip);
+    auto readDetails = [&zip, &details](const QString& name, auto parse) {
+        auto data = zip.read(name);
+        if (data.isNull())
+            return false;
+        details = parse(data);
+        return true;
+    };
 
-    if (zip.setCurrentFile("META-INF/mods.toml") || zip.setCurrentFile("META-INF/neoforge.mods.toml")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    if (zip.contains("META-INF/mods.toml") || zip.contains("META-INF/neoforge.mods.toml")) {
+        auto data = zip.read(zip.contains("META-INF/mods.toml") ? "META-INF/mods.toml" : "META-INF/neoforge.mods.toml");
+        if (data.isNull())
             return false;
-        }
 
-        details = ReadMCModTOML(file.readAll());
-        file.close();
+        details = ReadMCModTOML(data);
 
         // to replace ${file.jarVersion} with the actual version, as needed
-        if (details.version == "${file.jarVersion}") {
-            if (zip.setCurrentFile("META-INF/MANIFEST.MF")) {
-                if (!file.open(QIODevice::ReadOnly)) {
-                    zip.close();
-                    return false;
-                }
-
-                // quick and dirty line-by-line parser
-                auto manifestLines = QString(file.readAll()).split(newlineRegex);
-                QString manifestVersion = "";
-                for (auto& line : manifestLines) {
-                    if (line.startsWith("Implementation-Version: ", Qt::CaseInsensitive)) {
-                        manifestVersion = line.remove("Implementation-Version: ", Qt::CaseInsensitive);
-                        break;
-                    }
-                }
+        if (details.version == "${file.jarVersion}" && zip.contains("META-INF/MANIFEST.MF")) {
+            auto manifest = zip.read("META-INF/MANIFEST.MF");
+            if (manifest.isNull())
+                return false;
 
-                // some mods use ${projectversion} in their build.gradle, causing this mess to show up in MANIFEST.MF
-                // also keep with forge's behavior of setting the version to "NONE" if none is found
-                if (manifestVersion.contains("task ':jar' property 'archiveVersion'") || manifestVersion == "") {
-                    manifestVersion = "NONE";
+            // quick and dirty line-by-line parser
+            auto manifestLines = QString(manifest).split(newlineRegex);
+            QString manifestVersion = "";
+            for (auto& line : manifestLines) {
+                if (line.startsWith("Implementation-Version: ", Qt::CaseInsensitive)) {
+                    manifestVersion = line.remove("Implementation-Version: ", Qt::CaseInsensitive);
+                    break;
                 }
-
-                details.version = manifestVersion;
-
-                file.close();
             }
-        }
 
-        zip.close();
-        mod.setDetails(details);
+            // some mods use ${projectversion} in their build.gradle, causing this mess to show up in MANIFEST.MF
+            // also keep with forge's behavior of setting the version to "NONE" if none is found
+            if (manifestVersion.contains("task ':jar' property 'archiveVersion'") || manifestVersion == "") {
+                manifestVersion = "NONE";
+            }
 
-        return true;
-    } else if (zip.setCurrentFile("mcmod.info")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
-            return false;
+            details.version = manifestVersion;
         }
-
-        details = ReadMCModInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("quilt.mod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("mcmod.info")) {
+        if (!readDetails("mcmod.info", ReadMCModInfo))
             return false;
-        }
-
-        details = ReadQuiltModInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("fabric.mod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("quilt.mod.json")) {
+        if (!readDetails("quilt.mod.json", ReadQuiltModInfo))
             return false;
-        }
-
-        details = ReadFabricModInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("forgeversion.properties")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("fabric.mod.json")) {
+        if (!readDetails("fabric.mod.json", ReadFabricModInfo))
             return false;
-        }
-
-        details = ReadForgeInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("META-INF/nil/mappings.json")) {
+    } else if (zip.contains("forgeversion.properties")) {
+        if (!readDetails("forgeversion.properties", ReadForgeInfo))
+            return false;
+    } else if (zip.contains("META-INF/nil/mappings.json")) {
         // nilloader uses the filename of the metadata file for the modid, so we can't know the exact filename
         // thankfully, there is a good file to use as a canary so we don't look for nil meta all the time
 
         QString foundNilMeta;
-        for (auto& fname : zip.getFileNameList()) {
+        for (auto& fname : zip.fileNames()) {
             // nilmods can shade nilloader to be able to run as a standalone agent - which includes nilloader's own meta file
             if (fname.endsWith(".nilmod.css") && fname != "nilloader.nilmod.css") {
                 foundNilMeta = fname;
@@ -576,23 +535,25 @@ bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
             }
         }
 
-        if (zip.setCurrentFile(foundNilMeta)) {
-            if (!file.open(QIODevice::ReadOnly)) {
-                zip.close();
-                return false;
-            }
-
-            details = ReadNilModInfo(file.readAll(), foundNilMeta);
-            file.close();
-            zip.close();
+        if (foundNilMeta.isEmpty())
+            return false;
+        auto data = zip.read(foundNilMeta);
+        if (data.isNull())
+            return false;
+        details = ReadNilModInfo(data, foundNilMeta);
+    } else {
+        return false;  // no valid mod found in archive
+    }
 
-            mod.setDetails(details);
-            return true;
-        }
+    // the archive is open already, so the icon comes along instead of being read on its own later
+    if (icon && level == ProcessingLevel::Full && !details.icon_file.isEmpty()) {
+        auto data = zip.read(details.icon_file);
+        if (!data.isNull())
+            *icon = QImage::fromData(data);
     }
 
-    zip.close();
-    return false;  // no valid mod found in archive
+    mod.setDetails(details);
+    return true;
 }
 
 bool processFolder(Mod& mod, [[maybe_unused]] ProcessingLevel level)
@@ -618,29 +579,16 @@ bool processFolder(Mod& mod, [[maybe_unused]] ProcessingLevel level)
 
 bool processLitemod(Mod& mod, [[maybe_unused]] ProcessingLevel level)
 {
-    ModDetails details;
-
-    QuaZip zip(mod.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipProbe zip(mod.fileinfo().filePath());
+    if (!zip.open())
         return false;
 
-    QuaZipFile file(&zip);
-
-    if (zip.setCurrentFile("litemod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
-            return false;
-        }
-
-        details = ReadLiteModInfo(file.readAll());
-        file.close();
-
-        mod.setDetails(details);
-        return true;
-    }
-    zip.close();
+    auto data = zip.read("litemod.json");
+    if (data.isNull())
+        return false;  // no valid litemod.json found in archive
 
-    return false;  // no valid litemod.json found in archive
+    mod.setDetails(ReadLiteModInfo(data));
+    return true;
 }
 
 /** Checks whether a file is valid as a mod or not. */
@@ -696,31 +644,21 @@ bool loadIconFile(const Mod& mod, QPixmap* pixmap)
             return png_invalid("file '" + icon_info.filePath() + "' does not exists or is not a file");
         }
         case ResourceType::ZIPFILE: {
-            QuaZip zip(mod.fileinfo().filePath());
-            if (!zip.open(QuaZip::mdUnzip))
+            ZipProbe zip(mod.fileinfo().filePath());
+            if (!zip.open())
                 return png_invalid("failed to open '" + mod.fileinfo().filePath() + "' as a zip archive");
 
-            QuaZipFile file(&zip);
-
-            if (zip.setCurrentFile(mod.iconPath())) {
-                if (!file.open(QIODevice::ReadOnly)) {
-                    qCritical() << "Failed to open file in zip.";
-                    zip.close();
-                    return png_invalid("Failed to open '" + mod.iconPath() + "' in zip archive");
-                }
+            if (!zip.contains(mod.iconPath()))
+                return png_invalid("'" + mod.iconPath() + "' does not exist in the zip archive");
 
-                auto data = file.readAll();
+            auto data = zip.read(mod.iconPath());
+            if (data.isNull())
+                return png_invalid("Failed to read '" + mod.iconPath() + "' from the zip archive");
 
-                bool icon_result = ModUtils::processIconPNG(mod, std::move(data), pixmap);
-
-                file.close();
-                if (!icon_result) {
-                    return png_invalid("invalid png image");  // icon png invalid
-                }
-                return true;
+            if (!ModUtils::processIconPNG(mod, std::move(data), pixmap)) {
+                return png_invalid("invalid png image");  // icon png invalid
             }
-            return png_invalid("Failed to set '" + mod.iconPath() +
-                               "' as current file in zip archive");  // could not set icon as current file.
+            return true;
         }
         case ResourceType::LITEMOD: {
             return png_invalid("litemods do not have icons");  // can lightmods even have icons?
@@ -744,10 +682,22 @@ bool LocalModParseTask::abort()
 
 void LocalModParseTask::executeTask()
 {
-    Mod mod{ m_modFile };
-    ModUtils::process(mod, ModUtils::ProcessingLevel::Full);
+    // in tests there is no application, and with it no cache
+    std::shared_ptr<ModDetailsCache> cache;
+    if (auto app = APPLICATION_DYN; app && m_type != ResourceType::FOLDER)
+        cache = app->modDetailsCache();
+
+    if (auto details = cache ? cache->find(m_modFile) : std::nullopt) {
+        m_result->details = *details;
+    } else {
+        Mod mod{ m_modFile };
+        ModUtils::process(mod, ModUtils::ProcessingLevel::Full, &m_result->icon);
 
-    m_result->details = mod.details();
+        m_result->details = mod.details();
+        // mods without any metadata are remembered as well, there is nothing more to find in them
+        if (cache && !m_aborted)
+            cache->insert(m_modFile, m_result->details);
+    }
 
     if (m_aborted)
         emitAborted();
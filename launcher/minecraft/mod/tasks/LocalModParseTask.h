@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QDebug>
+#include <QImage>
 #include <QObject>
 
 #include "minecraft/mod/Mod.h"
@@ -17,9 +18,10 @@ ModDetails ReadLiteModInfo(QByteArray contents);
 
 enum class ProcessingLevel { Full, BasicInfoOnly };
 
-bool process(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
+/** Parses the metadata of the mod. If icon is given, the icon of zip mods is decoded into it on a full parse. */
+bool process(Mod& mod, ProcessingLevel level = ProcessingLevel::Full, QImage* icon = nullptr);
 
-bool processZIP(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
+bool processZIP(Mod& mod, ProcessingLevel level = ProcessingLevel::Full, QImage* icon = nullptr);
 bool processFolder(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
 bool processLitemod(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
 
@@ -35,6 +37,8 @@ class LocalModParseTask : public Task {
    public:
     struct Result {
         ModDetails details;
+        /* decoded while the archive was open, null if there is none or it was cached */
+        QImage icon;
     };
     using ResultPtr = std::shared_ptr<Result>;
     ResultPtr result() const { return m_result; }
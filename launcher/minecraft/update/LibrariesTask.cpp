@@ -11,6 +11,38 @@ LibrariesTask::LibrariesTask(MinecraftInstance* inst)
 }
 
 void LibrariesTask::executeTask()
+{
+    MinecraftInstance* inst = (MinecraftInstance*)m_inst;
+    auto profile = inst->getPackProfile()->getProfile();
+
+    // rehash the libraries that changed on disk in one go, instead of one by one in getDownloads
+    QStringList storagePaths;
+    QList<LibraryPtr> libraries;
+    libraries.append(profile->getLibraries());
+    libraries.append(profile->getNativeLibraries());
+    libraries.append(profile->getMavenFiles());
+    for (auto agent : profile->getAgents()) {
+        libraries.append(agent->library());
+    }
+    libraries.append(profile->getMainJar());
+    for (auto lib : libraries) {
+        if (lib && !lib->isLocal())
+            storagePaths.append(lib->storageSuffix(inst->runtimeContext()));
+    }
+
+    verifyTask.reset(new Net::MetaCacheVerifyTask(APPLICATION->metacache().get(), "libraries", storagePaths));
+    connect(verifyTask.get(), &Task::aborted, this, [this] { emitFailed(tr("Aborted")); });
+    // not fatal, getDownloads checks everything again anyway
+    connect(verifyTask.get(), &Task::failed, this, [](QString reason) { qWarning() << "Failed to verify cached libraries:" << reason; });
+    connect(verifyTask.get(), &Task::finished, this, [this] {
+        verifyTask.reset();
+        if (isRunning())
+            downloadLibraries();
+    });
+    verifyTask->start();
+}
+
+void LibrariesTask::downloadLibraries()
 {
     setStatus(tr("Downloading required library files..."));
     qDebug() << m_inst->name() << ": downloading libraries";
@@ -83,7 +115,9 @@ void LibrariesTask::jarlibFailed(QString reason)
 
 bool LibrariesTask::abort()
 {
-    if (downloadJob) {
+    if (verifyTask) {
+        return verifyTask->abort();
+    } else if (downloadJob) {
         return downloadJob->abort();
     } else {
         qWarning() << "Prematurely aborted LibrariesTask";
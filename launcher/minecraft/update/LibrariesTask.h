@@ -1,4 +1,5 @@
 #pragma once
+#include "net/MetaCacheVerifyTask.h"
 #include "net/NetJob.h"
 #include "tasks/Task.h"
 class MinecraftInstance;
@@ -14,6 +15,7 @@ class LibrariesTask : public Task {
     bool canAbort() const override;
 
    private slots:
+    void downloadLibraries();
     void jarlibFailed(QString reason);
 
    public slots:
@@ -21,5 +23,6 @@ class LibrariesTask : public Task {
 
    private:
     MinecraftInstance* m_inst;
+    Net::MetaCacheVerifyTask::Ptr verifyTask;
     NetJob::Ptr downloadJob;
 };
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HashCache.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+namespace Hashing {
+
+namespace {
+constexpr int s_formatVersion = 1;
+constexpr int s_saveThreshold = 64;
+}  // namespace
+
+HashCache::HashCache(QString file)
+    : m_cache({ file, "hash cache", s_formatVersion, s_saveThreshold },
+              [](const Digests& digests) {
+                  QJsonObject obj;
+                  obj.insert("sha1", digests.sha1);
+                  obj.insert("sha512", digests.sha512);
+                  obj.insert("md5", digests.md5);
+                  obj.insert("murmur2", digests.murmur2);
+                  return obj;
+              },
+              [](const QJsonObject& obj) {
+                  Digests digests;
+                  digests.sha1 = Json::requireString(obj, "sha1");
+                  digests.sha512 = Json::requireString(obj, "sha512");
+                  digests.md5 = Json::requireString(obj, "md5");
+                  digests.murmur2 = Json::requireString(obj, "murmur2");
+                  return digests;
+              })
+{}
+
+bool HashCache::isCached(Algorithm type)
+{
+    return type == Algorithm::Sha1 || type == Algorithm::Sha512 || type == Algorithm::Md5 || type == Algorithm::Murmur2;
+}
+
+QString HashCache::Digests::digest(Algorithm type) const
+{
+    switch (type) {
+        case Algorithm::Sha1:
+            return sha1;
+        case Algorithm::Sha512:
+            return sha512;
+        case Algorithm::Md5:
+            return md5;
+        case Algorithm::Murmur2:
+            return murmur2;
+        default:
+            return {};
+    }
+}
+
+QString HashCache::hash(const QString& path, Algorithm type)
+{
+    if (!isCached(type)) {
+        QFile file(path);
+        return Hashing::hash(&file, type);
+    }
+
+    QFileInfo info(path);
+    auto fingerprint = FS::fingerprint(info);
+    if (!fingerprint.isValid())
+        return {};
+    auto key = info.absoluteFilePath();
+    if (auto cached = m_cache.find(key, fingerprint))
+        return cached->digest(type);
+
+    // hashing happens outside of the cache's lock, so other files can be looked up meanwhile
+    Digests digests;
+    if (!computeDigests(key, digests))
+        return {};
+    m_cache.insert(key, fingerprint, digests);
+    return digests.digest(type);
+}
+
+bool HashCache::computeDigests(const QString& path, Digests& digests)
+{
+    MultiHasher hasher({ Algorithm::Sha1, Algorithm::Sha512, Algorithm::Md5, Algorithm::Murmur2 });
+    if (!hasher.hashFile(path))
+        return false;
+    auto results = hasher.results();
+    digests.sha1 = results.value(Algorithm::Sha1);
+    digests.sha512 = results.value(Algorithm::Sha512);
+    digests.md5 = results.value(Algorithm::Md5);
+    digests.murmur2 = results.value(Algorithm::Murmur2);
+    return true;
+}
+
+void HashCache::save()
+{
+    m_cache.save();
+}
+
+}  // namespace Hashing
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QString>
+
+#include "FingerprintCache.h"
+#include "modplatform/helpers/HashUtils.h"
+
+namespace Hashing {
+
+/* HashCache
+ * Digests of local files, shared by everything that hashes mods, resource packs, etc.
+ *
+ * Entries are keyed by the absolute path. Whenever a file has to be read, its sha1, sha512, md5 and murmur2 digests are all
+ * computed in that one pass, so asking for another algorithm later doesn't read it again.
+ */
+class HashCache {
+   public:
+    explicit HashCache(QString file);
+
+    /// whether the algorithm is one of the cached ones
+    static bool isCached(Algorithm type);
+
+    /// digest of the file, from the cache if it didn't change. empty if it can't be read
+    QString hash(const QString& path, Algorithm type);
+
+    void save();
+
+   private:
+    struct Digests {
+        QString sha1;
+        QString sha512;
+        QString md5;
+        QString murmur2;
+
+        QString digest(Algorithm type) const;
+    };
+
+    static bool computeDigests(const QString& path, Digests& digests);
+
+   private:
+    FingerprintCache<Digests> m_cache;
+};
+
+}  // namespace Hashing
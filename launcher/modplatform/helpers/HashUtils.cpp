@@ -3,10 +3,17 @@
 #include <QBuffer>
 #include <QDebug>
 #include <QFile>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 
+#include <algorithm>
+#include <optional>
+
 #include <MurmurHash2.h>
 
+#include "Application.h"
+#include "modplatform/helpers/HashCache.h"
+
 namespace Hashing {
 
 Hasher::Ptr createHasher(QString file_path, ModPlatform::ResourceProvider provider)
@@ -28,19 +35,6 @@ Hasher::Ptr createHasher(QString file_path, QString type)
     return makeShared<Hasher>(file_path, type);
 }
 
-class QIODeviceReader : public Murmur2::Reader {
-   public:
-    QIODeviceReader(QIODevice* device) : m_device(device) {}
-    virtual ~QIODeviceReader() = default;
-    virtual int read(char* s, int n) { return m_device->read(s, n); }
-    virtual bool eof() { return m_device->atEnd(); }
-    virtual void goToBeginning() { m_device->seek(0); }
-    virtual void close() { m_device->close(); }
-
-   private:
-    QIODevice* m_device;
-};
-
 QString algorithmToString(Algorithm type)
 {
     switch (type) {
@@ -80,51 +74,127 @@ Algorithm algorithmFromString(QString type)
     return Algorithm::Unknown;
 }
 
-QString hash(QIODevice* device, Algorithm type)
+namespace {
+constexpr qint64 s_chunkSize = 256 * 1024;
+
+std::optional<QCryptographicHash::Algorithm> cryptographicAlgorithm(Algorithm type)
 {
-    if (!device->isOpen() && !device->open(QFile::ReadOnly))
-        return "";
-    QCryptographicHash::Algorithm alg = QCryptographicHash::Sha1;
     switch (type) {
         case Algorithm::Md4:
-            alg = QCryptographicHash::Algorithm::Md4;
-            break;
+            return QCryptographicHash::Md4;
         case Algorithm::Md5:
-            alg = QCryptographicHash::Algorithm::Md5;
-            break;
+            return QCryptographicHash::Md5;
         case Algorithm::Sha1:
-            alg = QCryptographicHash::Algorithm::Sha1;
-            break;
+            return QCryptographicHash::Sha1;
         case Algorithm::Sha256:
-            alg = QCryptographicHash::Algorithm::Sha256;
-            break;
+            return QCryptographicHash::Sha256;
         case Algorithm::Sha512:
-            alg = QCryptographicHash::Algorithm::Sha512;
-            break;
-        case Algorithm::Murmur2: {  // CF-specific
-            auto should_filter_out = [](char c) { return (c == 9 || c == 10 || c == 13 || c == 32); };
-            auto reader = std::make_unique<QIODeviceReader>(device);
-            auto result = QString::number(Murmur2::hash(reader.get(), 4 * MiB, should_filter_out));
-            device->close();
-            return result;
-        }
-        case Algorithm::Unknown:
-            device->close();
-            return "";
+            return QCryptographicHash::Sha512;
+        default:
+            return {};
     }
+}
+}  // namespace
 
-    QCryptographicHash hash(alg);
-    if (!hash.addData(device))
-        qCritical() << "Failed to read JAR to create hash!";
+MultiHasher::MultiHasher(const QList<Algorithm>& algorithms)
+{
+    for (auto type : algorithms) {
+        if (type == Algorithm::Murmur2)
+            m_murmur2 = true;
+        else if (auto alg = cryptographicAlgorithm(type))
+            m_hashes.emplace_back(type, std::make_unique<QCryptographicHash>(*alg));
+    }
+}
+
+MultiHasher::~MultiHasher() = default;
 
-    Q_ASSERT(hash.result().length() == hash.hashLength(alg));
-    auto result = hash.result().toHex();
+bool MultiHasher::hashDevice(QIODevice* device)
+{
+    if (!device->isOpen() && !device->open(QFile::ReadOnly))
+        return false;
+
+    bool ok = true;
+    if (m_murmur2) {  // CF-specific
+        // read the file only once, mapped if possible
+        auto file = qobject_cast<QFile*>(device);
+        auto size = file ? file->size() - file->pos() : 0;
+        if (auto mapped = size > 0 ? file->map(file->pos(), size) : nullptr) {
+            addData(reinterpret_cast<const char*>(mapped), size);
+            file->unmap(mapped);
+        } else {
+            auto data = device->readAll();
+            ok = !file || file->error() == QFileDevice::NoError;
+            addData(data.constData(), data.size());
+        }
+    } else {
+        QByteArray buffer(s_chunkSize, Qt::Uninitialized);
+        qint64 read;
+        while ((read = device->read(buffer.data(), buffer.size())) > 0) {
+            addData(buffer.constData(), read);
+        }
+        ok = read == 0;
+    }
+    if (!ok)
+        qCritical() << "Failed to read JAR to create hash!";
     device->close();
-    return result;
+    return ok;
+}
+
+bool MultiHasher::hashFile(const QString& fileName)
+{
+    QFile file(fileName);
+    return hashDevice(&file);
+}
+
+bool MultiHasher::hashData(const QByteArray& data)
+{
+    addData(data.constData(), data.size());
+    return true;
+}
+
+void MultiHasher::addData(const char* data, qint64 size)
+{
+    std::unique_ptr<Murmur2::Hasher> murmur2;
+    if (m_murmur2)
+        murmur2 = std::make_unique<Murmur2::Hasher>(static_cast<uint32_t>(Murmur2::countNonWhitespace(data, size)));
+
+    // every chunk goes through all the hashes while it is still in the cpu cache
+    for (qint64 pos = 0; pos < size; pos += s_chunkSize) {
+        auto length = qMin(s_chunkSize, size - pos);
+        auto chunk = QByteArray::fromRawData(data + pos, static_cast<int>(length));
+        for (auto& hash : m_hashes)
+            hash.second->addData(chunk);
+        if (murmur2)
+            murmur2->addData(data + pos, length);
+    }
+
+    if (murmur2)
+        m_murmur2Result = QString::number(murmur2->result());
+}
+
+Digests MultiHasher::results() const
+{
+    Digests digests;
+    for (auto& hash : m_hashes)
+        digests.insert(hash.first, hash.second->result().toHex());
+    if (m_murmur2)
+        digests.insert(Algorithm::Murmur2, m_murmur2Result);
+    return digests;
+}
+
+QString hash(QIODevice* device, Algorithm type)
+{
+    MultiHasher hasher({ type });
+    if (!hasher.hashDevice(device))
+        return "";
+    return hasher.result(type);
 }
 
 QString hash(QString fileName, Algorithm type)
 {
+    // in tests there is no application, and with it no cache
+    if (auto app = APPLICATION_DYN; app && HashCache::isCached(type))
+        return app->hashCache()->hash(fileName, type);
     QFile file(fileName);
     return hash(&file, type);
 }
@@ -135,6 +205,33 @@ QString hash(QByteArray data, Algorithm type)
     return hash(&buff, type);
 }
 
+Digests hashFile(const QString& fileName, const QList<Algorithm>& algorithms)
+{
+    // the cache computes all of its digests in one go, the other lookups are free after the first one
+    if (auto app = APPLICATION_DYN;
+        app && std::all_of(algorithms.begin(), algorithms.end(), [](Algorithm type) { return HashCache::isCached(type); })) {
+        Digests digests;
+        for (auto type : algorithms) {
+            auto digest = app->hashCache()->hash(fileName, type);
+            if (digest.isEmpty())
+                return {};
+            digests.insert(type, digest);
+        }
+        return digests;
+    }
+
+    MultiHasher hasher(algorithms);
+    if (!hasher.hashFile(fileName))
+        return {};
+    return hasher.results();
+}
+
+QFuture<Digests> hashFiles(const QStringList& fileNames, const QList<Algorithm>& algorithms)
+{
+    std::function<Digests(const QString&)> hashOne = [algorithms](const QString& fileName) { return hashFile(fileName, algorithms); };
+    return QtConcurrent::mapped(QThreadPool::globalInstance(), fileNames, hashOne);
+}
+
 void Hasher::executeTask()
 {
     m_future = QtConcurrent::run(
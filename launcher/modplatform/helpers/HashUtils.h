@@ -3,8 +3,12 @@
 #include <QCryptographicHash>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QMap>
 #include <QString>
 
+#include <memory>
+#include <vector>
+
 #include "modplatform/ModIndex.h"
 #include "tasks/Task.h"
 
@@ -12,12 +16,47 @@ namespace Hashing {
 
 enum class Algorithm { Md4, Md5, Sha1, Sha256, Sha512, Murmur2, Unknown };
 
+using Digests = QMap<Algorithm, QString>;
+
 QString algorithmToString(Algorithm type);
 Algorithm algorithmFromString(QString type);
 QString hash(QIODevice* device, Algorithm type);
 QString hash(QString fileName, Algorithm type);
 QString hash(QByteArray data, Algorithm type);
 
+/// all the requested digests of a file, from the hash cache when possible. empty if the file can't be read
+Digests hashFile(const QString& fileName, const QList<Algorithm>& algorithms);
+/// hashFile for many files at once, spread over the global thread pool. the results are in the order of the file names
+QFuture<Digests> hashFiles(const QStringList& fileNames, const QList<Algorithm>& algorithms);
+
+/* Computes several digests of the same data while reading it only once.
+ * The data goes through all the hashes in fixed-size chunks. Murmur2 needs to know how much of the data isn't whitespace
+ * before it can start, so with it the data is mapped (or read) completely first.
+ * A hasher is meant for a single input.
+ */
+class MultiHasher {
+   public:
+    explicit MultiHasher(const QList<Algorithm>& algorithms);
+    ~MultiHasher();
+
+    /// hashes everything that is left in the device and closes it. false if it can't be read
+    bool hashDevice(QIODevice* device);
+    bool hashFile(const QString& fileName);
+    bool hashData(const QByteArray& data);
+
+    /// the digests, as hex strings (decimal for murmur2)
+    Digests results() const;
+    QString result(Algorithm type) const { return results().value(type); }
+
+   private:
+    void addData(const char* data, qint64 size);
+
+   private:
+    std::vector<std::pair<Algorithm, std::unique_ptr<QCryptographicHash>>> m_hashes;
+    bool m_murmur2 = false;
+    QString m_murmur2Result;
+};
+
 class Hasher : public Task {
     Q_OBJECT
    public:
@@ -245,6 +245,8 @@ bool ModrinthCreationTask::createInstance()
     auto root_modpack_url = QUrl::fromLocalFile(root_modpack_path);
     // TODO make this work with other sorts of resource
     QHash<QString, Resource*> resources;
+    auto store = APPLICATION->blobStore();
+    QList<std::pair<QString, Modrinth::File>> downloaded;
     for (auto file : m_files) {
         auto fileName = file.path;
         fileName = FS::RemoveInvalidPathChars(fileName);
@@ -266,6 +268,11 @@ bool ModrinthCreationTask::createInstance()
             setError(tr("The file '%1' is missing a download link. This is invalid in the pack format.").arg(fileName));
             return false;
         }
+        if (store && store->materialize(file.hashAlgorithm, file.hash, file_path)) {
+            qDebug() << "Reusing the shared copy of" << fileName;
+            continue;
+        }
+        downloaded.append({ file_path, file });
         qDebug() << "Will try to download" << file.downloads.front() << "to" << file_path;
         auto dl = Net::ApiDownload::makeFile(file.downloads.dequeue(), file_path);
         dl->addValidator(new Net::ChecksumValidator(file.hashAlgorithm, file.hash));
@@ -308,9 +315,17 @@ bool ModrinthCreationTask::createInstance()
         for (auto resource : resources) {
             delete resource;
         }
+        if (store)
+            store->save();
         return ended_well;
     }
 
+    if (store) {
+        for (auto& [path, file] : downloaded)
+            store->add(path, file.hashAlgorithm, file.hash);
+        store->save();
+    }
+
     QEventLoop ensureMetaLoop;
     QDir folder = FS::PathCombine(instance.modsRoot(), ".index");
     auto ensureMetadataTask = makeShared<EnsureMetadataTask>(resources, folder, ModPlatform::ResourceProvider::MODRINTH);
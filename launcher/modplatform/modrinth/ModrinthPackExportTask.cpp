@@ -50,7 +50,14 @@ ModrinthPackExportTask::ModrinthPackExportTask(const QString& name,
     , gameRoot(instance->gameRoot())
     , output(output)
     , filter(filter)
-{}
+{
+    connect(&hashWatcher, &QFutureWatcher<Hashing::Digests>::progressValueChanged, this,
+            [this](int value) { setProgress(value, hashedFiles.size()); });
+    connect(&hashWatcher, &QFutureWatcher<Hashing::Digests>::finished, this, [this] {
+        if (!hashFuture.isCanceled())
+            resolveHashes();
+    });
+}
 
 void ModrinthPackExportTask::executeTask()
 {
@@ -61,6 +68,11 @@ void ModrinthPackExportTask::executeTask()
 
 bool ModrinthPackExportTask::abort()
 {
+    if (hashFuture.isRunning()) {
+        hashFuture.cancel();
+        emitAborted();
+        return true;
+    }
     if (task) {
         task->abort();
         emitAborted();
@@ -93,9 +105,9 @@ void ModrinthPackExportTask::collectFiles()
 void ModrinthPackExportTask::collectHashes()
 {
     setStatus(tr("Finding file hashes..."));
+    hashedFiles.clear();
+    QStringList paths;
     for (const QFileInfo& file : files) {
-        QCoreApplication::processEvents();
-
         const QString relative = gameRoot.relativeFilePath(file.absoluteFilePath());
         // require sensible file types
         if (!std::any_of(PREFIXES.begin(), PREFIXES.end(), [&relative](const QString& prefix) { return relative.startsWith(prefix); }))
@@ -104,21 +116,30 @@ void ModrinthPackExportTask::collectHashes()
                 return relative.endsWith('.' + extension) || relative.endsWith('.' + extension + ".disabled");
             }))
             continue;
+        hashedFiles.append(file);
+        paths.append(file.absoluteFilePath());
+    }
 
-        QFile openFile(file.absoluteFilePath());
-        if (!openFile.open(QFile::ReadOnly)) {
-            qWarning() << "Could not open" << file << "for hashing";
-            continue;
-        }
+    // both digests come from a single read of every file, spread over the thread pool
+    setAbortable(true);
+    hashFuture = Hashing::hashFiles(paths, { Hashing::Algorithm::Sha512, Hashing::Algorithm::Sha1 });
+    hashWatcher.setFuture(hashFuture);
+}
 
-        const QByteArray data = openFile.readAll();
-        if (openFile.error() != QFileDevice::NoError) {
-            qWarning() << "Could not read" << file;
+void ModrinthPackExportTask::resolveHashes()
+{
+    auto allMods = mcInstance->loaderModList()->allMods();
+    for (int i = 0; i < hashedFiles.size(); i++) {
+        const QFileInfo& file = hashedFiles[i];
+        const QString relative = gameRoot.relativeFilePath(file.absoluteFilePath());
+
+        auto digests = hashFuture.resultAt(i);
+        if (digests.isEmpty()) {
+            qWarning() << "Could not read" << file << "for hashing";
             continue;
         }
-        auto sha512 = Hashing::hash(data, Hashing::Algorithm::Sha512);
+        auto sha512 = digests.value(Hashing::Algorithm::Sha512);
 
-        auto allMods = mcInstance->loaderModList()->allMods();
         if (auto modIter = std::find_if(allMods.begin(), allMods.end(), [&file](Mod* mod) { return mod->fileinfo() == file; });
             modIter != allMods.end()) {
             const Mod* mod = *modIter;
@@ -128,9 +149,9 @@ void ModrinthPackExportTask::collectHashes()
                 if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
                     qDebug() << "Resolving" << relative << "from index";
 
-                    auto sha1 = Hashing::hash(data, Hashing::Algorithm::Sha1);
+                    auto sha1 = digests.value(Hashing::Algorithm::Sha1);
 
-                    ResolvedFile resolvedFile{ sha1, sha512, url.toEncoded(), openFile.size(), mod->metadata()->side };
+                    ResolvedFile resolvedFile{ sha1, sha512, url.toEncoded(), file.size(), mod->metadata()->side };
                     resolvedFiles[relative] = resolvedFile;
 
                     // nice! we've managed to resolve based on local metadata!
@@ -144,7 +165,6 @@ void ModrinthPackExportTask::collectHashes()
         pendingHashes[relative] = sha512;
     }
 
-    setAbortable(true);
     makeApiRequest();
 }
 
@@ -23,6 +23,7 @@
 #include "BaseInstance.h"
 #include "MMCZip.h"
 #include "minecraft/MinecraftInstance.h"
+#include "modplatform/helpers/HashUtils.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
 #include "tasks/Task.h"
 
@@ -62,12 +63,16 @@ class ModrinthPackExportTask : public Task {
 
     ModrinthAPI api;
     QFileInfoList files;
+    QFileInfoList hashedFiles;
+    QFuture<Hashing::Digests> hashFuture;
+    QFutureWatcher<Hashing::Digests> hashWatcher;
     QMap<QString, QString> pendingHashes;
     QMap<QString, ResolvedFile> resolvedFiles;
     Task::Ptr task;
 
     void collectFiles();
     void collectHashes();
+    void resolveHashes();
     void makeApiRequest();
     void parseApiResponse(std::shared_ptr<QByteArray> response);
     void buildZip();
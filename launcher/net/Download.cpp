@@ -46,6 +46,12 @@
 #include "ByteArraySink.h"
 #include "ChecksumValidator.h"
 #include "MetaCacheSink.h"
+#if defined(LAUNCHER_APPLICATION)
+#include "ExtractSink.h"
+#endif
+#if defined(WITH_LIBLZMA)
+#include "LzmaFileSink.h"
+#endif
 
 namespace Net {
 
@@ -61,6 +67,16 @@ auto Download::makeCached(QUrl url, MetaEntryPtr entry, Options options) -> Down
     dl->m_sink.reset(cachedNode);
     return dl;
 }
+
+auto Download::makeExtract(QUrl url, QString destination, bool compressed, Options options) -> Download::Ptr
+{
+    auto dl = makeShared<Download>();
+    dl->m_url = url;
+    dl->setObjectName(QString("EXTRACT:") + url.toString());
+    dl->m_options = options;
+    dl->m_sink.reset(new ExtractSink(destination, compressed));
+    return dl;
+}
 #endif
 
 auto Download::makeByteArray(QUrl url, std::shared_ptr<QByteArray> output, Options options) -> Download::Ptr
@@ -83,6 +99,18 @@ auto Download::makeFile(QUrl url, QString path, Options options) -> Download::Pt
     return dl;
 }
 
+#if defined(WITH_LIBLZMA)
+auto Download::makeLzmaFile(QUrl url, QString path, Options options) -> Download::Ptr
+{
+    auto dl = makeShared<Download>();
+    dl->m_url = url;
+    dl->setObjectName(QString("LZMA:") + url.toString());
+    dl->m_options = options;
+    dl->m_sink.reset(new LzmaFileSink(path));
+    return dl;
+}
+#endif
+
 QNetworkReply* Download::getReply(QNetworkRequest& request)
 {
     return m_network->get(request);
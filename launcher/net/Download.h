@@ -52,6 +52,10 @@ class Download : public NetRequest {
 
 #if defined(LAUNCHER_APPLICATION)
     static auto makeCached(QUrl url, MetaEntryPtr entry, Options options = Option::NoOptions) -> Download::Ptr;
+    static auto makeExtract(QUrl url, QString destination, bool compressed, Options options = Option::NoOptions) -> Download::Ptr;
+#endif
+#if defined(WITH_LIBLZMA)
+    static auto makeLzmaFile(QUrl url, QString path, Options options = Option::NoOptions) -> Download::Ptr;
 #endif
 
     static auto makeByteArray(QUrl url, std::shared_ptr<QByteArray> output, Options options = Option::NoOptions) -> Download::Ptr;
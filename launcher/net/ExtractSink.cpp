@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ExtractSink.h"
+
+#include "FileSystem.h"
+
+#include "net/Logging.h"
+
+namespace Net {
+
+Task::State ExtractSink::init(QNetworkRequest& request)
+{
+    if (!FS::ensureFolderPathExists(m_destination)) {
+        qCCritical(taskNetLogC) << "Could not create folder " + m_destination;
+        return Task::State::Failed;
+    }
+
+    // (re)start from a clean state, init is called again when following redirects
+    if (m_compressed)
+        m_extractor = std::make_unique<GZTar::Extractor>(m_destination);
+    else
+        m_extractor = std::make_unique<Tar::Extractor>(m_destination);
+
+    if (initAllValidators(request))
+        return Task::State::Running;
+    return Task::State::Failed;
+}
+
+Task::State ExtractSink::write(QByteArray& data)
+{
+    if (!m_extractor || !writeAllValidators(data) || !m_extractor->feed(data.constData(), data.size())) {
+        qCCritical(taskNetLogC) << "Failed extracting into " + m_destination;
+        m_extractor.reset();
+        return Task::State::Failed;
+    }
+    return Task::State::Running;
+}
+
+Task::State ExtractSink::abort()
+{
+    m_extractor.reset();
+    failAllValidators();
+    return Task::State::Failed;
+}
+
+Task::State ExtractSink::finalize(QNetworkReply& reply)
+{
+    // the files are already in place, so the validators can only tell us if they can be trusted
+    if (!finalizeAllValidators(reply))
+        return Task::State::Failed;
+
+    if (!m_extractor || !m_extractor->isFinished()) {
+        qCCritical(taskNetLogC) << "The archive extracted into " + m_destination + " is truncated";
+        m_extractor.reset();
+        return Task::State::Failed;
+    }
+
+    m_extractor.reset();
+    return Task::State::Succeeded;
+}
+}  // namespace Net
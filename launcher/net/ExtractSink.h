@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "Sink.h"
+#include "Untar.h"
+
+namespace Net {
+
+/*
+ * Sink object that unpacks a (optionally gzip compressed) tar archive while it is being downloaded.
+ * The archive itself is never written to disk, validators see the same chunks as the extractor.
+ */
+class ExtractSink : public Sink {
+   public:
+    ExtractSink(QString destination, bool compressed) : m_destination(destination), m_compressed(compressed) {};
+    virtual ~ExtractSink() = default;
+
+   public:
+    auto init(QNetworkRequest& request) -> Task::State override;
+    auto write(QByteArray& data) -> Task::State override;
+    auto abort() -> Task::State override;
+    auto finalize(QNetworkReply& reply) -> Task::State override;
+
+    auto hasLocalData() -> bool override { return false; }
+
+   private:
+    QString m_destination;
+    bool m_compressed;
+    std::unique_ptr<Tar::Extractor> m_extractor;
+};
+}  // namespace Net
@@ -75,11 +75,19 @@ auto HttpMetaCache::getEntry(QString base, QString resource_path) -> MetaEntryPt
     }
 
     EntryMap& map = m_entries[base];
-    if (map.entry_list.contains(resource_path)) {
-        return map.entry_list[resource_path];
+    auto it = map.entry_list.constFind(resource_path);
+    if (it != map.entry_list.constEnd()) {
+        return *it;
     }
 
-    return {};
+    // not used in this session yet, look it up in the index
+    MetaCacheRecord record;
+    if (m_dropSnapshot || !m_index || !m_index->find(base, resource_path, record)) {
+        return {};
+    }
+    auto entry = entryFromRecord(record);
+    map.entry_list.insert(resource_path, entry);
+    return entry;
 }
 
 auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString expected_etag) -> MetaEntryPtr
@@ -98,38 +106,51 @@ auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString ex
     // is the file really there? if not -> stale
     if (!finfo.isFile() || !finfo.isReadable()) {
         // if the file doesn't exist, we disown the entry
-        selected_base.entry_list.remove(resource_path);
+        removeEntry(base, resource_path);
         return staleEntry(base, resource_path);
     }
 
     if (!expected_etag.isEmpty() && expected_etag != entry->m_etag) {
         // if the etag doesn't match expected, we disown the entry
-        selected_base.entry_list.remove(resource_path);
+        removeEntry(base, resource_path);
         return staleEntry(base, resource_path);
     }
 
+    auto fingerprint = FS::fingerprint(finfo);
+    if (!entry->m_local_fingerprint.isValid() && fingerprint.modified == entry->m_local_changed_timestamp) {
+        // entries from before fingerprints were recorded, trust the timestamp one last time
+        entry->setLocalFingerprint(fingerprint);
+        markDirty(base, resource_path);
+        SaveEventually();
+    }
+
     // if the file changed, check md5sum
-    qint64 file_last_changed = finfo.lastModified().toUTC().toMSecsSinceEpoch();
-    if (file_last_changed != entry->m_local_changed_timestamp) {
-        QFile input(real_path);
-        input.open(QIODevice::ReadOnly);
-        QString md5sum = QCryptographicHash::hash(input.readAll(), QCryptographicHash::Md5).toHex().constData();
-        if (entry->m_md5sum != md5sum) {
-            selected_base.entry_list.remove(resource_path);
+    if (fingerprint != entry->m_local_fingerprint) {
+        // no point in hashing it if the size doesn't match
+        if (entry->m_local_fingerprint.isValid() && fingerprint.size != entry->m_local_fingerprint.size) {
+            removeEntry(base, resource_path);
+            return staleEntry(base, resource_path);
+        }
+
+        auto md5sum = hashFile(real_path);
+        if (md5sum.isEmpty() || entry->m_md5sum != md5sum) {
+            removeEntry(base, resource_path);
             return staleEntry(base, resource_path);
         }
 
         // md5sums matched... keep entry and save the new state to file
-        entry->m_local_changed_timestamp = file_last_changed;
+        entry->setLocalFingerprint(fingerprint);
+        markDirty(base, resource_path);
         SaveEventually();
     }
+    qint64 file_last_changed = fingerprint.modified;
 
     // Get rid of old entries, to prevent cache problems
     auto current_time = QDateTime::currentSecsSinceEpoch();
     if (entry->isExpired(current_time - (file_last_changed / 1000))) {
         qCWarning(taskNetLogC) << "[HttpMetaCache]"
                                << "Removing cache entry because of old age!";
-        selected_base.entry_list.remove(resource_path);
+        removeEntry(base, resource_path);
         return staleEntry(base, resource_path);
     }
 
@@ -151,6 +172,7 @@ auto HttpMetaCache::updateEntry(MetaEntryPtr stale_entry) -> bool
     }
 
     m_entries[stale_entry->m_baseId].entry_list[stale_entry->m_relativePath] = stale_entry;
+    markDirty(stale_entry->m_baseId, stale_entry->m_relativePath);
     SaveEventually();
 
     return true;
@@ -162,6 +184,7 @@ auto HttpMetaCache::evictEntry(MetaEntryPtr entry) -> bool
         return false;
 
     entry->m_stale = true;
+    markDirty(entry->m_baseId, entry->m_relativePath);
     SaveEventually();
     return true;
 }
@@ -172,12 +195,93 @@ void HttpMetaCache::evictAll()
         EntryMap& map = m_entries[base];
         qCDebug(taskHttpMetaCacheLogC) << "Evicting base" << base;
         for (MetaEntryPtr entry : map.entry_list) {
-            if (!evictEntry(entry))
-                qCWarning(taskHttpMetaCacheLogC) << "Unexpected missing cache entry" << entry->m_basePath;
+            // removed entries are null
+            if (entry)
+                evictEntry(entry);
         }
         map.entry_list.clear();
         FS::deletePath(map.base_path);
     }
+    // everything is gone, including the entries that were never loaded from the index
+    m_dirty.clear();
+    m_dropSnapshot = true;
+}
+
+void HttpMetaCache::removeEntry(const QString& base, const QString& resource_path)
+{
+    // keep a null entry around, so the one in the index is not picked up again
+    m_entries[base].entry_list.insert(resource_path, nullptr);
+    markDirty(base, resource_path);
+    SaveEventually();
+}
+
+void HttpMetaCache::markDirty(const QString& base, const QString& resource_path)
+{
+    m_dirty[base].insert(resource_path);
+}
+
+auto HttpMetaCache::entryFromRecord(const MetaCacheRecord& record) -> MetaEntryPtr
+{
+    auto foo = new MetaEntry();
+    foo->m_baseId = record.base;
+    foo->m_basePath = getBasePath(record.base);
+    foo->m_relativePath = record.path;
+    foo->m_md5sum = record.md5sum;
+    foo->m_etag = record.etag;
+    foo->m_local_changed_timestamp = record.localChangedTimestamp;
+    foo->m_remote_changed_timestamp = record.remoteChangedTimestamp;
+    foo->makeEternal(record.eternal);
+    if (!foo->isEternal()) {
+        foo->m_current_age = record.currentAge;
+        foo->m_max_age = record.maxAge;
+    }
+    foo->m_local_fingerprint.size = record.size;
+    foo->m_local_fingerprint.inode = record.inode;
+    foo->m_local_fingerprint.modified = record.localChangedTimestamp;
+    foo->m_local_fingerprint.metadataChanged = record.metadataChangedTimestamp;
+
+    // presumed innocent until closer examination
+    foo->m_stale = false;
+
+    return MetaEntryPtr(foo);
+}
+
+auto HttpMetaCache::recordFromEntry(const MetaEntryPtr& entry) -> MetaCacheRecord
+{
+    MetaCacheRecord record;
+    record.base = entry->m_baseId;
+    record.path = entry->m_relativePath;
+    record.md5sum = entry->m_md5sum;
+    record.etag = entry->m_etag;
+    record.remoteChangedTimestamp = entry->m_remote_changed_timestamp;
+    record.localChangedTimestamp = entry->m_local_changed_timestamp;
+    record.eternal = entry->isEternal();
+    if (!record.eternal) {
+        record.currentAge = entry->m_current_age;
+        record.maxAge = entry->m_max_age;
+    }
+    if (entry->m_local_fingerprint.isValid()) {
+        record.size = entry->m_local_fingerprint.size;
+        record.inode = entry->m_local_fingerprint.inode;
+        record.metadataChangedTimestamp = entry->m_local_fingerprint.metadataChanged;
+    }
+    return record;
+}
+
+auto HttpMetaCache::hashFile(const QString& path) -> QString
+{
+    QFile input(path);
+    if (!input.open(QIODevice::ReadOnly))
+        return {};
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    QByteArray buffer(256 * 1024, Qt::Uninitialized);
+    qint64 read;
+    while ((read = input.read(buffer.data(), buffer.size())) > 0) {
+        hash.addData(QByteArray::fromRawData(buffer.constData(), static_cast<int>(read)));
+    }
+    if (read < 0)
+        return {};
+    return hash.result().toHex();
 }
 
 auto HttpMetaCache::staleEntry(QString base, QString resource_path) -> MetaEntryPtr
@@ -217,6 +321,27 @@ void HttpMetaCache::Load()
     if (m_index_file.isNull())
         return;
 
+    m_index = std::make_unique<MetaCacheIndex>(m_index_file);
+    bool migrate = !m_index->open();
+    if (migrate) {
+        // no binary index yet, take over the entries of the old JSON index
+        loadJson();
+    }
+
+    // the journal is small, it is replayed into the in-memory entries
+    for (auto& change : m_index->readJournal()) {
+        auto it = m_entries.find(change.record.base);
+        if (it == m_entries.end())
+            continue;
+        it->entry_list.insert(change.record.path, change.removed ? nullptr : entryFromRecord(change.record));
+    }
+
+    if (migrate)
+        compact();
+}
+
+void HttpMetaCache::loadJson()
+{
     QFile index(m_index_file);
     if (!index.open(QIODevice::ReadOnly))
         return;
@@ -271,6 +396,7 @@ void HttpMetaCache::Load()
 
         // presumed innocent until closer examination
         foo->m_stale = false;
+        foo->m_basePath = entrymap.base_path;
 
         entrymap.entry_list[foo->m_relativePath] = MetaEntryPtr(foo);
     }
@@ -288,41 +414,64 @@ void HttpMetaCache::SaveNow()
     if (m_index_file.isNull())
         return;
 
-    qCDebug(taskHttpMetaCacheLogC) << "Saving metacache with" << m_entries.size() << "entries";
+    if (!m_index) {
+        m_index = std::make_unique<MetaCacheIndex>(m_index_file);
+        m_index->open();
+        m_index->readJournal();
+    }
 
-    QJsonObject toplevel;
-    Json::writeString(toplevel, "version", "1");
+    // fold the journal back into the snapshot once it gets too long to replay cheaply
+    if (m_dropSnapshot || m_index->journalLength() >= qMax<qint64>(1024, m_index->size() / 4)) {
+        compact();
+        return;
+    }
 
-    QJsonArray entriesArr;
-    for (auto group : m_entries) {
-        for (auto entry : group.entry_list) {
+    QList<MetaCacheJournalEntry> changes;
+    for (auto it = m_dirty.constBegin(); it != m_dirty.constEnd(); ++it) {
+        auto& map = m_entries[it.key()];
+        for (auto& path : it.value()) {
+            MetaCacheJournalEntry change;
+            auto entry = map.entry_list.value(path);
             // do not save stale entries. they are dead.
-            if (entry->m_stale) {
-                continue;
-            }
-
-            QJsonObject entryObj;
-            Json::writeString(entryObj, "base", entry->m_baseId);
-            Json::writeString(entryObj, "path", entry->m_relativePath);
-            Json::writeString(entryObj, "md5sum", entry->m_md5sum);
-            Json::writeString(entryObj, "etag", entry->m_etag);
-            entryObj.insert("last_changed_timestamp", QJsonValue(double(entry->m_local_changed_timestamp)));
-            if (!entry->m_remote_changed_timestamp.isEmpty())
-                entryObj.insert("remote_changed_timestamp", QJsonValue(entry->m_remote_changed_timestamp));
-            if (entry->isEternal()) {
-                entryObj.insert("eternal", true);
+            change.removed = !entry || entry->m_stale;
+            if (change.removed) {
+                change.record.base = it.key();
+                change.record.path = path;
             } else {
-                entryObj.insert("current_age", QJsonValue(double(entry->m_current_age)));
-                entryObj.insert("max_age", QJsonValue(double(entry->m_max_age)));
+                change.record = recordFromEntry(entry);
             }
-            entriesArr.append(entryObj);
+            changes.append(change);
+        }
+    }
+
+    qCDebug(taskHttpMetaCacheLogC) << "Saving metacache with" << changes.size() << "changed entries";
+    if (m_index->appendToJournal(changes))
+        m_dirty.clear();
+}
+
+void HttpMetaCache::compact()
+{
+    QList<MetaCacheRecord> records;
+    if (!m_dropSnapshot) {
+        for (auto& record : m_index->records()) {
+            auto it = m_entries.constFind(record.base);
+            // entries of unknown bases are dropped, the ones used in this session are added below
+            if (it == m_entries.constEnd() || it->entry_list.contains(record.path))
+                continue;
+            records.append(record);
+        }
+    }
+    for (auto& map : m_entries) {
+        for (auto& entry : map.entry_list) {
+            // do not save stale entries. they are dead.
+            if (entry && !entry->m_stale)
+                records.append(recordFromEntry(entry));
         }
     }
-    toplevel.insert("entries", entriesArr);
 
-    try {
-        Json::write(toplevel, m_index_file);
-    } catch (const Exception& e) {
-        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache:" << e.what();
+    qCDebug(taskHttpMetaCacheLogC) << "Compacting metacache with" << records.size() << "entries";
+    if (m_index->compact(records)) {
+        m_dirty.clear();
+        m_dropSnapshot = false;
     }
 }
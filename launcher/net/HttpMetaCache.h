@@ -36,14 +36,22 @@
 #pragma once
 
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QTimer>
 #include <memory>
 
+#include "FileSystem.h"
+#include "net/MetaCacheIndex.h"
+
 class HttpMetaCache;
+namespace Net {
+class MetaCacheVerifyTask;
+}
 
 class MetaEntry {
     friend class HttpMetaCache;
+    friend class Net::MetaCacheVerifyTask;
 
    protected:
     MetaEntry() = default;
@@ -57,6 +65,11 @@ class MetaEntry {
     auto getRemoteChangedTimestamp() -> QString { return m_remote_changed_timestamp; }
     void setRemoteChangedTimestamp(QString remote_changed_timestamp) { m_remote_changed_timestamp = remote_changed_timestamp; }
     void setLocalChangedTimestamp(qint64 timestamp) { m_local_changed_timestamp = timestamp; }
+    void setLocalFingerprint(const FS::FileFingerprint& fingerprint)
+    {
+        m_local_fingerprint = fingerprint;
+        m_local_changed_timestamp = fingerprint.modified;
+    }
 
     auto getETag() -> QString { return m_etag; }
     void setETag(QString etag) { m_etag = etag; }
@@ -84,6 +97,8 @@ class MetaEntry {
     QString m_etag;
 
     qint64 m_local_changed_timestamp = 0;
+    // the file is only rehashed when this doesn't match anymore
+    FS::FileFingerprint m_local_fingerprint;
     QString m_remote_changed_timestamp;  // QString for now, RFC 2822 encoded time
     qint64 m_current_age = 0;
     qint64 m_max_age = 0;
@@ -96,6 +111,8 @@ using MetaEntryPtr = std::shared_ptr<MetaEntry>;
 
 class HttpMetaCache : public QObject {
     Q_OBJECT
+    friend class Net::MetaCacheVerifyTask;
+
    public:
     // supply path to the cache index file
     HttpMetaCache(QString path = QString());
@@ -123,6 +140,9 @@ class HttpMetaCache : public QObject {
 
     auto getBasePath(QString base) -> QString;
 
+    // md5sum of the file, read in chunks. empty if it can't be read
+    static auto hashFile(const QString& path) -> QString;
+
    public slots:
     void SaveNow();
 
@@ -130,12 +150,31 @@ class HttpMetaCache : public QObject {
     // create a new stale entry, given the parameters
     auto staleEntry(QString base, QString resource_path) -> MetaEntryPtr;
 
+    // disown the entry, also in the on-disk index
+    void removeEntry(const QString& base, const QString& resource_path);
+    void markDirty(const QString& base, const QString& resource_path);
+
+    auto entryFromRecord(const MetaCacheRecord& record) -> MetaEntryPtr;
+    static auto recordFromEntry(const MetaEntryPtr& entry) -> MetaCacheRecord;
+
+    // reads the old version 1 JSON index
+    void loadJson();
+    // writes a new snapshot of the index with all the known entries
+    void compact();
+
     struct EntryMap {
         QString base_path;
+        // entries used in this session, loaded from the index on demand. null for removed entries
         QMap<QString, MetaEntryPtr> entry_list;
     };
 
     QMap<QString, EntryMap> m_entries;
     QString m_index_file;
     QTimer saveBatchingTimer;
+
+    std::unique_ptr<MetaCacheIndex> m_index;
+    // changed entries that still need to be written to the journal, per base
+    QMap<QString, QSet<QString>> m_dirty;
+    // set by evictAll, the snapshot must not be used anymore
+    bool m_dropSnapshot = false;
 };
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LzmaFileSink.h"
+
+#include <lzma.h>
+
+#include "net/Logging.h"
+
+namespace Net {
+
+struct LzmaFileSink::Private {
+    lzma_stream strm = LZMA_STREAM_INIT;
+    bool initialized = false;
+    bool streamEnded = false;
+    QByteArray buffer;
+};
+
+LzmaFileSink::LzmaFileSink(QString filename) : FileSink(filename), d(new Private)
+{
+    d->buffer.resize(64 * 1024);
+}
+
+LzmaFileSink::~LzmaFileSink()
+{
+    lzma_end(&d->strm);
+}
+
+void LzmaFileSink::resetDecoder()
+{
+    lzma_end(&d->strm);
+    d->strm = LZMA_STREAM_INIT;
+    d->streamEnded = false;
+    // accepts both the legacy .lzma format used by Mojang and .xz
+    d->initialized = lzma_auto_decoder(&d->strm, UINT64_MAX, 0) == LZMA_OK;
+}
+
+Task::State LzmaFileSink::init(QNetworkRequest& request)
+{
+    resetDecoder();
+    if (!d->initialized) {
+        qCCritical(taskNetLogC) << "Could not initialize the lzma decoder for " + m_filename;
+        return Task::State::Failed;
+    }
+    return FileSink::init(request);
+}
+
+Task::State LzmaFileSink::write(QByteArray& data)
+{
+    if (d->streamEnded) {
+        qCCritical(taskNetLogC) << "Unexpected data after the end of the lzma stream for " + m_filename;
+        return Task::State::Failed;
+    }
+    d->strm.next_in = reinterpret_cast<const uint8_t*>(data.constData());
+    d->strm.avail_in = data.size();
+    do {
+        d->strm.next_out = reinterpret_cast<uint8_t*>(d->buffer.data());
+        d->strm.avail_out = d->buffer.size();
+        auto ret = lzma_code(&d->strm, LZMA_RUN);
+        if (ret != LZMA_OK && ret != LZMA_STREAM_END && ret != LZMA_BUF_ERROR) {
+            qCCritical(taskNetLogC) << "Failed to decompress" << m_filename << "lzma error:" << ret;
+            return Task::State::Failed;
+        }
+        auto produced = d->buffer.size() - static_cast<qint64>(d->strm.avail_out);
+        if (produced > 0) {
+            QByteArray chunk = QByteArray::fromRawData(d->buffer.constData(), produced);
+            auto state = FileSink::write(chunk);
+            if (state != Task::State::Running)
+                return state;
+        }
+        if (ret == LZMA_STREAM_END) {
+            d->streamEnded = true;
+            break;
+        }
+        if (ret == LZMA_BUF_ERROR)  // no progress possible, wait for more input
+            break;
+    } while (d->strm.avail_in > 0 || d->strm.avail_out == 0);
+    return Task::State::Running;
+}
+
+Task::State LzmaFileSink::abort()
+{
+    lzma_end(&d->strm);
+    d->strm = LZMA_STREAM_INIT;
+    d->initialized = false;
+    return FileSink::abort();
+}
+
+Task::State LzmaFileSink::finalize(QNetworkReply& reply)
+{
+    // a truncated stream must not be committed, even if the server claims success
+    if (wroteAnyData && !d->streamEnded) {
+        qCCritical(taskNetLogC) << "The lzma stream for " + m_filename + " is truncated";
+        m_output_file->cancelWriting();
+        return Task::State::Failed;
+    }
+    return FileSink::finalize(reply);
+}
+}  // namespace Net
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "FileSink.h"
+
+namespace Net {
+
+/*
+ * File sink for .lzma/.xz compressed downloads.
+ * The response is decompressed on the fly, so the file on disk and the validators only ever see the uncompressed data.
+ */
+class LzmaFileSink : public FileSink {
+   public:
+    LzmaFileSink(QString filename);
+    virtual ~LzmaFileSink();
+
+   public:
+    auto init(QNetworkRequest& request) -> Task::State override;
+    auto write(QByteArray& data) -> Task::State override;
+    auto abort() -> Task::State override;
+    auto finalize(QNetworkReply& reply) -> Task::State override;
+
+   private:
+    void resetDecoder();
+
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+}  // namespace Net
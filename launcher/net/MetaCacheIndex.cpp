@@ -0,0 +1,352 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MetaCacheIndex.h"
+
+#include <QDataStream>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <cstring>
+
+#include "net/Logging.h"
+
+namespace {
+constexpr char s_magic[4] = { 'P', 'M', 'C', 'I' };
+constexpr quint32 s_version = 1;
+constexpr qint64 s_headerSize = 16;
+constexpr qint64 s_bucketSize = 16;
+
+enum class JournalOp : quint8 { Put = 1, Remove = 2 };
+
+quint64 hashKey(const QByteArray& base, const QByteArray& path)
+{
+    // FNV-1a, it needs to be stable across runs so qHash is not an option
+    quint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](const QByteArray& data) {
+        for (auto c : data) {
+            hash ^= static_cast<quint8>(c);
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(base);
+    hash *= 1099511628211ULL;  // the '\0' separator
+    mix(path);
+    return hash;
+}
+
+void appendString(QByteArray& out, const QString& value)
+{
+    auto utf8 = value.toUtf8();
+    char length[4];
+    qToLittleEndian<quint32>(utf8.size(), length);
+    out.append(length, 4);
+    out.append(utf8);
+}
+
+void appendInt(QByteArray& out, qint64 value)
+{
+    char data[8];
+    qToLittleEndian<qint64>(value, data);
+    out.append(data, 8);
+}
+
+// bounds checked reader over the mapped snapshot
+class Reader {
+   public:
+    Reader(const uchar* data, qint64 size, qint64 pos) : m_data(data), m_size(size), m_pos(pos) {}
+
+    bool ok() const { return m_ok; }
+
+    QByteArray bytes()
+    {
+        auto length = u32();
+        if (!m_ok || m_pos + length > m_size) {
+            m_ok = false;
+            return {};
+        }
+        auto result = QByteArray::fromRawData(reinterpret_cast<const char*>(m_data + m_pos), length);
+        m_pos += length;
+        return result;
+    }
+    QString string() { return QString::fromUtf8(bytes()); }
+    quint32 u32()
+    {
+        if (!m_ok || m_pos + 4 > m_size) {
+            m_ok = false;
+            return 0;
+        }
+        auto value = qFromLittleEndian<quint32>(m_data + m_pos);
+        m_pos += 4;
+        return value;
+    }
+    qint64 i64()
+    {
+        if (!m_ok || m_pos + 8 > m_size) {
+            m_ok = false;
+            return 0;
+        }
+        auto value = qFromLittleEndian<qint64>(m_data + m_pos);
+        m_pos += 8;
+        return value;
+    }
+    quint8 u8()
+    {
+        if (!m_ok || m_pos + 1 > m_size) {
+            m_ok = false;
+            return 0;
+        }
+        return m_data[m_pos++];
+    }
+
+   private:
+    const uchar* m_data;
+    qint64 m_size;
+    qint64 m_pos;
+    bool m_ok = true;
+};
+}  // namespace
+
+MetaCacheIndex::MetaCacheIndex(QString path) : m_snapshotPath(path + ".idx"), m_journalPath(path + ".journal") {}
+
+MetaCacheIndex::~MetaCacheIndex()
+{
+    close();
+}
+
+bool MetaCacheIndex::open()
+{
+    close();
+    m_snapshot.setFileName(m_snapshotPath);
+    if (!m_snapshot.open(QIODevice::ReadOnly))
+        return false;
+    m_dataSize = m_snapshot.size();
+    if (m_dataSize < s_headerSize) {
+        m_snapshot.close();
+        return false;
+    }
+    m_data = m_snapshot.map(0, m_dataSize);
+    if (!m_data) {
+        qCWarning(taskHttpMetaCacheLogC) << "Failed to map" << m_snapshotPath << ":" << m_snapshot.errorString();
+        m_snapshot.close();
+        return false;
+    }
+
+    Reader header(m_data, m_dataSize, 4);
+    auto version = header.u32();
+    m_count = header.u32();
+    m_bucketCount = header.u32();
+    bool valid = memcmp(m_data, s_magic, 4) == 0 && version == s_version && header.ok() && m_bucketCount > 0 &&
+                 (m_bucketCount & (m_bucketCount - 1)) == 0 && s_headerSize + m_bucketCount * s_bucketSize <= m_dataSize;
+    if (!valid) {
+        qCWarning(taskHttpMetaCacheLogC) << "Ignoring invalid metacache index" << m_snapshotPath;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MetaCacheIndex::close()
+{
+    if (m_data)
+        m_snapshot.unmap(m_data);
+    m_data = nullptr;
+    m_dataSize = 0;
+    m_count = 0;
+    m_bucketCount = 0;
+    m_snapshot.close();
+}
+
+bool MetaCacheIndex::readRecord(quint64 offset, MetaCacheRecord& out) const
+{
+    Reader reader(m_data, m_dataSize, offset);
+    out.base = reader.string();
+    out.path = reader.string();
+    out.md5sum = reader.string();
+    out.etag = reader.string();
+    out.remoteChangedTimestamp = reader.string();
+    out.localChangedTimestamp = reader.i64();
+    out.currentAge = reader.i64();
+    out.maxAge = reader.i64();
+    out.eternal = reader.u8() & 1;
+    out.size = reader.i64();
+    out.inode = static_cast<quint64>(reader.i64());
+    out.metadataChangedTimestamp = reader.i64();
+    return reader.ok();
+}
+
+bool MetaCacheIndex::find(const QString& base, const QString& path, MetaCacheRecord& out) const
+{
+    if (!isOpen())
+        return false;
+    auto baseUtf8 = base.toUtf8();
+    auto pathUtf8 = path.toUtf8();
+    auto hash = hashKey(baseUtf8, pathUtf8);
+    auto mask = m_bucketCount - 1;
+    for (quint32 probe = 0; probe < m_bucketCount; probe++) {
+        auto bucket = m_data + s_headerSize + ((hash + probe) & mask) * s_bucketSize;
+        auto offset = qFromLittleEndian<quint64>(bucket + 8);
+        if (offset == 0)
+            return false;
+        if (qFromLittleEndian<quint64>(bucket) != hash)
+            continue;
+        // compare the keys before decoding the whole record
+        Reader reader(m_data, m_dataSize, offset);
+        if (reader.bytes() == baseUtf8 && reader.bytes() == pathUtf8 && reader.ok())
+            return readRecord(offset, out);
+    }
+    return false;
+}
+
+QList<MetaCacheRecord> MetaCacheIndex::records() const
+{
+    QList<MetaCacheRecord> result;
+    if (!isOpen())
+        return result;
+    result.reserve(m_count);
+    for (quint32 i = 0; i < m_bucketCount; i++) {
+        auto offset = qFromLittleEndian<quint64>(m_data + s_headerSize + i * s_bucketSize + 8);
+        MetaCacheRecord record;
+        if (offset != 0 && readRecord(offset, record))
+            result.append(record);
+    }
+    return result;
+}
+
+QList<MetaCacheJournalEntry> MetaCacheIndex::readJournal()
+{
+    QList<MetaCacheJournalEntry> result;
+    QFile journal(m_journalPath);
+    if (!journal.open(QIODevice::ReadOnly)) {
+        m_journalLength = 0;
+        return result;
+    }
+    QDataStream in(&journal);
+    in.setVersion(QDataStream::Qt_5_12);
+    qint64 lastGood = 0;
+    while (!in.atEnd()) {
+        quint8 op;
+        MetaCacheJournalEntry entry;
+        auto& record = entry.record;
+        in >> op >> record.base >> record.path;
+        entry.removed = JournalOp(op) == JournalOp::Remove;
+        if (!entry.removed) {
+            in >> record.md5sum >> record.etag >> record.remoteChangedTimestamp >> record.localChangedTimestamp >> record.currentAge >>
+                record.maxAge >> record.eternal >> record.size >> record.inode >> record.metadataChangedTimestamp;
+        }
+        if (in.status() != QDataStream::Ok)
+            break;
+        result.append(entry);
+        lastGood = journal.pos();
+    }
+    auto journalSize = journal.size();
+    journal.close();
+
+    // a torn write at the end of the journal is dropped. cut it off, or every later append would end up behind it and be lost
+    if (lastGood < journalSize) {
+        qCWarning(taskHttpMetaCacheLogC) << "Dropping" << journalSize - lastGood << "bytes of torn data at the end of" << m_journalPath;
+        if (!QFile::resize(m_journalPath, lastGood)) {
+            qCWarning(taskHttpMetaCacheLogC) << "Failed to truncate" << m_journalPath << ", removing it";
+            QFile::remove(m_journalPath);
+            result.clear();
+        }
+    }
+    m_journalLength = result.size();
+    return result;
+}
+
+bool MetaCacheIndex::appendToJournal(const QList<MetaCacheJournalEntry>& entries)
+{
+    if (entries.isEmpty())
+        return true;
+    QFile journal(m_journalPath);
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(taskHttpMetaCacheLogC) << "Failed to open" << m_journalPath << ":" << journal.errorString();
+        return false;
+    }
+    QDataStream out(&journal);
+    out.setVersion(QDataStream::Qt_5_12);
+    for (auto& entry : entries) {
+        auto& record = entry.record;
+        out << quint8(entry.removed ? JournalOp::Remove : JournalOp::Put) << record.base << record.path;
+        if (!entry.removed) {
+            out << record.md5sum << record.etag << record.remoteChangedTimestamp << record.localChangedTimestamp << record.currentAge
+                << record.maxAge << record.eternal << record.size << record.inode << record.metadataChangedTimestamp;
+        }
+    }
+    m_journalLength += entries.size();
+    return out.status() == QDataStream::Ok && journal.flush();
+}
+
+bool MetaCacheIndex::compact(const QList<MetaCacheRecord>& records)
+{
+    // keep the table at most half full so probing stays short
+    quint32 bucketCount = 16;
+    while (bucketCount < static_cast<quint32>(records.size()) * 2)
+        bucketCount *= 2;
+
+    QByteArray buckets(bucketCount * s_bucketSize, '\0');
+    QByteArray data;
+    qint64 dataOffset = s_headerSize + buckets.size();
+    auto mask = bucketCount - 1;
+    for (auto& record : records) {
+        auto hash = hashKey(record.base.toUtf8(), record.path.toUtf8());
+        auto index = hash & mask;
+        while (qFromLittleEndian<quint64>(buckets.constData() + index * s_bucketSize + 8) != 0)
+            index = (index + 1) & mask;
+        qToLittleEndian<quint64>(hash, buckets.data() + index * s_bucketSize);
+        qToLittleEndian<quint64>(dataOffset + data.size(), buckets.data() + index * s_bucketSize + 8);
+
+        appendString(data, record.base);
+        appendString(data, record.path);
+        appendString(data, record.md5sum);
+        appendString(data, record.etag);
+        appendString(data, record.remoteChangedTimestamp);
+        appendInt(data, record.localChangedTimestamp);
+        appendInt(data, record.currentAge);
+        appendInt(data, record.maxAge);
+        data.append(char(record.eternal ? 1 : 0));
+        appendInt(data, record.size);
+        appendInt(data, static_cast<qint64>(record.inode));
+        appendInt(data, record.metadataChangedTimestamp);
+    }
+
+    QByteArray header(s_magic, 4);
+    char value[4];
+    for (auto field : { s_version, static_cast<quint32>(records.size()), bucketCount }) {
+        qToLittleEndian<quint32>(field, value);
+        header.append(value, 4);
+    }
+
+    QSaveFile file(m_snapshotPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(header) != header.size() || file.write(buckets) != buckets.size() ||
+        file.write(data) != data.size()) {
+        qCWarning(taskHttpMetaCacheLogC) << "Failed to write" << m_snapshotPath << ":" << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+    // the old snapshot can't be replaced while it is mapped on some platforms
+    close();
+    if (!file.commit()) {
+        qCWarning(taskHttpMetaCacheLogC) << "Failed to commit" << m_snapshotPath << ":" << file.errorString();
+        open();
+        return false;
+    }
+    QFile::remove(m_journalPath);
+    m_journalLength = 0;
+    return open();
+}
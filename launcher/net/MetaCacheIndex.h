@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QList>
+#include <QString>
+
+struct MetaCacheRecord {
+    QString base;
+    QString path;
+    QString md5sum;
+    QString etag;
+    QString remoteChangedTimestamp;
+    qint64 localChangedTimestamp = 0;
+    qint64 currentAge = 0;
+    qint64 maxAge = 0;
+    bool eternal = false;
+    // fingerprint of the local file, size is -1 if none was recorded
+    qint64 size = -1;
+    quint64 inode = 0;
+    qint64 metadataChangedTimestamp = 0;
+};
+
+struct MetaCacheJournalEntry {
+    bool removed = false;  // only base and path of the record are meaningful for removals
+    MetaCacheRecord record;
+};
+
+/* MetaCacheIndex
+ * On-disk storage of the HttpMetaCache entries.
+ *
+ * The snapshot (`<path>.idx`) is memory mapped and never parsed as a whole:
+ *   header:  "PMCI" | u32 version | u32 entry count | u32 bucket count
+ *   buckets: bucket count x { u64 key hash | u64 record offset (0 = empty) }, open addressing with linear probing
+ *   records: u32 length prefixed UTF-8 strings (base, path, md5sum, etag, remote timestamp),
+ *            i64 local timestamp, i64 current age, i64 max age, u8 flags,
+ *            i64 size, u64 inode, i64 metadata change timestamp
+ * All integers are little endian and the key hash is FNV-1a over "base\0path".
+ *
+ * Changes are appended to the journal (`<path>.journal`) and folded back into a new snapshot by compact().
+ */
+class MetaCacheIndex {
+   public:
+    explicit MetaCacheIndex(QString path);
+    ~MetaCacheIndex();
+
+    /// maps the snapshot, returns false if it doesn't exist or is not valid
+    bool open();
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    /// number of entries in the snapshot
+    quint32 size() const { return m_count; }
+
+    bool find(const QString& base, const QString& path, MetaCacheRecord& out) const;
+    QList<MetaCacheRecord> records() const;
+
+    /// reads the journal back, a torn record at its end is cut off so later appends can be read again
+    QList<MetaCacheJournalEntry> readJournal();
+    bool appendToJournal(const QList<MetaCacheJournalEntry>& entries);
+    /// number of entries appended to the journal since the last compaction
+    int journalLength() const { return m_journalLength; }
+
+    /// replaces the snapshot with the given records and empties the journal
+    bool compact(const QList<MetaCacheRecord>& records);
+
+   private:
+    bool readRecord(quint64 offset, MetaCacheRecord& out) const;
+
+   private:
+    QString m_snapshotPath;
+    QString m_journalPath;
+    QFile m_snapshot;
+    uchar* m_data = nullptr;
+    qint64 m_dataSize = 0;
+    quint32 m_count = 0;
+    quint32 m_bucketCount = 0;
+    int m_journalLength = 0;
+};
@@ -88,7 +88,7 @@ Task::State MetaCacheSink::finalizeCache(QNetworkReply& reply)
         m_entry->setRemoteChangedTimestamp(reply.rawHeader("Last-Modified").constData());
     }
 
-    m_entry->setLocalChangedTimestamp(output_file_info.lastModified().toUTC().toMSecsSinceEpoch());
+    m_entry->setLocalFingerprint(FS::fingerprint(output_file_info));
 
     {  // Cache lifetime
         if (m_is_eternal) {
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MetaCacheVerifyTask.h"
+
+#include <QFileInfo>
+#include <QtConcurrentMap>
+
+#include "net/Logging.h"
+
+namespace Net {
+
+namespace {
+MetaCacheVerifyTask::Check verify(MetaCacheVerifyTask::Check check)
+{
+    check.fingerprint = FS::fingerprint(QFileInfo(check.path));
+    // unchanged, missing or of a different size, resolveEntry can tell without hashing
+    if (check.fingerprint == check.expected || !check.fingerprint.isValid() || check.fingerprint.size != check.expected.size)
+        return check;
+    check.md5sum = HttpMetaCache::hashFile(check.path);
+    check.hashed = true;
+    return check;
+}
+}  // namespace
+
+MetaCacheVerifyTask::MetaCacheVerifyTask(HttpMetaCache* cache, QString base, QStringList resource_paths)
+    : m_cache(cache), m_base(base), m_paths(resource_paths)
+{}
+
+void MetaCacheVerifyTask::executeTask()
+{
+    setStatus(tr("Verifying cached files..."));
+
+    QList<Check> checks;
+    for (auto& path : m_paths) {
+        auto entry = m_cache->getEntry(m_base, FS::RemoveInvalidPathChars(path));
+        // entries without a fingerprint are upgraded by resolveEntry
+        if (!entry || entry->isStale() || !entry->m_local_fingerprint.isValid())
+            continue;
+        Check check;
+        check.entry = entry;
+        check.path = FS::PathCombine(m_cache->getBasePath(m_base), entry->m_relativePath);
+        check.expected = entry->m_local_fingerprint;
+        checks.append(check);
+    }
+    if (checks.isEmpty()) {
+        emitSucceeded();
+        return;
+    }
+
+    m_future = QtConcurrent::mapped(QThreadPool::globalInstance(), checks, verify);
+    connect(&m_watcher, &QFutureWatcher<Check>::finished, this, [this] {
+        if (m_future.isCanceled()) {
+            emitAborted();
+            return;
+        }
+        applyResults();
+        emitSucceeded();
+    });
+    m_watcher.setFuture(m_future);
+}
+
+void MetaCacheVerifyTask::applyResults()
+{
+    int rehashed = 0;
+    int removed = 0;
+    for (auto& check : m_future.results()) {
+        auto& entry = check.entry;
+        // only the hashed ones need an update, and only if nobody touched the entry in the meantime
+        if (!check.hashed || entry->isStale() || entry->m_local_fingerprint != check.expected)
+            continue;
+        rehashed++;
+        if (check.md5sum.isEmpty() || check.md5sum != entry->m_md5sum) {
+            if (m_cache->getEntry(m_base, entry->m_relativePath) == entry) {
+                m_cache->removeEntry(m_base, entry->m_relativePath);
+                removed++;
+            }
+            continue;
+        }
+        entry->setLocalFingerprint(check.fingerprint);
+        m_cache->markDirty(m_base, entry->m_relativePath);
+    }
+    if (rehashed > 0) {
+        qCDebug(taskHttpMetaCacheLogC) << "Rehashed" << rehashed << "changed files in" << m_base << "," << removed << "no longer match";
+        m_cache->SaveEventually();
+    }
+}
+
+bool MetaCacheVerifyTask::abort()
+{
+    if (m_future.isRunning()) {
+        m_future.cancel();
+        // NOTE: emitAborted() is called once the future actually got canceled
+        return true;
+    }
+    return false;
+}
+}  // namespace Net
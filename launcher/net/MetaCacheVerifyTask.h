@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QStringList>
+
+#include "net/HttpMetaCache.h"
+#include "tasks/Task.h"
+
+namespace Net {
+
+/*
+ * Checks the files of many cache entries against their fingerprints at once, on the worker pool.
+ * Files that changed on disk are rehashed there too, so the resolveEntry calls that follow don't block on hashing.
+ * Entries whose content doesn't match anymore are removed from the cache.
+ */
+class MetaCacheVerifyTask : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<MetaCacheVerifyTask>;
+
+    MetaCacheVerifyTask(HttpMetaCache* cache, QString base, QStringList resource_paths);
+    virtual ~MetaCacheVerifyTask() = default;
+
+    bool abort() override;
+
+    struct Check {
+        MetaEntryPtr entry;  // only touched on the cache's thread
+        QString path;
+        QString md5sum;
+        FS::FileFingerprint expected;
+        FS::FileFingerprint fingerprint;
+        bool hashed = false;
+    };
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void applyResults();
+
+   private:
+    HttpMetaCache* m_cache;
+    QString m_base;
+    QStringList m_paths;
+
+    QFuture<Check> m_future;
+    QFutureWatcher<Check> m_watcher;
+};
+}  // namespace Net
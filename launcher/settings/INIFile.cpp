@@ -32,44 +32,706 @@
  *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
  *      See the License for the specific language governing permissions and
  *      limitations under the License.
+ *
+ * The INI reading and escaping code (readIniLine, unescapeKey, unescapeValue, escapeKey, escapeString,
+ * variantToString and stringToVariant) is adapted from qtbase/src/corelib/io/qsettings.cpp of Qt 5.15,
+ * which is covered by the following copyright and permission notice:
+ *
+ *      Copyright (C) 2016 The Qt Company Ltd.
+ *      Contact: https://www.qt.io/licensing/
+ *
+ *      This file is part of the QtCore module of the Qt Toolkit.
+ *
+ *      GNU General Public License Usage
+ *      Alternatively, this file may be used under the terms of the GNU
+ *      General Public License version 2.0 or (at your option) the GNU General
+ *      Public license version 3 or any later version approved by the KDE Free
+ *      Qt Foundation. The licenses are as published by the Free Software
+ *      Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+ *      included in the packaging of this file. Please review the following
+ *      information to ensure the GNU General Public License requirements will
+ *      be met: https://www.gnu.org/licenses/gpl-2.0.html and
+ *      https://www.gnu.org/licenses/gpl-3.0.html.
+ *
+ *      It is used here under the terms of the GNU General Public License version 3.
  */
 
 #include "settings/INIFile.h"
 #include <FileSystem.h>
 
+#include <QDataStream>
 #include <QDebug>
 #include <QFile>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
 #include <QStringList>
-#include <QTemporaryFile>
 #include <QTextStream>
 
-#include <QSettings>
+/*
+ * The reader and writer below speak the same dialect as QSettings::IniFormat, so that files stay interchangeable with
+ * older launcher versions and anything else that opens them through QSettings. They work on a single in-memory buffer
+ * instead of round-tripping every key through a QSettings object and its file cache.
+ */
+namespace {
+
+#ifdef Q_OS_WIN
+const char s_eol[] = "\r\n";
+#else
+const char s_eol[] = "\n";
+#endif
 
-INIFile::INIFile() {}
+const char s_hexDigits[] = "0123456789ABCDEF";
 
-bool INIFile::saveFile(QString fileName)
+bool isIniSpace(char c)
 {
-    if (!contains("ConfigVersion"))
-        insert("ConfigVersion", "1.2");
-    QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
-    _settings_obj.setFallbacksEnabled(false);
-    _settings_obj.clear();
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
 
-    for (Iterator iter = begin(); iter != end(); iter++)
-        _settings_obj.setValue(iter.key(), iter.value());
+bool isIniSpecial(char c)
+{
+    return c == '\n' || c == '\r' || c == '"' || c == ';' || c == '=' || c == '\\';
+}
 
-    _settings_obj.sync();
+int digitValue(char c, int base)
+{
+    int value = -1;
+    if (c >= '0' && c <= '9')
+        value = c - '0';
+    else if (c >= 'a' && c <= 'f')
+        value = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+        value = c - 'A' + 10;
+    return value < base ? value : -1;
+}
 
-    if (auto status = _settings_obj.status(); status != QSettings::Status::NoError) {
-        // Shouldn't be possible!
-        Q_ASSERT(status != QSettings::Status::FormatError);
+char decodeEscape(char code)
+{
+    switch (code) {
+        case 'a':
+            return '\a';
+        case 'b':
+            return '\b';
+        case 'f':
+            return '\f';
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 't':
+            return '\t';
+        case 'v':
+            return '\v';
+        case '"':
+        case '?':
+        case '\'':
+        case '\\':
+            return code;
+        default:
+            return 0;
+    }
+}
 
-        if (status == QSettings::Status::AccessError)
-            qCritical() << "An access error occurred (e.g. trying to write to a read-only file).";
+void appendHex(QByteArray& out, uint value)
+{
+    out += "\\x";
+    out += QByteArray::number(value, 16);
+}
 
+void appendUtf8(QByteArray& out, uint cp)
+{
+    if (cp < 0x80) {
+        out += char(cp);
+    } else if (cp < 0x800) {
+        out += char(0xC0 | (cp >> 6));
+        out += char(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += char(0xE0 | (cp >> 12));
+        out += char(0x80 | ((cp >> 6) & 0x3F));
+        out += char(0x80 | (cp & 0x3F));
+    } else {
+        out += char(0xF0 | (cp >> 18));
+        out += char(0x80 | ((cp >> 12) & 0x3F));
+        out += char(0x80 | ((cp >> 6) & 0x3F));
+        out += char(0x80 | (cp & 0x3F));
+    }
+}
+
+void escapeKey(const QString& key, QByteArray& out)
+{
+    for (QChar c : key) {
+        uint ch = c.unicode();
+        if (ch == '/') {
+            out += '\\';
+        } else if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '-' ||
+                   ch == '.') {
+            out += char(ch);
+        } else if (ch <= 0xFF) {
+            out += '%';
+            out += s_hexDigits[ch / 16];
+            out += s_hexDigits[ch % 16];
+        } else {
+            out += "%U";
+            for (int shift = 12; shift >= 0; shift -= 4)
+                out += s_hexDigits[(ch >> shift) & 0xF];
+        }
+    }
+}
+
+void escapeString(const QString& str, QByteArray& out)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    // Qt 6 writes text as UTF-8, Qt 5 (without an INI codec) escapes everything outside of ASCII
+    const bool useUtf8 = !str.startsWith("@ByteArray(") && !str.startsWith("@Variant(") && !str.startsWith("@DateTime(");
+#else
+    const bool useUtf8 = false;
+#endif
+    bool needsQuotes = false;
+    bool escapeNextIfDigit = false;
+    const int startPos = out.size();
+    out.reserve(startPos + str.size() * 3 / 2);
+
+    for (int i = 0; i < str.size(); ++i) {
+        uint ch = str.at(i).unicode();
+        if (ch == ';' || ch == ',' || ch == '=')
+            needsQuotes = true;
+
+        if (escapeNextIfDigit && ch < 0x80 && digitValue(char(ch), 16) >= 0) {
+            appendHex(out, ch);
+            continue;
+        }
+        escapeNextIfDigit = false;
+
+        switch (ch) {
+            case '\0':
+                out += "\\0";
+                escapeNextIfDigit = true;
+                break;
+            case '\a':
+                out += "\\a";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            case '\v':
+                out += "\\v";
+                break;
+            case '"':
+            case '\\':
+                out += '\\';
+                out += char(ch);
+                break;
+            default:
+                if (ch <= 0x1F || (ch >= 0x7F && !useUtf8)) {
+                    appendHex(out, ch);
+                    escapeNextIfDigit = true;
+                } else if (QChar::isHighSurrogate(ch) && i + 1 < str.size() && str.at(i + 1).isLowSurrogate()) {
+                    appendUtf8(out, QChar::surrogateToUcs4(ushort(ch), str.at(++i).unicode()));
+                } else {
+                    appendUtf8(out, ch);
+                }
+        }
+    }
+
+    if (needsQuotes || (startPos < out.size() && (out.at(startPos) == ' ' || out.at(out.size() - 1) == ' '))) {
+        out.insert(startPos, '"');
+        out += '"';
+    }
+}
+
+QString variantToString(const QVariant& v)
+{
+    QString result;
+    switch (v.userType()) {
+        case QMetaType::UnknownType:
+            result = "@Invalid()";
+            break;
+        case QMetaType::QByteArray: {
+            const QByteArray a = v.toByteArray();
+            result = QString("@ByteArray(") + QLatin1String(a.constData(), a.size()) + ')';
+            break;
+        }
+        case QMetaType::QString:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::Bool:
+        case QMetaType::Double:
+        case QMetaType::QKeySequence:
+            result = v.toString();
+            if (result.contains(QChar::Null))
+                result = "@String(" + result + ')';
+            else if (result.startsWith('@'))
+                result.prepend('@');
+            break;
+        case QMetaType::QRect: {
+            const QRect r = v.toRect();
+            result = QString("@Rect(%1 %2 %3 %4)").arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height());
+            break;
+        }
+        case QMetaType::QSize: {
+            const QSize s = v.toSize();
+            result = QString("@Size(%1 %2)").arg(s.width()).arg(s.height());
+            break;
+        }
+        case QMetaType::QPoint: {
+            const QPoint p = v.toPoint();
+            result = QString("@Point(%1 %2)").arg(p.x()).arg(p.y());
+            break;
+        }
+        default: {
+            const bool isDateTime = v.userType() == QMetaType::QDateTime;
+            QByteArray a;
+            {
+                QDataStream s(&a, QIODevice::WriteOnly);
+                s.setVersion(isDateTime ? QDataStream::Qt_5_6 : QDataStream::Qt_4_0);
+                s << v;
+            }
+            result = QString(isDateTime ? "@DateTime(" : "@Variant(") + QLatin1String(a.constData(), a.size()) + ')';
+        }
+    }
+    return result;
+}
+
+void escapeValue(const QVariant& value, QByteArray& out)
+{
+    if (value.userType() == QMetaType::QStringList || (value.userType() == QMetaType::QVariantList && value.toList().size() != 1)) {
+        const QVariantList list = value.toList();
+        // an empty list has to stay distinguishable from a list holding one empty string
+        if (list.isEmpty())
+            out += "@Invalid()";
+        for (int i = 0; i < list.size(); ++i) {
+            if (i != 0)
+                out += ", ";
+            escapeString(variantToString(list.at(i)), out);
+        }
+    } else {
+        escapeString(variantToString(value), out);
+    }
+}
+
+QByteArray serialize(const QMap<QString, QVariant>& values)
+{
+    // "group/key" lands in [group], everything without a slash in [General], which always comes first
+    QMap<QString, QList<std::pair<QString, const QVariant*>>> sections;
+    for (auto it = values.cbegin(); it != values.cend(); ++it) {
+        const int slash = it.key().indexOf('/');
+        if (slash == -1)
+            sections[QString()].append({ it.key(), &it.value() });
+        else
+            sections[it.key().left(slash)].append({ it.key().mid(slash + 1), &it.value() });
+    }
+
+    QByteArray out;
+    out.reserve(values.size() * 32);
+    for (auto section = sections.cbegin(); section != sections.cend(); ++section) {
+        QByteArray header;
+        escapeKey(section.key(), header);
+        if (header.isEmpty()) {
+            header = "[General]";
+        } else if (qstricmp(header.constData(), "general") == 0) {
+            header = "[%General]";
+        } else {
+            header.prepend('[');
+            header.append(']');
+        }
+        if (section != sections.cbegin())
+            out += s_eol;
+        out += header;
+        out += s_eol;
+
+        for (const auto& [key, value] : section.value()) {
+            escapeKey(key, out);
+            out += '=';
+            escapeValue(*value, out);
+            out += s_eol;
+        }
+    }
+    return out;
+}
+
+void unescapeKey(const QByteArray& data, int from, int to, QString& result)
+{
+    result.reserve(result.size() + (to - from));
+    int i = from;
+    while (i < to) {
+        const char ch = data.at(i);
+        if (ch == '\\') {
+            result += '/';
+            ++i;
+            continue;
+        }
+        if (ch != '%' || i == to - 1) {
+            result += QLatin1Char(ch);
+            ++i;
+            continue;
+        }
+
+        int numDigits = 2;
+        int firstDigitPos = i + 1;
+        if (data.at(firstDigitPos) == 'U') {
+            ++firstDigitPos;
+            numDigits = 4;
+        }
+        bool ok = firstDigitPos + numDigits <= to;
+        const int code = ok ? data.mid(firstDigitPos, numDigits).toInt(&ok, 16) : 0;
+        if (!ok) {
+            result += '%';
+            ++i;
+            continue;
+        }
+        result += QChar(ushort(code));
+        i = firstDigitPos + numDigits;
+    }
+}
+
+void chopTrailingSpaces(QString& str, int limit)
+{
+    int n = str.size();
+    while (n > limit && (str.at(n - 1) == ' ' || str.at(n - 1) == '\t'))
+        --n;
+    str.truncate(n);
+}
+
+// Decodes the value part of a line. Returns true if it is a comma separated list, which then ends up in listResult.
+bool unescapeValue(const QByteArray& data, int from, int to, QString& stringResult, QStringList& listResult)
+{
+    bool isStringList = false;
+    bool inQuotedString = false;
+    bool currentValueIsQuoted = false;
+    // escapes and quoted text are never trimmed, chopLimit marks where plain trailing text starts
+    int chopLimit = 0;
+    bool chopAtEnd = true;
+    int i = from;
+
+    const auto skipSpaces = [&] {
+        while (i < to && (data.at(i) == ' ' || data.at(i) == '\t'))
+            ++i;
+        chopLimit = stringResult.size();
+    };
+    // reads the remaining digits of a \x or octal escape, returns false if the value ended with it
+    const auto readNumericEscape = [&](int base, int value) {
+        while (i < to) {
+            const int digit = digitValue(data.at(i), base);
+            if (digit < 0) {
+                stringResult += QChar(ushort(value));
+                chopLimit = stringResult.size();
+                return true;
+            }
+            value = (value * base + digit) & 0xFFFF;
+            ++i;
+        }
+        stringResult += QChar(ushort(value));
         return false;
+    };
+
+    skipSpaces();
+    while (i < to) {
+        const char ch = data.at(i);
+        if (ch == '\\') {
+            if (++i >= to) {
+                chopAtEnd = false;
+                break;
+            }
+            const char code = data.at(i++);
+            if (const char decoded = decodeEscape(code)) {
+                stringResult += QLatin1Char(decoded);
+                chopLimit = stringResult.size();
+                continue;
+            }
+            if (code == 'x') {
+                if (i >= to) {
+                    chopAtEnd = false;
+                    break;
+                }
+                if (digitValue(data.at(i), 16) >= 0) {
+                    if (!readNumericEscape(16, 0)) {
+                        chopAtEnd = false;
+                        break;
+                    }
+                    continue;
+                }
+            } else if (code >= '0' && code <= '7') {
+                if (!readNumericEscape(8, code - '0')) {
+                    chopAtEnd = false;
+                    break;
+                }
+                continue;
+            } else if (code == '\n' || code == '\r') {
+                // an escaped line break, \r\n and \n\r count as one
+                if (i < to && (data.at(i) == '\n' || data.at(i) == '\r') && data.at(i) != code)
+                    ++i;
+            }
+            // anything else is dropped together with its backslash
+            chopLimit = stringResult.size();
+            continue;
+        }
+
+        if (ch == '"') {
+            ++i;
+            currentValueIsQuoted = true;
+            inQuotedString = !inQuotedString;
+            if (!inQuotedString)
+                skipSpaces();
+            continue;
+        }
+
+        if (ch == ',' && !inQuotedString) {
+            if (!currentValueIsQuoted)
+                chopTrailingSpaces(stringResult, chopLimit);
+            if (!isStringList) {
+                isStringList = true;
+                listResult.clear();
+            }
+            listResult.append(stringResult);
+            stringResult.clear();
+            currentValueIsQuoted = false;
+            ++i;
+            skipSpaces();
+            continue;
+        }
+
+        // plain text up to the next character with a meaning, appended without a temporary if it is ASCII
+        int j = i + 1;
+        bool ascii = uchar(ch) < 0x80;
+        while (j < to) {
+            const char c = data.at(j);
+            if (c == '\\' || c == '"' || c == ',')
+                break;
+            ascii = ascii && uchar(c) < 0x80;
+            ++j;
+        }
+        // QSettings on Qt 5 took raw bytes as Latin-1, Qt 6 takes them as UTF-8. Qt 5 escaped everything outside of ASCII when
+        // writing, so raw bytes come from Qt 6 builds or from editing the file by hand, and UTF-8 is right for both
+        if (ascii)
+            stringResult += QLatin1String(data.constData() + i, j - i);
+        else
+            stringResult += QString::fromUtf8(data.constData() + i, j - i);
+        i = j;
+    }
+
+    if (chopAtEnd && !currentValueIsQuoted)
+        chopTrailingSpaces(stringResult, chopLimit);
+    if (isStringList)
+        listResult.append(stringResult);
+    return isStringList;
+}
+
+QStringList splitArgs(const QString& s, int idx)
+{
+    return s.mid(idx, s.size() - idx - 1).split(' ', Qt::SkipEmptyParts);
+}
+
+QVariant stringToVariant(const QString& s)
+{
+    if (!s.startsWith('@'))
+        return QVariant(s);
+
+    if (s.endsWith(')')) {
+        if (s.startsWith("@ByteArray(")) {
+            return QVariant(s.mid(11, s.size() - 12).toLatin1());
+        } else if (s.startsWith("@String(")) {
+            return QVariant(s.mid(8, s.size() - 9));
+        } else if (s.startsWith("@Variant(") || s.startsWith("@DateTime(")) {
+            const bool isDateTime = s.at(1) == 'D';
+            const int offset = isDateTime ? 10 : 9;
+            QByteArray a = s.mid(offset).toLatin1();
+            QDataStream stream(&a, QIODevice::ReadOnly);
+            stream.setVersion(isDateTime ? QDataStream::Qt_5_6 : QDataStream::Qt_4_0);
+            QVariant result;
+            stream >> result;
+            return result;
+        } else if (s.startsWith("@Rect(")) {
+            const QStringList args = splitArgs(s, 6);
+            if (args.size() == 4)
+                return QVariant(QRect(args[0].toInt(), args[1].toInt(), args[2].toInt(), args[3].toInt()));
+        } else if (s.startsWith("@Size(")) {
+            const QStringList args = splitArgs(s, 6);
+            if (args.size() == 2)
+                return QVariant(QSize(args[0].toInt(), args[1].toInt()));
+        } else if (s.startsWith("@Point(")) {
+            const QStringList args = splitArgs(s, 7);
+            if (args.size() == 2)
+                return QVariant(QPoint(args[0].toInt(), args[1].toInt()));
+        } else if (s == "@Invalid()") {
+            return QVariant();
+        }
+    }
+    if (s.startsWith("@@"))
+        return QVariant(s.mid(1));
+    return QVariant(s);
+}
+
+QVariant stringListToVariant(const QStringList& list)
+{
+    QStringList strings = list;
+    for (auto& str : strings) {
+        if (!str.startsWith('@'))
+            continue;
+        if (str.size() >= 2 && str.at(1) == '@') {
+            str.remove(0, 1);
+            continue;
+        }
+        // at least one element carries a type, so the whole thing becomes a variant list
+        QVariantList variantList;
+        variantList.reserve(list.size());
+        for (const auto& element : list)
+            variantList.append(stringToVariant(element));
+        return variantList;
+    }
+    return strings;
+}
+
+/*
+ * Finds the next logical line starting at dataPos. Quoted text and escaped line breaks may span multiple physical lines,
+ * comments (starting with ';') are skipped. Returns false once the data is exhausted.
+ */
+bool readIniLine(const QByteArray& data, int& dataPos, int& lineStart, int& lineLen, int& equalsPos)
+{
+    const int dataLen = data.size();
+    bool inQuotes = false;
+    equalsPos = -1;
+
+    lineStart = dataPos;
+    while (lineStart < dataLen && isIniSpace(data.at(lineStart)))
+        ++lineStart;
+
+    int i = lineStart;
+    while (i < dataLen) {
+        char ch = data.at(i);
+        while (!isIniSpecial(ch)) {
+            if (++i == dataLen)
+                goto done;
+            ch = data.at(i);
+        }
+        ++i;
+
+        if (ch == '=') {
+            if (!inQuotes && equalsPos == -1)
+                equalsPos = i - 1;
+        } else if (ch == '\n' || ch == '\r') {
+            if (i == lineStart + 1) {
+                ++lineStart;
+            } else if (!inQuotes) {
+                --i;
+                goto done;
+            }
+        } else if (ch == '\\') {
+            if (i < dataLen) {
+                const char escaped = data.at(i++);
+                if (i < dataLen) {
+                    const char next = data.at(i);
+                    if ((escaped == '\n' && next == '\r') || (escaped == '\r' && next == '\n'))
+                        ++i;
+                }
+            }
+        } else if (ch == '"') {
+            inQuotes = !inQuotes;
+        } else {  // ';'
+            if (i == lineStart + 1) {
+                while (i < dataLen && data.at(i) != '\n' && data.at(i) != '\r')
+                    ++i;
+                while (i < dataLen && isIniSpace(data.at(i)))
+                    ++i;
+                lineStart = i;
+            } else if (!inQuotes) {
+                --i;
+                goto done;
+            }
+        }
     }
 
+done:
+    dataPos = i;
+    lineLen = i - lineStart;
+    return lineLen > 0;
+}
+
+// Parses a whole file. Returns false on lines QSettings would reject, values parsed up to then are still in the map.
+bool parseIni(const QByteArray& data, QMap<QString, QVariant>& values)
+{
+    bool ok = true;
+    int dataPos = data.startsWith("\xef\xbb\xbf") ? 3 : 0;
+    int lineStart;
+    int lineLen;
+    int equalsPos;
+    QString section;
+    QString stringValue;
+    QStringList listValue;
+
+    while (readIniLine(data, dataPos, lineStart, lineLen, equalsPos)) {
+        const char first = data.at(lineStart);
+        if (first == '[') {
+            const int end = data.indexOf(']', lineStart);
+            QByteArray name;
+            if (end == -1 || end >= lineStart + lineLen) {
+                ok = false;
+                name = data.mid(lineStart + 1, lineLen - 1);
+            } else {
+                name = data.mid(lineStart + 1, end - lineStart - 1);
+            }
+            name = name.trimmed();
+
+            section.clear();
+            if (qstricmp(name.constData(), "general") != 0) {
+                if (qstricmp(name.constData(), "%general") == 0)
+                    section = QString::fromLatin1(name.constData() + 1);
+                else
+                    unescapeKey(name, 0, name.size(), section);
+                section += '/';
+            }
+            continue;
+        }
+
+        if (equalsPos == -1) {
+            if (first != ';')
+                ok = false;
+            continue;
+        }
+
+        int keyEnd = equalsPos;
+        while (keyEnd > lineStart && (data.at(keyEnd - 1) == ' ' || data.at(keyEnd - 1) == '\t'))
+            --keyEnd;
+        QString key = section;
+        unescapeKey(data, lineStart, keyEnd, key);
+
+        stringValue.clear();
+        if (unescapeValue(data, equalsPos + 1, lineStart + lineLen, stringValue, listValue))
+            values.insert(key, stringListToVariant(listValue));
+        else
+            values.insert(key, stringToVariant(stringValue));
+    }
+    return ok;
+}
+
+}  // namespace
+
+INIFile::INIFile() {}
+
+bool INIFile::saveFile(QString fileName)
+{
+    if (!contains("ConfigVersion"))
+        insert("ConfigVersion", "1.2");
+
+    try {
+        FS::write(fileName, serialize(*this));
+    } catch (const FS::FileSystemException& e) {
+        qCritical() << "An access error occurred (e.g. trying to write to a read-only file):" << e.cause();
+        return false;
+    }
     return true;
 }
 
@@ -113,9 +775,9 @@ QString unquote(QString str)
     return str;
 }
 
-bool parseOldFileFormat(QIODevice& device, QSettings::SettingsMap& map)
+bool parseOldFileFormat(const QByteArray& data, QMap<QString, QVariant>& map)
 {
-    QTextStream in(device.readAll());
+    QTextStream in(data);
 #if QT_VERSION <= QT_VERSION_CHECK(6, 0, 0)
     in.setCodec("UTF-8");
 #endif
@@ -151,53 +813,45 @@ bool parseOldFileFormat(QIODevice& device, QSettings::SettingsMap& map)
 
 bool INIFile::loadFile(QString fileName)
 {
-    QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
-    _settings_obj.setFallbacksEnabled(false);
-
-    if (auto status = _settings_obj.status(); status != QSettings::Status::NoError) {
-        if (status == QSettings::Status::AccessError)
-            qCritical() << "An access error occurred (e.g. trying to write to a read-only file).";
-        if (status == QSettings::Status::FormatError)
-            qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (file.exists())
+            qCritical() << "Failed to read" << fileName << ":" << file.errorString();
         return false;
     }
-    if (!_settings_obj.value("ConfigVersion").isValid()) {
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly))
-            return false;
-        QSettings::SettingsMap map;
-        parseOldFileFormat(file, map);
-        file.close();
-        for (auto&& key : map.keys())
-            insert(key, map.value(key));
-        insert("ConfigVersion", "1.2");
-    } else if (_settings_obj.value("ConfigVersion").toString() == "1.1") {
-        for (auto&& key : _settings_obj.allKeys()) {
-            if (auto valueStr = _settings_obj.value(key).toString();
-                (valueStr.contains(QChar(';')) || valueStr.contains(QChar('=')) || valueStr.contains(QChar(','))) &&
-                valueStr.endsWith("\"") && valueStr.startsWith("\"")) {
-                insert(key, unquote(valueStr));
-            } else
-                insert(key, _settings_obj.value(key));
-        }
-        insert("ConfigVersion", "1.2");
-    } else
-        for (auto&& key : _settings_obj.allKeys())
-            insert(key, _settings_obj.value(key));
-    return true;
+    return loadFile(file.readAll());
 }
 
 bool INIFile::loadFile(QByteArray data)
 {
-    QTemporaryFile file;
-    if (!file.open())
+    QMap<QString, QVariant> values;
+    if (!parseIni(data, values)) {
+        qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
         return false;
-    file.write(data);
-    file.flush();
-    file.close();
-    auto loaded = loadFile(file.fileName());
-    file.remove();
-    return loaded;
+    }
+
+    if (auto version = values.value("ConfigVersion"); !version.isValid()) {
+        values.clear();
+        parseOldFileFormat(data, values);
+        values.insert("ConfigVersion", "1.2");
+    } else if (version.toString() == "1.1") {
+        for (auto it = values.begin(); it != values.end(); ++it) {
+            if (auto valueStr = it.value().toString();
+                (valueStr.contains(QChar(';')) || valueStr.contains(QChar('=')) || valueStr.contains(QChar(','))) &&
+                valueStr.endsWith("\"") && valueStr.startsWith("\"")) {
+                it.value() = unquote(valueStr);
+            }
+        }
+        values.insert("ConfigVersion", "1.2");
+    }
+
+    if (isEmpty()) {
+        swap(values);
+    } else {
+        for (auto it = values.cbegin(); it != values.cend(); ++it)
+            insert(it.key(), it.value());
+    }
+    return true;
 }
 
 QVariant INIFile::get(QString key, QVariant def) const
@@ -48,6 +48,7 @@ class INIFile : public QMap<QString, QVariant> {
    public:
     explicit INIFile();
 
+    /// Merges the values of the file into this one. Returns false if the file is missing, can't be read or is malformed.
     bool loadFile(QString fileName);
     bool loadFile(QByteArray data);
     bool saveFile(QString fileName);
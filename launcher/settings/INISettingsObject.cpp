@@ -16,8 +16,50 @@
 #include "INISettingsObject.h"
 #include "Setting.h"
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+// how long changes are collected before they are written
+constexpr int s_writeBehindDelay = 500;  // ms
+
+struct WriteBehindQueue {
+    QSet<INISettingsObject*> dirty;
+    QPointer<QTimer> timer;
+    // a single thread, so writes to the same file happen in order
+    QThreadPool pool;
+
+    WriteBehindQueue() { pool.setMaxThreadCount(1); }
+};
+
+WriteBehindQueue& writeBehindQueue()
+{
+    static WriteBehindQueue queue;
+    return queue;
+}
+
+bool writeFile(INIFile& ini, const QString& path, std::atomic<quint64>& writes)
+{
+    // FS::write creates missing folders, which would bring back an instance that was deleted in the meantime
+    if (!QFileInfo(path).absoluteDir().exists())
+        return false;
+    writes++;
+    // FS::write goes through a PSaveFile that is renamed over the old file, readers never see a partial file
+    return ini.saveFile(path);
+}
+}  // namespace
 
 INISettingsObject::INISettingsObject(QStringList paths, QObject* parent) : SettingsObject(parent)
 {
@@ -44,16 +86,63 @@ INISettingsObject::INISettingsObject(QString path, QObject* parent) : SettingsOb
     m_ini.loadFile(path);
 }
 
+INISettingsObject::INISettingsObject(QString path, INIFile contents, QObject* parent)
+    : SettingsObject(parent), m_ini(std::move(contents)), m_filePath(path)
+{}
+
+INISettingsObject::INISettingsObject(QString path, INIFile known, const QStringList& knownKeys, QObject* parent)
+    : SettingsObject(parent), m_ini(std::move(known)), m_filePath(path), m_loaded(false)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    m_knownKeys = QSet<QString>(knownKeys.begin(), knownKeys.end());
+#else
+    m_knownKeys = knownKeys.toSet();
+#endif
+}
+
+INISettingsObject::~INISettingsObject()
+{
+    if (m_dirty)
+        flush();
+    writeBehindQueue().dirty.remove(this);
+}
+
 void INISettingsObject::setFilePath(const QString& filePath)
 {
+    // the values that aren't known yet are still in the old file
+    ensureLoaded();
+    if (m_dirty)
+        flush();
     m_filePath = filePath;
 }
 
 bool INISettingsObject::reload()
 {
+    if (m_dirty)
+        flush();
+    {
+        QMutexLocker locker(&m_loadMutex);
+        m_loaded = true;
+    }
+    // a missing file fails to load, like it did with QSettings, and the current values are kept
     return m_ini.loadFile(m_filePath) && SettingsObject::reload();
 }
 
+void INISettingsObject::ensureLoaded() const
+{
+    if (m_loaded)
+        return;
+    QMutexLocker locker(&m_loadMutex);
+    if (m_loaded)
+        return;
+    INIFile ini;
+    // keep the known values and try again next time, instead of dropping them for an empty file
+    if (!ini.loadFile(m_filePath))
+        return;
+    m_ini = ini;
+    m_loaded = true;
+}
+
 void INISettingsObject::suspendSave()
 {
     m_suspendSave = true;
@@ -63,56 +152,119 @@ void INISettingsObject::resumeSave()
 {
     m_suspendSave = false;
     if (m_doSave) {
-        m_ini.saveFile(m_filePath);
+        m_doSave = false;
+        doSave();
     }
 }
 
-void INISettingsObject::changeSetting(const Setting& setting, QVariant value)
+void INISettingsObject::setWriteBehind(bool writeBehind)
 {
-    if (contains(setting.id())) {
-        // valid value -> set the main config, remove all the sysnonyms
-        if (value.isValid()) {
-            auto list = setting.configKeys();
-            m_ini.set(list.takeFirst(), value);
-            for (auto iter : list)
-                m_ini.remove(iter);
-        }
-        // invalid -> remove all (just like resetSetting)
-        else {
-            for (auto iter : setting.configKeys())
-                m_ini.remove(iter);
-        }
-        doSave();
+    if (!writeBehind && m_dirty)
+        flush();
+    m_writeBehind = writeBehind;
+}
+
+void INISettingsObject::queueWrite()
+{
+    auto& queue = writeBehindQueue();
+    queue.dirty.remove(this);
+    if (!m_dirty)
+        return;
+    m_dirty = false;
+    // the copy is cheap, the map is implicitly shared until either side changes
+    QtConcurrent::run(&queue.pool, [ini = m_ini, path = m_filePath, writes = m_fileWrites]() mutable { writeFile(ini, path, *writes); });
+}
+
+void INISettingsObject::queuePendingWrites()
+{
+    auto dirty = writeBehindQueue().dirty;
+    for (auto object : dirty)
+        object->queueWrite();
+}
+
+void INISettingsObject::flush()
+{
+    queueWrite();
+    writeBehindQueue().pool.waitForDone();
+}
+
+void INISettingsObject::flushAll()
+{
+    queuePendingWrites();
+    writeBehindQueue().pool.waitForDone();
+}
+
+void INISettingsObject::changeSetting(const QStringList& keys, QVariant value)
+{
+    // the whole file gets written, so all of it has to be known
+    ensureLoaded();
+    // valid value -> set the main config, remove all the sysnonyms
+    if (value.isValid()) {
+        m_ini.set(keys.first(), value);
+        for (int i = 1; i < keys.size(); i++)
+            m_ini.remove(keys.at(i));
+    }
+    // invalid -> remove all (just like resetSetting)
+    else {
+        for (auto& key : keys)
+            m_ini.remove(key);
     }
+    doSave();
 }
 
 void INISettingsObject::doSave()
 {
     if (m_suspendSave) {
         m_doSave = true;
-    } else {
+        return;
+    }
+
+    if (!m_writeBehind) {
+        (*m_fileWrites)++;
         m_ini.saveFile(m_filePath);
+        return;
+    }
+
+    auto& queue = writeBehindQueue();
+    m_dirty = true;
+    queue.dirty.insert(this);
+    if (!queue.timer) {
+        // owned by the application, so it goes away before the queue does
+        queue.timer = new QTimer(QCoreApplication::instance());
+        queue.timer->setSingleShot(true);
+        queue.timer->setInterval(s_writeBehindDelay);
+        QObject::connect(queue.timer, &QTimer::timeout, &INISettingsObject::queuePendingWrites);
     }
+    if (!queue.timer->isActive())
+        queue.timer->start();
 }
 
-void INISettingsObject::resetSetting(const Setting& setting)
+void INISettingsObject::resetSetting(const QStringList& keys)
 {
-    // if we have the setting, remove all the synonyms. ALL OF THEM
-    if (contains(setting.id())) {
-        for (auto iter : setting.configKeys())
-            m_ini.remove(iter);
-        doSave();
-    }
+    ensureLoaded();
+    // remove all the synonyms. ALL OF THEM
+    for (auto& key : keys)
+        m_ini.remove(key);
+    doSave();
 }
 
-QVariant INISettingsObject::retrieveValue(const Setting& setting)
+QVariant INISettingsObject::retrieveValue(const QStringList& keys) const
 {
-    // if we have the setting, return value of the first matching synonym
-    if (contains(setting.id())) {
-        for (auto iter : setting.configKeys()) {
-            if (m_ini.contains(iter))
-                return m_ini[iter];
+    // return value of the first matching synonym
+    auto lookup = [this, &keys]() {
+        for (auto& key : keys) {
+            if (auto it = m_ini.constFind(key); it != m_ini.constEnd())
+                return *it;
         }
+        return QVariant();
+    };
+
+    if (!m_loaded) {
+        // another thread may be reading the file right now
+        QMutexLocker locker(&m_loadMutex);
+        if (!m_loaded && std::all_of(keys.begin(), keys.end(), [this](const QString& key) { return m_knownKeys.contains(key); }))
+            return lookup();
     }
-    return QVariant();
+    ensureLoaded();
+    return lookup();
 }
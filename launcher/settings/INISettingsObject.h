@@ -15,7 +15,12 @@
 
 #pragma once
 
+#include <QMutex>
 #include <QObject>
+#include <QSet>
+
+#include <atomic>
+#include <memory>
 
 #include "settings/INIFile.h"
 
@@ -32,6 +37,22 @@ class INISettingsObject : public SettingsObject {
 
     explicit INISettingsObject(QString path, QObject* parent = nullptr);
 
+    /*!
+     * \brief Creates a settings object for an INI file that was already read elsewhere, e.g. on a worker thread.
+     * \param contents The contents of the file at \p path.
+     */
+    INISettingsObject(QString path, INIFile contents, QObject* parent = nullptr);
+
+    /*!
+     * \brief Creates a settings object that only knows some of the values in the INI file for now.
+     * The file is read once a value outside of \p knownKeys is needed, or when anything is changed.
+     * \param known The values of \p knownKeys. A key that is missing from it is missing from the file.
+     */
+    INISettingsObject(QString path, INIFile known, const QStringList& knownKeys, QObject* parent = nullptr);
+
+    /// writes out pending changes when in write-behind mode
+    virtual ~INISettingsObject();
+
     /*!
      * \brief Gets the path to the INI file.
      * \return The path to the INI file.
@@ -49,15 +70,47 @@ class INISettingsObject : public SettingsObject {
     void suspendSave() override;
     void resumeSave() override;
 
-   protected slots:
-    virtual void changeSetting(const Setting& setting, QVariant value) override;
-    virtual void resetSetting(const Setting& setting) override;
+    /*!
+     * \brief Enables write-behind saving.
+     * Instead of rewriting the file on every change, changes are collected for a short while and then written on a background
+     * thread, so bursts of changes result in a single write. Pending changes are written out by flush() and flushAll(), when the
+     * object is destroyed and when the launcher quits.
+     */
+    void setWriteBehind(bool writeBehind);
+
+    /// Writes out pending changes of this object and waits until they are on disk.
+    void flush();
+    /// Writes out pending changes of all settings objects and waits until they are on disk, for anything reading their files.
+    static void flushAll();
+
+    /// how many times this object wrote its file so far, for the tests
+    quint64 fileWrites() const { return *m_fileWrites; }
 
    protected:
-    virtual QVariant retrieveValue(const Setting& setting) override;
+    virtual void changeSetting(const QStringList& keys, QVariant value) override;
+    virtual void resetSetting(const QStringList& keys) override;
+    virtual QVariant retrieveValue(const QStringList& keys) const override;
     void doSave();
 
+    /// reads the whole file, if only some of its values are known so far. If that fails, only the known values are used until it works
+    void ensureLoaded() const;
+
+   private:
+    /// hands the current state over to the writer thread, if there are unsaved changes
+    void queueWrite();
+    static void queuePendingWrites();
+
    protected:
-    INIFile m_ini;
+    // mutable, because reading a value may have to read the file first
+    mutable INIFile m_ini;
     QString m_filePath;
+
+   private:
+    QSet<QString> m_knownKeys;
+    mutable std::atomic<bool> m_loaded = true;
+    mutable QMutex m_loadMutex;
+    bool m_writeBehind = false;
+    bool m_dirty = false;
+    // shared with the writes that are still queued
+    std::shared_ptr<std::atomic<quint64>> m_fileWrites = std::make_shared<std::atomic<quint64>>(0);
 };
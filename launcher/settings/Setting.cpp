@@ -24,24 +24,29 @@ QVariant Setting::get() const
     if (!sbase) {
         return defValue();
     } else {
-        QVariant test = sbase->retrieveValue(*this);
-        if (!test.isValid())
-            return defValue();
-        return test;
+        return sbase->get(id());
     }
 }
 
 QVariant Setting::defValue() const
 {
+    if (m_storage)
+        return m_storage->defValue(id());
     return m_defVal;
 }
 
 void Setting::set(QVariant value)
 {
-    emit SettingChanged(*this, value);
+    if (m_storage)
+        m_storage->set(id(), value);
+    else
+        emit SettingChanged(*this, value);
 }
 
 void Setting::reset()
 {
-    emit settingReset(*this);
+    if (m_storage)
+        m_storage->reset(id());
+    else
+        emit settingReset(*this);
 }
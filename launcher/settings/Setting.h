@@ -58,7 +58,7 @@ class Setting : public QObject {
 
     /*!
      * \brief Gets this setting's value as a QVariant.
-     * This is done by calling the SettingsObject's retrieveValue() function.
+     * This is done by asking the SettingsObject the setting belongs to.
      * If this Setting doesn't have a SettingsObject, this returns an invalid QVariant.
      * \return QVariant containing this setting's value.
      * \sa value()
@@ -88,22 +88,22 @@ class Setting : public QObject {
    public slots:
     /*!
      * \brief Changes the setting's value.
-     * This is done by emitting the SettingChanged() signal which will then be
-     * handled by the SettingsObject object and cause the setting to change.
+     * This is done by the SettingsObject the setting belongs to, which then emits
+     * the SettingChanged() signal.
      * \param value The new value.
      */
     virtual void set(QVariant value);
 
     /*!
      * \brief Reset the setting to default
-     * This is done by emitting the settingReset() signal which will then be
-     * handled by the SettingsObject object and cause the setting to change.
+     * This is done by the SettingsObject the setting belongs to, which then emits
+     * the settingReset() signal.
      */
     virtual void reset();
 
    protected:
     friend class SettingsObject;
-    SettingsObject* m_storage;
+    SettingsObject* m_storage = nullptr;
     QStringList m_synonyms;
     QVariant m_defVal;
 };
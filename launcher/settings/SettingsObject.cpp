@@ -15,112 +15,192 @@
 
 #include "settings/SettingsObject.h"
 #include <QDebug>
-#include "PassthroughSetting.h"
-#include "settings/OverrideSetting.h"
+#include <QMetaMethod>
 #include "settings/Setting.h"
 
 #include <QVariant>
 
-SettingsObject::SettingsObject(QObject* parent) : QObject(parent) {}
+SettingsObject::SettingsObject(QObject* parent) : QObject(parent), m_schema(SettingsSchema::empty()) {}
 
 SettingsObject::~SettingsObject()
 {
     m_settings.clear();
 }
 
-std::shared_ptr<Setting> SettingsObject::registerOverride(std::shared_ptr<Setting> original, std::shared_ptr<Setting> gate)
+bool SettingsObject::declare(const SettingDescriptor& descriptor)
 {
-    if (contains(original->id())) {
-        qCritical() << QString("Failed to register setting %1. ID already exists.").arg(original->id());
-        return nullptr;  // Fail
+    auto schema = m_schema->with(descriptor);
+    if (!schema) {
+        qCritical() << QString("Failed to register setting %1. ID already exists.").arg(descriptor.id());
+        return false;  // Fail
     }
-    auto override = std::make_shared<OverrideSetting>(original, gate);
-    override->m_storage = this;
-    connectSignals(*override);
-    m_settings.insert(override->id(), override);
-    return override;
+    m_schema = schema;
+    return true;
+}
+
+bool SettingsObject::declareOverride(std::shared_ptr<Setting> original, const QString& gate)
+{
+    Q_ASSERT(original);
+    Q_ASSERT(!gate.isEmpty());
+    return declare({ SettingDescriptor::Kind::Override, original->configKeys(), QVariant(), original, gate });
+}
+
+bool SettingsObject::declarePassthrough(std::shared_ptr<Setting> original, const QString& gate)
+{
+    Q_ASSERT(original);
+    return declare({ SettingDescriptor::Kind::Passthrough, original->configKeys(), QVariant(), original, gate });
+}
+
+bool SettingsObject::declareSetting(QStringList synonyms, QVariant defVal)
+{
+    if (synonyms.empty())
+        return false;
+    return declare({ SettingDescriptor::Kind::Plain, synonyms, defVal, nullptr, QString() });
+}
+
+std::shared_ptr<Setting> SettingsObject::registerOverride(std::shared_ptr<Setting> original, std::shared_ptr<Setting> gate)
+{
+    if (!declareOverride(original, gate->id()))
+        return nullptr;
+    return getSetting(original->id());
 }
 
 std::shared_ptr<Setting> SettingsObject::registerPassthrough(std::shared_ptr<Setting> original, std::shared_ptr<Setting> gate)
 {
-    if (contains(original->id())) {
-        qCritical() << QString("Failed to register setting %1. ID already exists.").arg(original->id());
-        return nullptr;  // Fail
-    }
-    auto passthrough = std::make_shared<PassthroughSetting>(original, gate);
-    passthrough->m_storage = this;
-    connectSignals(*passthrough);
-    m_settings.insert(passthrough->id(), passthrough);
-    return passthrough;
+    if (!declarePassthrough(original, gate ? gate->id() : QString()))
+        return nullptr;
+    return getSetting(original->id());
 }
 
 std::shared_ptr<Setting> SettingsObject::registerSetting(QStringList synonyms, QVariant defVal)
 {
-    if (synonyms.empty())
+    if (!declareSetting(synonyms, defVal))
         return nullptr;
-    if (contains(synonyms.first())) {
-        qCritical() << QString("Failed to register setting %1. ID already exists.").arg(synonyms.first());
-        return nullptr;  // Fail
-    }
-    auto setting = std::make_shared<Setting>(synonyms, defVal);
-    setting->m_storage = this;
-    connectSignals(*setting);
-    m_settings.insert(setting->id(), setting);
-    return setting;
+    return getSetting(synonyms.first());
 }
 
 std::shared_ptr<Setting> SettingsObject::getSetting(const QString& id) const
 {
+    if (auto setting = m_settings.value(id))
+        return setting;
+
     // Make sure there is a setting with the given ID.
-    if (!m_settings.contains(id))
-        return NULL;
+    auto descriptor = m_schema->find(id);
+    if (!descriptor)
+        return nullptr;
 
-    return m_settings[id];
+    auto setting = std::make_shared<Setting>(descriptor->synonyms, descriptor->defVal);
+    setting->m_storage = const_cast<SettingsObject*>(this);
+    m_settings.insert(id, setting);
+    return setting;
 }
 
 QVariant SettingsObject::get(const QString& id) const
 {
-    auto setting = getSetting(id);
-    return (setting ? setting->get() : QVariant());
+    auto descriptor = m_schema->find(id);
+    return descriptor ? value(*descriptor) : QVariant();
+}
+
+QVariant SettingsObject::defValue(const QString& id) const
+{
+    auto descriptor = m_schema->find(id);
+    return descriptor ? defValue(*descriptor) : QVariant();
 }
 
 bool SettingsObject::set(const QString& id, QVariant value)
 {
-    auto setting = getSetting(id);
-    if (!setting) {
+    auto descriptor = m_schema->find(id);
+    if (!descriptor) {
         qCritical() << QString("Error changing setting %1. Setting doesn't exist.").arg(id);
         return false;
-    } else {
-        setting->set(value);
-        return true;
     }
+
+    if (descriptor->kind != SettingDescriptor::Kind::Passthrough || isOverriding(*descriptor)) {
+        changeSetting(descriptor->synonyms, value);
+        notifyChanged(*descriptor, value);
+    }
+    if (descriptor->kind == SettingDescriptor::Kind::Passthrough)
+        descriptor->other->set(value);
+    return true;
 }
 
-void SettingsObject::reset(const QString& id) const
+void SettingsObject::reset(const QString& id)
 {
-    auto setting = getSetting(id);
-    if (setting)
-        setting->reset();
+    auto descriptor = m_schema->find(id);
+    if (!descriptor)
+        return;
+
+    if (descriptor->kind != SettingDescriptor::Kind::Passthrough || isOverriding(*descriptor)) {
+        resetSetting(descriptor->synonyms);
+        notifyReset(*descriptor);
+    }
+    if (descriptor->kind == SettingDescriptor::Kind::Passthrough)
+        descriptor->other->reset();
 }
 
-bool SettingsObject::contains(const QString& id)
+bool SettingsObject::contains(const QString& id) const
 {
-    return m_settings.contains(id);
+    return m_schema->find(id);
 }
 
 bool SettingsObject::reload()
 {
-    for (auto setting : m_settings.values()) {
-        setting->set(setting->get());
+    for (auto descriptor : m_schema->descriptors()) {
+        set(descriptor->id(), value(*descriptor));
     }
     return true;
 }
 
-void SettingsObject::connectSignals(const Setting& setting)
+bool SettingsObject::isOverriding(const SettingDescriptor& descriptor) const
+{
+    if (descriptor.gate.isEmpty())
+        return false;
+    return get(descriptor.gate).toBool();
+}
+
+QVariant SettingsObject::value(const SettingDescriptor& descriptor) const
+{
+    if (descriptor.kind != SettingDescriptor::Kind::Plain && !isOverriding(descriptor))
+        return descriptor.other->get();
+
+    QVariant stored = retrieveValue(descriptor.synonyms);
+    if (!stored.isValid())
+        return defValue(descriptor);
+    return stored;
+}
+
+QVariant SettingsObject::defValue(const SettingDescriptor& descriptor) const
 {
-    connect(&setting, &Setting::SettingChanged, this, &SettingsObject::changeSetting);
-    connect(&setting, SIGNAL(SettingChanged(const Setting&, QVariant)), this, SIGNAL(SettingChanged(const Setting&, QVariant)));
+    switch (descriptor.kind) {
+        case SettingDescriptor::Kind::Plain:
+            return descriptor.defVal;
+        case SettingDescriptor::Kind::Override:
+            return descriptor.other->get();
+        case SettingDescriptor::Kind::Passthrough:
+            return isOverriding(descriptor) ? descriptor.other->get() : descriptor.other->defValue();
+    }
+    return QVariant();
+}
+
+void SettingsObject::notifyChanged(const SettingDescriptor& descriptor, const QVariant& value)
+{
+    auto setting = m_settings.value(descriptor.id());
+    // nobody can be listening to a Setting that was never handed out
+    if (!setting && isSignalConnected(QMetaMethod::fromSignal(&SettingsObject::SettingChanged)))
+        setting = getSetting(descriptor.id());
+    if (!setting)
+        return;
+    emit setting->SettingChanged(*setting, value);
+    emit SettingChanged(*setting, value);
+}
 
-    connect(&setting, &Setting::settingReset, this, &SettingsObject::resetSetting);
-    connect(&setting, SIGNAL(settingReset(Setting)), this, SIGNAL(settingReset(const Setting&)));
+void SettingsObject::notifyReset(const SettingDescriptor& descriptor)
+{
+    auto setting = m_settings.value(descriptor.id());
+    if (!setting && isSignalConnected(QMetaMethod::fromSignal(&SettingsObject::settingReset)))
+        setting = getSetting(descriptor.id());
+    if (!setting)
+        return;
+    emit setting->settingReset(*setting);
+    emit settingReset(*setting);
 }
@@ -23,6 +23,8 @@
 #include <QVariant>
 #include <memory>
 
+#include "settings/SettingsSchema.h"
+
 class Setting;
 class SettingsObject;
 
@@ -32,9 +34,10 @@ using SettingsObjectWeakPtr = std::weak_ptr<SettingsObject>;
 /*!
  * \brief The SettingsObject handles communicating settings between the application and a
  *settings file.
- * The class keeps a list of Setting objects. Each Setting object represents one
- * of the application's settings. These Setting objects are registered with
- * a SettingsObject and can be managed similarly to the way a list works.
+ * The class keeps a schema describing each of the application's settings. The schema is
+ * shared with all other settings objects that registered the same settings, so a settings
+ * object itself only holds the values that are actually set.
+ * Setting objects are only created when something asks for one through getSetting().
  *
  * \author Andrew Okin
  * \date 2/22/2013
@@ -56,9 +59,42 @@ class SettingsObject : public QObject {
    public:
     explicit SettingsObject(QObject* parent = 0);
     virtual ~SettingsObject();
+
+    /*!
+     * Declares an override setting for the given original setting in this settings object.
+     * gate is the ID of a setting in this object and decides if this setting (true) or the original (false) is used for value
+     *
+     * This will fail if there is already a setting with the same ID as
+     * the one that is being declared.
+     * \return True if successful.
+     */
+    bool declareOverride(std::shared_ptr<Setting> original, const QString& gate);
+
+    /*!
+     * Declares a passthrough setting for the given original setting in this settings object.
+     * gate is the ID of a setting in this object and decides if the passthrough (true) or the original (false) is used for
+     * value. Without a gate the original is always used.
+     *
+     * This will fail if there is already a setting with the same ID as
+     * the one that is being declared.
+     * \return True if successful.
+     */
+    bool declarePassthrough(std::shared_ptr<Setting> original, const QString& gate = QString());
+
+    /*!
+     * Declares a setting with this SettingsObject, without creating a Setting object for it.
+     *
+     * This will fail if there is already a setting with the same ID as
+     * the one that is being declared.
+     * \return True if successful.
+     */
+    bool declareSetting(QStringList synonyms, QVariant defVal = QVariant());
+    bool declareSetting(QString id, QVariant defVal = QVariant()) { return declareSetting(QStringList(id), defVal); }
+
     /*!
      * Registers an override setting for the given original setting in this settings object
      * gate decides if the passthrough (true) or the original (false) is used for value
+     * and has to be registered with this settings object.
      *
      * This will fail if there is already a setting with the same ID as
      * the one that is being registered.
@@ -69,6 +105,7 @@ class SettingsObject : public QObject {
     /*!
      * Registers a passthorugh setting for the given original setting in this settings object
      * gate decides if the passthrough (true) or the original (false) is used for value
+     * and has to be registered with this settings object.
      *
      * This will fail if there is already a setting with the same ID as
      * the one that is being registered.
@@ -77,7 +114,7 @@ class SettingsObject : public QObject {
     std::shared_ptr<Setting> registerPassthrough(std::shared_ptr<Setting> original, std::shared_ptr<Setting> gate);
 
     /*!
-     * Registers the given setting with this SettingsObject and connects the necessary  signals.
+     * Registers the given setting with this SettingsObject and returns a Setting object for it.
      *
      * This will fail if there is already a setting with the same ID as
      * the one that is being registered.
@@ -86,7 +123,7 @@ class SettingsObject : public QObject {
     std::shared_ptr<Setting> registerSetting(QStringList synonyms, QVariant defVal = QVariant());
 
     /*!
-     * Registers the given setting with this SettingsObject and connects the necessary signals.
+     * Registers the given setting with this SettingsObject and returns a Setting object for it.
      *
      * This will fail if there is already a setting with the same ID as
      * the one that is being registered.
@@ -96,6 +133,7 @@ class SettingsObject : public QObject {
 
     /*!
      * \brief Gets the setting with the given ID.
+     * The Setting object is created on first use and kept for as long as this object lives.
      * \param id The ID of the setting to get.
      * \return A pointer to the setting with the given ID.
      * Returns null if there is no setting with the given ID.
@@ -111,6 +149,14 @@ class SettingsObject : public QObject {
      */
     QVariant get(const QString& id) const;
 
+    /*!
+     * \brief Gets the default value of the setting with the given ID.
+     * For overrides this is the value of the overridden setting.
+     * \param id The ID of the setting.
+     * \return The default value, or an invalid QVariant if no setting with the given ID exists.
+     */
+    QVariant defValue(const QString& id) const;
+
     /*!
      * \brief Sets the value of the setting with the given ID.
      * If no setting with the given ID exists, returns false
@@ -124,14 +170,17 @@ class SettingsObject : public QObject {
      * \brief Reverts the setting with the given ID to default.
      * \param id The ID of the setting to reset.
      */
-    void reset(const QString& id) const;
+    void reset(const QString& id);
 
     /*!
      * \brief Checks if this SettingsObject contains a setting with the given ID.
      * \param id The ID to check for.
      * \return True if the SettingsObject has a setting with the given ID.
      */
-    bool contains(const QString& id);
+    bool contains(const QString& id) const;
+
+    /// The schema of this object, shared with every other object that registered the same settings.
+    std::shared_ptr<const SettingsSchema> schema() const { return m_schema; }
 
     /*!
      * \brief Reloads the settings and emit signals for changed settings
@@ -144,8 +193,6 @@ class SettingsObject : public QObject {
    signals:
     /*!
      * \brief Signal emitted when one of this SettingsObject object's settings changes.
-     * This is usually just connected directly to each Setting object's
-     * SettingChanged() signals.
      * \param setting A reference to the Setting object that changed.
      * \param value The Setting object's new value.
      */
@@ -153,50 +200,47 @@ class SettingsObject : public QObject {
 
     /*!
      * \brief Signal emitted when one of this SettingsObject object's settings resets.
-     * This is usually just connected directly to each Setting object's
-     * settingReset() signals.
      * \param setting A reference to the Setting object that changed.
      */
     void settingReset(const Setting& setting);
 
-   protected slots:
+   protected:
     /*!
-     * \brief Changes a setting.
-     * This slot is usually connected to each Setting object's
-     * SettingChanged() signal. The signal is emitted, causing this slot
-     * to update the setting's value in the config file.
-     * \param setting A reference to the Setting object that changed.
+     * \brief Changes the stored value of a setting.
+     * A valid value is stored under the first key and replaces the other keys,
+     * an invalid value removes all of them (just like resetSetting()).
+     * \param keys The setting's config keys.
      * \param value The setting's new value.
      */
-    virtual void changeSetting(const Setting& setting, QVariant value) = 0;
+    virtual void changeSetting(const QStringList& keys, QVariant value) = 0;
 
     /*!
-     * \brief Resets a setting.
-     * This slot is usually connected to each Setting object's
-     * settingReset() signal. The signal is emitted, causing this slot
-     * to update the setting's value in the config file.
-     * \param setting A reference to the Setting object that changed.
-     */
-    virtual void resetSetting(const Setting& setting) = 0;
-
-   protected:
-    /*!
-     * \brief Connects the necessary signals to the given Setting.
-     * \param setting The setting to connect.
+     * \brief Removes the stored value of a setting, so its default is used again.
+     * \param keys The setting's config keys.
      */
-    void connectSignals(const Setting& setting);
+    virtual void resetSetting(const QStringList& keys) = 0;
 
     /*!
-     * \brief Function used by Setting objects to get their values from the SettingsObject.
-     * \param setting The
-     * \return
+     * \brief Function used to get the stored value of a setting.
+     * \param keys The setting's config keys.
+     * \return The value of the first key that is stored, or an invalid QVariant.
      */
-    virtual QVariant retrieveValue(const Setting& setting) = 0;
+    virtual QVariant retrieveValue(const QStringList& keys) const = 0;
 
     friend class Setting;
 
    private:
-    QMap<QString, std::shared_ptr<Setting>> m_settings;
+    bool declare(const SettingDescriptor& descriptor);
+    QVariant value(const SettingDescriptor& descriptor) const;
+    QVariant defValue(const SettingDescriptor& descriptor) const;
+    bool isOverriding(const SettingDescriptor& descriptor) const;
+    /// emits the change signals, if anything could be listening
+    void notifyChanged(const SettingDescriptor& descriptor, const QVariant& value);
+    void notifyReset(const SettingDescriptor& descriptor);
+
+    std::shared_ptr<const SettingsSchema> m_schema;
+    /// Setting objects handed out by getSetting()
+    mutable QHash<QString, std::shared_ptr<Setting>> m_settings;
 
    protected:
     bool m_suspendSave = false;
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SettingsSchema.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+
+bool SettingDescriptor::operator==(const SettingDescriptor& rhs) const
+{
+    return kind == rhs.kind && synonyms == rhs.synonyms && defVal == rhs.defVal && other == rhs.other && gate == rhs.gate;
+}
+
+SettingsSchema::SettingsSchema(std::shared_ptr<const SettingsSchema> parent, const SettingDescriptor& descriptor)
+    : m_parent(std::move(parent)), m_descriptor(descriptor)
+{
+    m_size = m_parent->m_size + 1;
+}
+
+std::shared_ptr<const SettingsSchema> SettingsSchema::empty()
+{
+    // never released: the transitions hang off of it and are shared by every settings object
+    static const std::shared_ptr<const SettingsSchema> s_empty(new SettingsSchema());
+    return s_empty;
+}
+
+std::shared_ptr<const SettingsSchema> SettingsSchema::with(const SettingDescriptor& descriptor) const
+{
+    QMutexLocker locker(&m_transitionsLock);
+    for (auto& next : m_transitions) {
+        if (next->m_descriptor == descriptor)
+            return next;
+    }
+
+    // only checked the first time, a known transition has passed this already
+    for (auto schema = this; schema->m_parent; schema = schema->m_parent.get()) {
+        if (schema->m_descriptor.id() == descriptor.id())
+            return nullptr;
+    }
+
+    std::shared_ptr<const SettingsSchema> next(new SettingsSchema(shared_from_this(), descriptor));
+    m_transitions.push_back(next);
+    return next;
+}
+
+const SettingDescriptor* SettingsSchema::find(const QString& id) const
+{
+    std::call_once(m_indexOnce, [this] {
+        m_index.reserve(m_size);
+        for (auto schema = this; schema->m_parent; schema = schema->m_parent.get())
+            m_index.insert(schema->m_descriptor.id(), &schema->m_descriptor);
+    });
+    return m_index.value(id, nullptr);
+}
+
+QList<const SettingDescriptor*> SettingsSchema::descriptors() const
+{
+    QList<const SettingDescriptor*> result;
+    result.reserve(m_size);
+    for (auto schema = this; schema->m_parent; schema = schema->m_parent.get())
+        result.append(&schema->m_descriptor);
+    std::reverse(result.begin(), result.end());
+    return result;
+}
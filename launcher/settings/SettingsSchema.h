@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+#include <QVariant>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Setting;
+
+/*!
+ * \brief Describes one setting of a SettingsObject.
+ */
+struct SettingDescriptor {
+    enum class Kind {
+        /// stores its own value and falls back to defVal
+        Plain,
+        /// uses its own value if the gate is true, the value of `other` otherwise
+        Override,
+        /// like Override, but changes are also written to `other`
+        Passthrough,
+    };
+
+    Kind kind = Kind::Plain;
+    /// all the names the value may be stored under, in order of preference; the first one is the ID
+    QStringList synonyms;
+    QVariant defVal;
+    /// the overridden setting, usually one of the global settings
+    std::shared_ptr<Setting> other;
+    /// ID of the setting in the same SettingsObject that decides whether `other` is overridden
+    QString gate;
+
+    QString id() const { return synonyms.first(); }
+    bool operator==(const SettingDescriptor& rhs) const;
+};
+
+/*!
+ * \brief An immutable list of setting descriptors, shared between settings objects.
+ *
+ * Every registration moves a SettingsObject from its current schema to a new one that contains one more setting. The
+ * schemas remember these transitions, so all instances registering the same settings in the same order end up
+ * pointing at the same schema instead of each keeping its own Setting objects.
+ * Each schema only stores the setting it added and a lookup table that is built the first time it is needed.
+ */
+class SettingsSchema : public std::enable_shared_from_this<SettingsSchema> {
+   public:
+    /// the schema without any settings, which every SettingsObject starts with
+    static std::shared_ptr<const SettingsSchema> empty();
+
+    /*!
+     * \brief Returns the schema that has `descriptor` added to this one.
+     * \return nullptr if there already is a setting with the same ID.
+     */
+    std::shared_ptr<const SettingsSchema> with(const SettingDescriptor& descriptor) const;
+
+    /// \return the descriptor with the given ID, or nullptr
+    const SettingDescriptor* find(const QString& id) const;
+
+    /// all descriptors, in the order they were registered
+    QList<const SettingDescriptor*> descriptors() const;
+
+    int size() const { return m_size; }
+
+   private:
+    SettingsSchema() = default;
+    SettingsSchema(std::shared_ptr<const SettingsSchema> parent, const SettingDescriptor& descriptor);
+
+    std::shared_ptr<const SettingsSchema> m_parent;
+    SettingDescriptor m_descriptor;
+    int m_size = 0;
+
+    mutable QMutex m_transitionsLock;
+    mutable std::vector<std::shared_ptr<const SettingsSchema>> m_transitions;
+
+    mutable std::once_flag m_indexOnce;
+    mutable QHash<QString, const SettingDescriptor*> m_index;
+};
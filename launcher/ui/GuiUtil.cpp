@@ -42,6 +42,7 @@
 #include <QFileDialog>
 #include <QStandardPaths>
 
+#include "CensorFilter.h"
 #include "net/PasteUpload.h"
 #include "ui/dialogs/CustomMessageBox.h"
 #include "ui/dialogs/ProgressDialog.h"
@@ -74,7 +75,7 @@ QString truncateLogForMclogs(const QString& logContent)
     return logContent;
 }
 
-std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString& text, QWidget* parentWidget)
+std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString& text, QWidget* parentWidget, const CensorFilter* censor)
 {
     ProgressDialog dialog(parentWidget);
     auto pasteTypeSetting = static_cast<PasteUpload::PasteType>(APPLICATION->settings()->get("PastebinType").toInt());
@@ -123,9 +124,9 @@ std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString&
         }
     }
 
-    QString textToUpload = text;
+    QString textToUpload = censor ? censor->censor(text) : text;
     if (shouldTruncate) {
-        textToUpload = truncateLogForMclogs(text);
+        textToUpload = truncateLogForMclogs(textToUpload);
     }
 
     std::unique_ptr<PasteUpload> paste(new PasteUpload(parentWidget, textToUpload, pasteCustomAPIBaseSetting, pasteTypeSetting));
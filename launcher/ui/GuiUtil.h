@@ -3,8 +3,10 @@
 #include <QWidget>
 #include <optional>
 
+class CensorFilter;
+
 namespace GuiUtil {
-std::optional<QString> uploadPaste(const QString& name, const QString& text, QWidget* parentWidget);
+std::optional<QString> uploadPaste(const QString& name, const QString& text, QWidget* parentWidget, const CensorFilter* censor = nullptr);
 void setClipboardText(const QString& text);
 QStringList BrowseForFiles(QString context, QString caption, QString filter, QString defaultPath, QWidget* parentWidget);
 QString BrowseForFile(QString context, QString caption, QString filter, QString defaultPath, QWidget* parentWidget);
@@ -58,6 +58,7 @@
 #include <functional>
 #include "Application.h"
 #include "SeparatorPrefixTree.h"
+#include "settings/INISettingsObject.h"
 
 ExportInstanceDialog::ExportInstanceDialog(InstancePtr instance, QWidget* parent)
     : QDialog(parent), m_ui(new Ui::ExportInstanceDialog), m_instance(instance)
@@ -141,6 +142,8 @@ void ExportInstanceDialog::doExport()
     }
 
     SaveIcon(m_instance);
+    // the exported instance.cfg has to be up to date
+    INISettingsObject::flushAll();
 
     auto files = QFileInfoList();
     if (!MMCZip::collectFileListRecursively(m_instance->instanceRoot(), nullptr, &files,
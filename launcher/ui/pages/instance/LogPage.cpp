@@ -245,7 +245,9 @@ void LogPage::on_btnPaste_clicked()
     // FIXME: turn this into a proper task and move the upload logic out of GuiUtil!
     m_model->append(MessageLevel::Launcher,
                     QString("Log upload triggered at: %1").arg(QDateTime::currentDateTime().toString(Qt::RFC2822Date)));
-    auto url = GuiUtil::uploadPaste(tr("Minecraft Log"), m_model->toPlainText(), this);
+    // lines are censored as they come in, but the secrets of the current session may have been added to the log before
+    auto launchTask = m_instance ? m_instance->getLaunchTask() : nullptr;
+    auto url = GuiUtil::uploadPaste(tr("Minecraft Log"), m_model->toPlainText(), this, launchTask ? &launchTask->censorFilter() : nullptr);
     if (!url.has_value()) {
         m_model->append(MessageLevel::Error, QString("Log upload canceled"));
     } else if (url->isNull()) {
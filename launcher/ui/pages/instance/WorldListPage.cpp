@@ -107,6 +107,17 @@ WorldListPage::WorldListPage(InstancePtr inst, std::shared_ptr<WorldList> worlds
 
     connect(ui->worldTreeView->selectionModel(), &QItemSelectionModel::currentChanged, this, &WorldListPage::worldChanged);
     worldChanged(QModelIndex(), QModelIndex());
+
+    // the size of a world takes a walk over all its files, so it is only calculated for the worlds shown here
+    auto requestSizes = [this](int first, int last) {
+        for (int row = first; row <= last; row++)
+            m_worlds->requestSize(row);
+    };
+    connect(m_worlds.get(), &WorldList::rowsInserted, this,
+            [requestSizes](const QModelIndex&, int first, int last) { requestSizes(first, last); });
+    connect(m_worlds.get(), &WorldList::dataChanged, this,
+            [requestSizes](const QModelIndex& topLeft, const QModelIndex& bottomRight) { requestSizes(topLeft.row(), bottomRight.row()); });
+    requestSizes(0, m_worlds->rowCount() - 1);
 }
 
 void WorldListPage::openedImpl()
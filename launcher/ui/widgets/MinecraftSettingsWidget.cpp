@@ -83,6 +83,7 @@ MinecraftSettingsWidget::MinecraftSettingsWidget(MinecraftInstancePtr instance,
         if (m_quickPlaySingleplayer) {
             auto worlds = m_instance->worldList();
             worlds->update();
+            worlds->waitForUpdate();
             for (const auto& world : worlds->allWorlds()) {
                 m_ui->worldsCb->addItem(world.folderName());
             }
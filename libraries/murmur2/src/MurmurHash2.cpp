@@ -8,6 +8,25 @@
 
 #include "MurmurHash2.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// the vector width is picked at compile time, there is a scalar fallback for everything else
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MURMUR2_AVX2
+#define MURMUR2_SIMD
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MURMUR2_SSE2
+#define MURMUR2_SIMD
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MURMUR2_NEON
+#define MURMUR2_SIMD
+#endif
+
 namespace Murmur2 {
 
 // 'm' and 'r' are mixing constants generated offline.
@@ -15,94 +34,172 @@ namespace Murmur2 {
 const uint32_t m = 0x5bd1e995;
 const int r = 24;
 
-uint32_t hash(Reader* file_stream, std::size_t buffer_size, std::function<bool(char)> filter_out)
+namespace {
+
+inline bool isWhitespace(char c)
 {
-    auto* buffer = new char[buffer_size];
-    char data[4];
+    return c == 9 || c == 10 || c == 13 || c == 32;
+}
 
-    int read = 0;
-    uint32_t size = 0;
+#if defined(MURMUR2_AVX2)
+constexpr std::size_t s_blockSize = 32;
 
-    // We need the size without the filtered out characters before actually calculating the hash,
-    // to setup the initial value for the hash.
-    do {
-        read = file_stream->read(buffer, buffer_size);
-        for (int i = 0; i < read; i++) {
-            if (!filter_out(buffer[i]))
-                size += 1;
-        }
-    } while (!file_stream->eof());
+// one bit per byte of the block, set for whitespace
+inline uint32_t whitespaceMask(const char* data)
+{
+    auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    auto ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(9)), _mm256_cmpeq_epi8(block, _mm256_set1_epi8(10))),
+                              _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(13)), _mm256_cmpeq_epi8(block, _mm256_set1_epi8(32))));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+}
+#elif defined(MURMUR2_SSE2)
+constexpr std::size_t s_blockSize = 16;
 
-    file_stream->goToBeginning();
+inline uint32_t whitespaceMask(const char* data)
+{
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    auto ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(9)), _mm_cmpeq_epi8(block, _mm_set1_epi8(10))),
+                           _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(13)), _mm_cmpeq_epi8(block, _mm_set1_epi8(32))));
+    return static_cast<uint32_t>(_mm_movemask_epi8(ws));
+}
+#elif defined(MURMUR2_NEON)
+constexpr std::size_t s_blockSize = 16;
 
-    int index = 0;
+inline uint32_t whitespaceMask(const char* data)
+{
+    auto block = vld1q_u8(reinterpret_cast<const uint8_t*>(data));
+    auto ws = vorrq_u8(vorrq_u8(vceqq_u8(block, vdupq_n_u8(9)), vceqq_u8(block, vdupq_n_u8(10))),
+                       vorrq_u8(vceqq_u8(block, vdupq_n_u8(13)), vceqq_u8(block, vdupq_n_u8(32))));
+    // there is no movemask, narrow every byte to a nibble instead
+    auto nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(ws), 4)), 0);
+    uint32_t mask = 0;
+    for (int i = 0; nibbles; i++, nibbles >>= 4) {
+        if (nibbles & 0xf)
+            mask |= 1u << i;
+    }
+    return mask;
+}
+#endif
+
+#if defined(MURMUR2_SIMD)
+inline uint32_t popcount(uint32_t mask)
+{
+    uint32_t count = 0;
+    for (; mask; mask &= mask - 1)
+        count++;
+    return count;
+}
+#endif
 
-    // This forces a seed of 1.
-    IncrementalHashInfo info{ (uint32_t)1 ^ size, (uint32_t)size };
-    do {
-        read = file_stream->read(buffer, buffer_size);
-        for (int i = 0; i < read; i++) {
-            char c = buffer[i];
+inline void mix(uint32_t& h, const char* data)
+{
+    uint32_t k;
+    std::memcpy(&k, data, 4);
 
-            if (filter_out(c))
-                continue;
+    k *= m;
+    k ^= k >> r;
+    k *= m;
 
-            data[index] = c;
-            index = (index + 1) % 4;
+    h *= m;
+    h ^= k;
+}
 
-            // Mix 4 bytes at a time into the hash
-            if (index == 0)
-                FourBytes_MurmurHash2(reinterpret_cast<unsigned char*>(&data), info);
+}  // namespace
+
+std::size_t countNonWhitespace(const char* data, std::size_t size)
+{
+    std::size_t count = size;
+    std::size_t i = 0;
+#if defined(MURMUR2_SIMD)
+    for (; i + s_blockSize <= size; i += s_blockSize) {
+        count -= popcount(whitespaceMask(data + i));
+    }
+#endif
+    for (; i < size; i++) {
+        if (isWhitespace(data[i]))
+            count--;
+    }
+    return count;
+}
+
+std::size_t stripWhitespace(const char* data, std::size_t size, char* out)
+{
+    std::size_t written = 0;
+    std::size_t i = 0;
+#if defined(MURMUR2_SIMD)
+    for (; i + s_blockSize <= size; i += s_blockSize) {
+        auto mask = whitespaceMask(data + i);
+        // whitespace is rare in jars, copy the whole block when there is none
+        if (mask == 0) {
+            std::memmove(out + written, data + i, s_blockSize);
+            written += s_blockSize;
+            continue;
+        }
+        for (std::size_t j = 0; j < s_blockSize; j++) {
+            if (!(mask & (1u << j)))
+                out[written++] = data[i + j];
         }
-    } while (!file_stream->eof());
+    }
+#endif
+    for (; i < size; i++) {
+        if (!isWhitespace(data[i]))
+            out[written++] = data[i];
+    }
+    return written;
+}
 
-    // Do one last bit shuffle in the hash
-    FourBytes_MurmurHash2(reinterpret_cast<unsigned char*>(&data), info);
+Hasher::Hasher(uint32_t length, uint32_t seed) : m_h(seed ^ length), m_buffer(4) {}
 
-    delete[] buffer;
+void Hasher::addData(const char* data, std::size_t size)
+{
+    // strip into the buffer, so the words fed into the mixer are contiguous and aligned
+    if (m_buffer.size() < m_pending + size)
+        m_buffer.resize(m_pending + size);
+    auto end = m_pending + stripWhitespace(data, size, m_buffer.data() + m_pending);
+    std::size_t i = 0;
+    for (; i + 4 <= end; i += 4)
+        mix(m_h, m_buffer.data() + i);
+    // keep the leftover bytes for the next chunk
+    m_pending = end - i;
+    std::memmove(m_buffer.data(), m_buffer.data() + i, m_pending);
+}
 
-    return info.h;
+uint32_t Hasher::result() const
+{
+    uint32_t h = m_h;
+
+    // Handle the last few bytes of the input array
+    auto tail = reinterpret_cast<const unsigned char*>(m_buffer.data());
+    switch (m_pending) {
+        case 3:
+            h ^= tail[2] << 16;
+            /* fall through */
+        case 2:
+            h ^= tail[1] << 8;
+            /* fall through */
+        case 1:
+            h ^= tail[0];
+            h *= m;
+    };
+
+    // Do a few final mixes of the hash to ensure the last few
+    // bytes are well-incorporated.
+    h ^= h >> 13;
+    h *= m;
+    h ^= h >> 15;
+
+    return h;
 }
 
-void FourBytes_MurmurHash2(const unsigned char* data, IncrementalHashInfo& prev)
+uint32_t hashWithoutWhitespace(const char* data, std::size_t size, uint32_t seed)
 {
-    if (prev.len >= 4) {
-        // Not the final mix
-        uint32_t k = *reinterpret_cast<const uint32_t*>(data);
-
-        k *= m;
-        k ^= k >> r;
-        k *= m;
-
-        prev.h *= m;
-        prev.h ^= k;
-
-        prev.len -= 4;
-    } else {
-        // The final mix
-
-        // Handle the last few bytes of the input array
-        switch (prev.len) {
-            case 3:
-                prev.h ^= data[2] << 16;
-                /* fall through */
-            case 2:
-                prev.h ^= data[1] << 8;
-                /* fall through */
-            case 1:
-                prev.h ^= data[0];
-                prev.h *= m;
-        };
-
-        // Do a few final mixes of the hash to ensure the last few
-        // bytes are well-incorporated.
-
-        prev.h ^= prev.h >> 13;
-        prev.h *= m;
-        prev.h ^= prev.h >> 15;
-
-        prev.len = 0;
-    }
+    // The length without the filtered out characters is needed before actually calculating the hash,
+    // to setup the initial value for the hash.
+    Hasher hasher(static_cast<uint32_t>(countNonWhitespace(data, size)), seed);
+    constexpr std::size_t chunkSize = 64 * 1024;
+    for (std::size_t pos = 0; pos < size; pos += chunkSize)
+        hasher.addData(data + pos, std::min(chunkSize, size - pos));
+    return hasher.result();
 }
 
-}  // namespace Murmur2
\ No newline at end of file
+}  // namespace Murmur2
@@ -8,28 +8,36 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <vector>
 
 namespace Murmur2 {
 
-#define KiB 1024
-#define MiB 1024 * KiB
+// MurmurHash2 of the data, skipping the whitespace bytes (9, 10, 13 and 32) like CurseForge fingerprints do.
+// The data is scanned twice, once to count the bytes that are kept and once to hash them,
+// so it should already be in memory (or mapped).
+uint32_t hashWithoutWhitespace(const char* data, std::size_t size, uint32_t seed = 1);
 
-class Reader {
+// number of bytes in the data that are not whitespace
+std::size_t countNonWhitespace(const char* data, std::size_t size);
+
+// copies the bytes that are not whitespace to out, which may be the same as data. returns the number of bytes written
+std::size_t stripWhitespace(const char* data, std::size_t size, char* out);
+
+// incremental version of hashWithoutWhitespace, for data that is fed in chunks.
+// the number of bytes that are not whitespace has to be known upfront, it is part of the initial state
+class Hasher {
    public:
-    virtual ~Reader() = default;
-    virtual int read(char* s, int n) = 0;
-    virtual bool eof() = 0;
-    virtual void goToBeginning() = 0;
-};
+    explicit Hasher(uint32_t length, uint32_t seed = 1);
 
-uint32_t hash(Reader* file_stream, std::size_t buffer_size = 4 * MiB, std::function<bool(char)> filter_out = [](char) { return false; });
+    void addData(const char* data, std::size_t size);
+    uint32_t result() const;
 
-struct IncrementalHashInfo {
-    uint32_t h;
-    uint32_t len;
+   private:
+    uint32_t m_h;
+    std::vector<char> m_buffer;
+    std::size_t m_pending = 0;  // bytes at the start of the buffer that don't make up a whole word yet
 };
 
-void FourBytes_MurmurHash2(const unsigned char* data, IncrementalHashInfo& prev);
 }  // namespace Murmur2
@@ -15,6 +15,7 @@
   self,
   stripJavaArchivesHook,
   tomlplusplus,
+  xz,
   zlib,
 
   msaClientID ? null,
@@ -64,6 +65,7 @@ stdenv.mkDerivation {
       kdePackages.qtnetworkauth
       kdePackages.quazip
       tomlplusplus
+      xz
       zlib
     ]
     ++ lib.optionals stdenv.hostPlatform.isDarwin [ apple-sdk_11 ]
@@ -0,0 +1,102 @@
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <BlobStore.h>
+#include <FileSystem.h>
+
+#include "FileTestUtils.h"
+
+class BlobStoreTest : public QObject {
+    Q_OBJECT
+
+    QByteArray sha1(const QByteArray& data) { return QCryptographicHash::hash(data, QCryptographicHash::Sha1); }
+
+   private slots:
+    void test_AddMaterializeAndDrop()
+    {
+        QTemporaryDir tempDir;
+        if (!FS::canClone(tempDir.path(), tempDir.path()))
+            QSKIP("The temporary folder is not on a reflink capable filesystem");
+        QByteArray data("some mod jar");
+        auto hash = sha1(data);
+        auto first = tempDir.filePath("a/mods/mod.jar");
+        auto second = tempDir.filePath("b/mods/mod.jar");
+        QVERIFY(FS::ensureFilePathExists(first));
+        FileTestUtils::writeFile(first, data);
+
+        BlobStore store(tempDir.filePath("blobs"));
+        QVERIFY(!store.contains(QCryptographicHash::Sha1, hash));
+        QVERIFY(store.add(first, QCryptographicHash::Sha1, hash));
+        QVERIFY(store.contains(QCryptographicHash::Sha1, hash));
+        QCOMPARE(FS::read(store.blobPath(QCryptographicHash::Sha1, hash)), data);
+
+        QVERIFY(store.materialize(QCryptographicHash::Sha1, hash, second));
+        QCOMPARE(FS::read(second), data);
+
+        // the copies are independent of the blob
+        FileTestUtils::writeFile(second, "changed");
+        QCOMPARE(FS::read(store.blobPath(QCryptographicHash::Sha1, hash)), data);
+
+        // the first file still references the blob
+        QVERIFY(QFile::remove(second));
+        QCOMPARE(store.collectGarbage(), 0);
+        QVERIFY(store.contains(QCryptographicHash::Sha1, hash));
+
+        QVERIFY(QFile::remove(first));
+        QCOMPARE(store.collectGarbage(), data.size());
+        QVERIFY(!store.contains(QCryptographicHash::Sha1, hash));
+        QVERIFY(!store.materialize(QCryptographicHash::Sha1, hash, second));
+    }
+
+    void test_References()
+    {
+        QTemporaryDir tempDir;
+        if (!FS::canClone(tempDir.path(), tempDir.path()))
+            QSKIP("The temporary folder is not on a reflink capable filesystem");
+        QByteArray data("some mod jar");
+        auto hash = sha1(data);
+        auto path = tempDir.filePath("instance/mods/mod.jar");
+        QVERIFY(FS::ensureFilePathExists(path));
+        FileTestUtils::writeFile(path, data);
+        {
+            BlobStore store(tempDir.filePath("blobs"));
+            QVERIFY(store.add(path, QCryptographicHash::Sha1, hash));
+        }
+
+        // the references survive a restart and follow a moved instance
+        QVERIFY(QDir(tempDir.path()).rename("instance", "moved"));
+        BlobStore store(tempDir.filePath("blobs"));
+        store.relocate(tempDir.filePath("instance"), tempDir.filePath("moved"));
+        QCOMPARE(store.collectGarbage(), 0);
+        QVERIFY(store.contains(QCryptographicHash::Sha1, hash));
+
+        // a file that was replaced by something else does not keep the blob alive
+        FileTestUtils::writeFile(tempDir.filePath("moved/mods/mod.jar"), "another version");
+        QCOMPARE(store.collectGarbage(), data.size());
+        QVERIFY(!store.contains(QCryptographicHash::Sha1, hash));
+    }
+
+    void test_Unsupported()
+    {
+        QTemporaryDir tempDir;
+        if (FS::canClone(tempDir.path(), tempDir.path()))
+            QSKIP("The temporary folder is on a reflink capable filesystem");
+        QByteArray data("some mod jar");
+        auto hash = sha1(data);
+        auto path = tempDir.filePath("mod.jar");
+        FileTestUtils::writeFile(path, data);
+
+        // without reflinks the store would only hold a second copy of every file
+        BlobStore store(tempDir.filePath("blobs"));
+        QVERIFY(!store.add(path, QCryptographicHash::Sha1, hash));
+        QVERIFY(!store.contains(QCryptographicHash::Sha1, hash));
+        QCOMPARE(FS::read(path), data);
+    }
+};
+
+QTEST_GUILESS_MAIN(BlobStoreTest)
+
+#include "BlobStore_test.moc"
@@ -0,0 +1,67 @@
+#include <QTest>
+
+#include <CensorFilter.h>
+
+class CensorFilterTest : public QObject {
+    Q_OBJECT
+
+    // the filter used to be applied one secret after another with QString::replace
+    static QString reference(QString in, const QMap<QString, QString>& filter)
+    {
+        for (auto it = filter.constBegin(); it != filter.constEnd(); ++it)
+            in.replace(it.key(), it.value());
+        return in;
+    }
+
+   private slots:
+    void test_empty()
+    {
+        CensorFilter filter;
+        QVERIFY(filter.isEmpty());
+        QCOMPARE(filter.censor("nothing to see here"), QString("nothing to see here"));
+
+        CensorFilter emptyKey({ { "", "<EMPTY>" } });
+        QVERIFY(emptyKey.isEmpty());
+        QCOMPARE(emptyKey.censor("abc"), QString("abc"));
+    }
+
+    void test_censor_data()
+    {
+        QTest::addColumn<QString>("input");
+        QTest::addColumn<QString>("expected");
+
+        QTest::newRow("no match") << "Setting up the game" << "Setting up the game";
+        QTest::newRow("single") << "--accessToken abcdef123 --version 1.20" << "--accessToken <ACCESS TOKEN> --version 1.20";
+        QTest::newRow("multiple") << "Steve 0a1b2c3d abcdef123" << "<PLAYER NAME> <PROFILE ID> <ACCESS TOKEN>";
+        QTest::newRow("repeated") << "abcdef123abcdef123" << "<ACCESS TOKEN><ACCESS TOKEN>";
+        QTest::newRow("edges") << "Steve" << "<PLAYER NAME>";
+        QTest::newRow("overlapping") << "--session token:abcdef123:0a1b2c3d" << "--session <SESSION ID>";
+        QTest::newRow("partial") << "abcdef12 Stev" << "abcdef12 Stev";
+        QTest::newRow("unicode") << "Grüße, Steve!" << "Grüße, <PLAYER NAME>!";
+    }
+
+    void test_censor()
+    {
+        QFETCH(QString, input);
+        QFETCH(QString, expected);
+
+        CensorFilter filter({ { "abcdef123", "<ACCESS TOKEN>" },
+                              { "token:abcdef123:0a1b2c3d", "<SESSION ID>" },
+                              { "0a1b2c3d", "<PROFILE ID>" },
+                              { "Steve", "<PLAYER NAME>" } });
+        QCOMPARE(filter.censor(input), expected);
+    }
+
+    void test_matchesReplace()
+    {
+        // without overlapping secrets the result has to be the same as replacing them one by one
+        QMap<QString, QString> secrets{ { "aab", "<1>" }, { "ba", "<2>" }, { "cab", "<3>" }, { "xyz", "<4>" } };
+        CensorFilter filter(secrets);
+        for (auto& line : { "aab ba cab", "aaab xyz", "xyzxyz aab", "cacab", "ba" })
+            QCOMPARE(filter.censor(line), reference(line, secrets));
+    }
+};
+
+QTEST_GUILESS_MAIN(CensorFilterTest)
+
+#include "CensorFilter_test.moc"
@@ -1,4 +1,7 @@
+#include <QDateTime>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QStandardPaths>
 #include <QTemporaryDir>
 #include <QTest>
@@ -8,6 +11,8 @@
 #include <FileSystem.h>
 #include <StringUtils.h>
 
+#include "FileTestUtils.h"
+
 // Snippet from https://github.com/gulrak/filesystem#using-it-as-single-file-header
 
 #ifdef __APPLE__
@@ -731,6 +736,45 @@ class FileSystemTest : public QObject {
         QCOMPARE(FS::pathTruncate("C:\\bar\\foo.txt", 1), QDir::toNativeSeparators("C:\\bar"));
 #endif
     }
+
+    void test_fingerprint()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("file.bin");
+        using namespace FileTestUtils;
+        auto modified = QDateTime::currentDateTimeUtc().addSecs(-3600);
+
+        QVERIFY(!FS::fingerprint(QFileInfo(path)).isValid());
+        QVERIFY(!FS::fingerprint(QFileInfo(tempDir.path())).isValid());
+
+        writeFile(path, "contents");
+        setModified(path, modified);
+        auto original = FS::fingerprint(QFileInfo(path));
+        QVERIFY(original.isValid());
+        QCOMPARE(original.size, qint64(8));
+        QCOMPARE(original.modified, modified.toMSecsSinceEpoch());
+        QVERIFY(FS::fingerprint(QFileInfo(path)) == original);
+
+        // same size and timestamp, but another file took its place
+        replaceFile(path, "CONTENTS");
+        auto replaced = FS::fingerprint(QFileInfo(path));
+        QCOMPARE(replaced.size, original.size);
+        QCOMPARE(replaced.modified, original.modified);
+        QVERIFY(replaced != original);
+#ifndef Q_OS_WIN
+        QVERIFY(replaced.inode != original.inode);
+#endif
+
+        setModified(path, modified.addSecs(1));
+        auto touched = FS::fingerprint(QFileInfo(path));
+        QVERIFY(touched != replaced);
+        QCOMPARE(touched.modified, modified.addSecs(1).toMSecsSinceEpoch());
+
+        writeFile(path, "other contents");
+        auto rewritten = FS::fingerprint(QFileInfo(path));
+        QVERIFY(rewritten != touched);
+        QCOMPARE(rewritten.size, qint64(14));
+    }
 };
 
 QTEST_GUILESS_MAIN(FileSystemTest)
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTest>
+
+/* Helpers for the tests of everything that keys off the fingerprint of local files. */
+namespace FileTestUtils {
+
+inline void writeFile(const QString& path, const QByteArray& data)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(data), data.size());
+}
+
+inline void setModified(const QString& path, const QDateTime& time)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(time, QFileDevice::FileModificationTime));
+}
+
+/// puts a new file in place of \p path, with the same size and modification time but another inode
+inline void replaceFile(const QString& path, const QByteArray& data)
+{
+    auto modified = QFileInfo(path).lastModified();
+    auto replacement = path + ".new";
+    writeFile(replacement, data);
+    setModified(replacement, modified);
+    QVERIFY(QFile::remove(path));
+    QVERIFY(QFile::rename(replacement, path));
+}
+
+}  // namespace FileTestUtils
@@ -0,0 +1,192 @@
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FingerprintCache.h>
+#include <Json.h>
+
+#include "FileTestUtils.h"
+
+using namespace FileTestUtils;
+
+namespace {
+using StringCache = FingerprintCache<QString>;
+
+StringCache::Settings settings(const QString& file, int version = 1, int saveThreshold = 0, qint64 maxUnusedSecs = 0)
+{
+    return { file, "test cache", version, saveThreshold, maxUnusedSecs };
+}
+
+QJsonObject toJson(const QString& value)
+{
+    QJsonObject obj;
+    obj.insert("text", value);
+    return obj;
+}
+
+QString fromJson(const QJsonObject& obj)
+{
+    return Json::requireString(obj, "text");
+}
+
+FS::FileFingerprint fingerprint(const QString& path)
+{
+    return FS::fingerprint(QFileInfo(path));
+}
+
+QJsonArray storedEntries(const QString& file)
+{
+    return Json::requireArray(Json::requireObject(Json::requireDocument(file)), "entries");
+}
+}  // namespace
+
+class FingerprintCacheTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_Invalidation()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("file");
+        auto modified = QDateTime::currentDateTimeUtc().addSecs(-3600);
+        writeFile(path, "contents");
+        setModified(path, modified);
+
+        StringCache cache(settings(tempDir.filePath("cache.json")), toJson, fromJson);
+        QVERIFY(!cache.find(path, fingerprint(path)).has_value());
+        cache.insert(path, fingerprint(path), "value");
+        QCOMPARE(cache.find(path, fingerprint(path)).value_or(QString()), QString("value"));
+
+        // another file with the same size and modification time
+        replaceFile(path, "CONTENTS");
+        QVERIFY(!cache.find(path, fingerprint(path)).has_value());
+        cache.insert(path, fingerprint(path), "value");
+
+        setModified(path, modified.addSecs(1));
+        QVERIFY(!cache.find(path, fingerprint(path)).has_value());
+        cache.insert(path, fingerprint(path), "value");
+
+        writeFile(path, "longer contents");
+        QVERIFY(!cache.find(path, fingerprint(path)).has_value());
+        cache.insert(path, fingerprint(path), "value");
+
+        // a missing file never matches, and drops what was stored for it
+        auto last = fingerprint(path);
+        QVERIFY(cache.find(path, last).has_value());
+        QVERIFY(QFile::remove(path));
+        QVERIFY(!cache.find(path, fingerprint(path)).has_value());
+        cache.insert(path, fingerprint(path), "value");
+        QVERIFY(!cache.find(path, last).has_value());
+    }
+
+    void test_Persistence()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("file");
+        auto gone = tempDir.filePath("gone");
+        writeFile(path, "contents");
+        writeFile(gone, "contents");
+        auto cacheFile = tempDir.filePath("cache.json");
+
+        {
+            StringCache cache(settings(cacheFile), toJson, fromJson);
+            cache.insert(path, fingerprint(path), "kept");
+            cache.insert(gone, fingerprint(gone), "dropped");
+            cache.retain({ path });
+        }
+        QVERIFY(QFile::exists(cacheFile));
+        QCOMPARE(storedEntries(cacheFile).size(), 1);
+
+        StringCache cache(settings(cacheFile), toJson, fromJson);
+        QCOMPARE(cache.find(path, fingerprint(path)).value_or(QString()), QString("kept"));
+        QVERIFY(!cache.find(gone, fingerprint(gone)).has_value());
+
+        // other versions are ignored
+        StringCache newer(settings(cacheFile, 2), toJson, fromJson);
+        QVERIFY(!newer.find(path, fingerprint(path)).has_value());
+    }
+
+    void test_InvalidFile()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("file");
+        writeFile(path, "contents");
+        auto cacheFile = tempDir.filePath("cache.json");
+
+        writeFile(cacheFile, "{ not json");
+        {
+            StringCache cache(settings(cacheFile), toJson, fromJson);
+            QVERIFY(!cache.find(path, fingerprint(path)).has_value());
+            cache.insert(path, fingerprint(path), "value");
+        }
+
+        // a value that can't be read drops the whole file
+        auto entries = storedEntries(cacheFile);
+        QCOMPARE(entries.size(), 1);
+        auto entry = entries.first().toObject();
+        entry.insert("value", QJsonObject());
+        QJsonObject root;
+        root.insert("version", 1);
+        root.insert("entries", QJsonArray{ entry });
+        writeFile(cacheFile, QJsonDocument(root).toJson());
+        StringCache cache(settings(cacheFile), toJson, fromJson);
+        QVERIFY(!cache.find(path, fingerprint(path)).has_value());
+    }
+
+    void test_SaveThreshold()
+    {
+        QTemporaryDir tempDir;
+        auto cacheFile = tempDir.filePath("cache.json");
+        StringCache cache(settings(cacheFile, 1, 3), toJson, fromJson);
+        for (int i = 0; i < 3; i++) {
+            auto path = tempDir.filePath(QString("file%1").arg(i));
+            writeFile(path, "contents");
+            QVERIFY(!QFile::exists(cacheFile));
+            cache.insert(path, fingerprint(path), "value");
+        }
+        QVERIFY(QFile::exists(cacheFile));
+        QCOMPARE(storedEntries(cacheFile).size(), 3);
+    }
+
+    void test_Expiry()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("file");
+        auto unused = tempDir.filePath("unused");
+        writeFile(path, "contents");
+        writeFile(unused, "contents");
+        auto cacheFile = tempDir.filePath("cache.json");
+        {
+            StringCache cache(settings(cacheFile), toJson, fromJson);
+            cache.insert(path, fingerprint(path), "used");
+            cache.insert(unused, fingerprint(unused), "unused");
+        }
+
+        // pretend both were last used 40 days ago
+        auto entries = storedEntries(cacheFile);
+        for (auto&& value : entries) {
+            auto entry = value.toObject();
+            entry.insert("last_used", QDateTime::currentSecsSinceEpoch() - 40 * 24 * 60 * 60);
+            value = entry;
+        }
+        QJsonObject root;
+        root.insert("version", 1);
+        root.insert("entries", entries);
+        writeFile(cacheFile, QJsonDocument(root).toJson());
+
+        // entries are kept for a month by default
+        {
+            StringCache cache({ cacheFile, "test cache" }, toJson, fromJson);
+            QVERIFY(cache.find(path, fingerprint(path)).has_value());
+        }
+        StringCache cache({ cacheFile, "test cache" }, toJson, fromJson);
+        QVERIFY(cache.find(path, fingerprint(path)).has_value());
+        QVERIFY(!cache.find(unused, fingerprint(unused)).has_value());
+    }
+};
+
+QTEST_GUILESS_MAIN(FingerprintCacheTest)
+
+#include "FingerprintCache_test.moc"
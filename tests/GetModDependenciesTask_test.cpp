@@ -0,0 +1,201 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <Json.h>
+
+#include <minecraft/MinecraftInstance.h>
+#include <minecraft/mod/tasks/GetModDependenciesTask.h>
+#include <settings/INISettingsObject.h>
+#include <ui/pages/modplatform/ModModel.h>
+
+#include "DummyResourceAPI.h"
+
+using Provider = GetModDependenciesTask::Provider;
+
+/* Answers with canned versions and projects, and remembers what it was asked for. */
+class DependencyAPI : public ResourceAPI {
+   public:
+    // the answer to a dependency lookup, by version id, or by project id for the dependencies without a version
+    QHash<QString, QJsonDocument> versions;
+    QHash<QString, QJsonObject> projects;
+    mutable QStringList requests;
+
+    [[nodiscard]] auto getSortingMethods() const -> QList<SortingMethod> override { return {}; }
+
+    [[nodiscard]] Task::Ptr getDependencyVersion(DependencySearchArgs&& args, DependencySearchCallbacks&& callbacks) const override
+    {
+        auto dep = args.dependency;
+        auto key = dep.addonId.toString().isEmpty() ? dep.version : dep.addonId.toString();
+        requests << "version " + key;
+        auto task = makeShared<SearchTask>();
+        QObject::connect(task.get(), &Task::succeeded, [this, key, dep, callbacks] {
+            auto doc = versions.value(key);
+            callbacks.on_succeed(doc, dep);
+        });
+        return task;
+    }
+
+    [[nodiscard]] Task::Ptr getProject(QString addonId, std::shared_ptr<QByteArray> response) const override
+    {
+        requests << "project " + addonId;
+        auto task = makeShared<SearchTask>();
+        QObject::connect(task.get(), &Task::succeeded,
+                         [this, addonId, response] { *response = QJsonDocument(projects.value(addonId)).toJson(); });
+        return task;
+    }
+
+    [[nodiscard]] Task::Ptr getProjects(QStringList addonIds, std::shared_ptr<QByteArray> response) const override
+    {
+        addonIds.sort();
+        requests << "projects " + addonIds.join(',');
+        auto task = makeShared<SearchTask>();
+        QObject::connect(task.get(), &Task::succeeded, [this, addonIds, response] {
+            QJsonArray arr;
+            for (auto& id : addonIds)
+                arr.append(projects.value(id));
+            *response = QJsonDocument(arr).toJson();
+        });
+        return task;
+    }
+};
+
+/* Reads the simplified versions and projects DependencyAPI answers with. */
+class DependencyModel : public ResourceDownload::ModModel {
+    Q_OBJECT
+   public:
+    DependencyModel(BaseInstance& instance) : ModModel(instance, new DependencyAPI) {}
+
+    [[nodiscard]] auto metaEntryBase() const -> QString override { return ""; }
+
+    void loadIndexedPack(ModPlatform::IndexedPack& pack, QJsonObject& obj) override { pack.name = Json::requireString(obj, "title"); }
+    void loadExtraPackInfo(ModPlatform::IndexedPack&, QJsonObject&) override {}
+    void loadIndexedPackVersions(ModPlatform::IndexedPack&, QJsonArray&) override {}
+
+    ModPlatform::IndexedVersion loadDependencyVersions(const ModPlatform::Dependency&, QJsonArray& arr) override
+    {
+        ModPlatform::IndexedVersion version;
+        if (arr.isEmpty())
+            return version;
+        auto obj = Json::requireObject(arr.first());
+        version.addonId = Json::requireString(obj, "project_id");
+        version.fileId = Json::requireString(obj, "id");
+        version.version = version.fileId.toString();
+        version.fileName = Json::requireString(obj, "file_name");
+        for (auto dep : Json::ensureArray(obj, "dependencies")) {
+            auto depObj = Json::requireObject(dep);
+            version.dependencies.append({ Json::ensureString(depObj, "project_id"), ModPlatform::DependencyType::REQUIRED,
+                                          Json::ensureString(depObj, "version_id") });
+        }
+        return version;
+    }
+
+   protected:
+    auto documentToArray(QJsonDocument& doc) const -> QJsonArray override { return doc.array(); }
+};
+
+class DependenciesTask : public GetModDependenciesTask {
+    Q_OBJECT
+   public:
+    DependenciesTask(QList<std::shared_ptr<PackDependency>> selected, Provider flame, Provider modrinth)
+        : GetModDependenciesTask(selected, flame, modrinth, Version("1.20.1"), {}, 1)
+    {
+        prepare();
+    }
+};
+
+class GetModDependenciesTaskTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_tempDir;
+    SettingsObjectPtr m_globalSettings;
+    MinecraftInstancePtr m_instance;
+
+    static QJsonObject versionObject(const QString& project, const QString& id, QJsonArray dependencies = {})
+    {
+        return { { "project_id", project }, { "id", id }, { "file_name", id + ".jar" }, { "dependencies", dependencies } };
+    }
+
+    static std::shared_ptr<GetModDependenciesTask::PackDependency> selected(QList<ModPlatform::Dependency> dependencies)
+    {
+        auto pack = std::make_shared<ModPlatform::IndexedPack>();
+        pack->addonId = "main";
+        pack->provider = ModPlatform::ResourceProvider::MODRINTH;
+        pack->name = "Main";
+        ModPlatform::IndexedVersion version;
+        version.addonId = "main";
+        version.fileId = "main-1";
+        version.version = "main-1";
+        version.fileName = "main-1.jar";
+        version.dependencies = dependencies;
+        return std::make_shared<GetModDependenciesTask::PackDependency>(pack, version);
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        // what the instance pulls from the global settings
+        m_globalSettings = std::make_shared<INISettingsObject>(m_tempDir.filePath("global.cfg"));
+        m_globalSettings->registerSetting("ShowGameTime", true);
+        m_globalSettings->registerSetting("RecordGameTime", true);
+        m_globalSettings->registerSetting({ "PreLaunchCommand", "PreLaunchCmd" }, "");
+        m_globalSettings->registerSetting("WrapperCommand", "");
+        m_globalSettings->registerSetting({ "PostExitCommand", "PostExitCmd" }, "");
+        m_globalSettings->registerSetting("ShowConsole", false);
+        m_globalSettings->registerSetting("AutoCloseConsole", false);
+        m_globalSettings->registerSetting("ShowConsoleOnError", true);
+        m_globalSettings->registerSetting("LogPrePostOutput", true);
+        m_globalSettings->registerSetting("ConsoleMaxLines", 100000);
+        m_globalSettings->registerSetting("ConsoleOverflowStop", true);
+        auto settings = std::make_shared<INISettingsObject>(m_tempDir.filePath("instance.cfg"));
+        m_instance = std::make_shared<MinecraftInstance>(m_globalSettings, settings, m_tempDir.path());
+    }
+
+    void test_sharedProjectIsFilledIn()
+    {
+        auto flameApi = std::make_shared<DependencyAPI>();
+        auto modrinthApi = std::make_shared<DependencyAPI>();
+        // two versions of the same library, one needed by the mod itself and one by the api it needs
+        modrinthApi->versions["lib-1"] = QJsonDocument(versionObject("lib", "lib-1"));
+        modrinthApi->versions["lib-2"] = QJsonDocument(versionObject("lib", "lib-2"));
+        // nothing fits the instance, so it is dropped, and the api asks for it again once it is gone
+        modrinthApi->versions["missing"] = QJsonDocument(QJsonArray());
+        QJsonArray apiDependencies{ QJsonObject{ { "project_id", "missing" } }, QJsonObject{ { "version_id", "lib-2" } } };
+        modrinthApi->versions["api"] = QJsonDocument(QJsonArray{ versionObject("api", "api-1", apiDependencies) });
+        modrinthApi->projects["lib"] = { { "id", "lib" }, { "title", "Lib" } };
+        modrinthApi->projects["api"] = { { "id", "api" }, { "title", "API" } };
+
+        auto dependency = [](const QString& project, const QString& version = {}) {
+            return ModPlatform::Dependency{ project.isEmpty() ? QVariant() : QVariant(project), ModPlatform::DependencyType::REQUIRED,
+                                            version };
+        };
+        QList<std::shared_ptr<GetModDependenciesTask::PackDependency>> mods{ selected(
+            { dependency({}, "lib-1"), dependency("missing"), dependency("api") }) };
+        auto task = makeShared<DependenciesTask>(
+            mods, Provider{ ModPlatform::ResourceProvider::FLAME, std::make_shared<DependencyModel>(*m_instance), flameApi },
+            Provider{ ModPlatform::ResourceProvider::MODRINTH, std::make_shared<DependencyModel>(*m_instance), modrinthApi });
+        task->start();
+        QTRY_VERIFY(task->isFinished());
+        QVERIFY(task->wasSuccessful());
+
+        // every dependency is looked up once, and the project info of all of them is fetched together
+        QCOMPARE(modrinthApi->requests,
+                 QStringList({ "version lib-1", "version missing", "version api", "version lib-2", "projects api,lib" }));
+        QVERIFY(flameApi->requests.isEmpty());
+
+        auto dependencies = task->getDependecies();
+        QCOMPARE(dependencies.size(), 3);
+        QStringList found;
+        for (auto& dep : dependencies) {
+            QVERIFY(!dep->pack->name.isEmpty());
+            found << QString("%1 %2 %3").arg(dep->pack->addonId.toString(), dep->pack->name, dep->version.version);
+        }
+        found.sort();
+        QCOMPARE(found, QStringList({ "api API api-1", "lib Lib lib-1", "lib Lib lib-2" }));
+    }
+};
+
+QTEST_GUILESS_MAIN(GetModDependenciesTaskTest)
+
+#include "GetModDependenciesTask_test.moc"
+
+#include "moc_DummyResourceAPI.cpp"
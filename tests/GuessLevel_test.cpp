@@ -0,0 +1,101 @@
+#include <QRegularExpression>
+#include <QTest>
+
+#include <minecraft/MinecraftInstance.h>
+
+namespace {
+// the per line regex compilation MinecraftInstance::guessLevel used before, kept as the reference
+MessageLevel::Enum referenceGuessLevel(const QString& line, MessageLevel::Enum level)
+{
+    QRegularExpression re("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
+    auto match = re.match(line);
+    if (match.hasMatch()) {
+        QString levelStr = match.captured("level");
+        if (levelStr == "INFO")
+            level = MessageLevel::Message;
+        if (levelStr == "WARN")
+            level = MessageLevel::Warning;
+        if (levelStr == "ERROR")
+            level = MessageLevel::Error;
+        if (levelStr == "FATAL")
+            level = MessageLevel::Fatal;
+        if (levelStr == "TRACE" || levelStr == "DEBUG")
+            level = MessageLevel::Debug;
+    } else {
+        if (line.contains("[INFO]") || line.contains("[CONFIG]") || line.contains("[FINE]") || line.contains("[FINER]") ||
+            line.contains("[FINEST]"))
+            level = MessageLevel::Message;
+        if (line.contains("[SEVERE]") || line.contains("[STDERR]"))
+            level = MessageLevel::Error;
+        if (line.contains("[WARNING]"))
+            level = MessageLevel::Warning;
+        if (line.contains("[DEBUG]"))
+            level = MessageLevel::Debug;
+    }
+    if (line.contains("overwriting existing"))
+        return MessageLevel::Fatal;
+    static const QString javaSymbol = "([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$][a-zA-Z\\d_$]*";
+    if (line.contains("Exception in thread") || line.contains(QRegularExpression("\\s+at " + javaSymbol)) ||
+        line.contains(QRegularExpression("Caused by: " + javaSymbol)) ||
+        line.contains(QRegularExpression("([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$]?[a-zA-Z\\d_$]*(Exception|Error|Throwable)")) ||
+        line.contains(QRegularExpression("... \\d+ more$")))
+        return MessageLevel::Error;
+    return level;
+}
+
+// lines shaped like the startup of a modded client: mostly log4j lines, some old forge lines and stack traces
+QStringList sampleLog()
+{
+    static const QStringList templates = {
+        "[12:34:56] [Render thread/INFO]: Loading %1 models for mod example%1",
+        "[12:34:56] [Worker-Main-%1/WARN]: Missing texture minecraft:block/example_%1",
+        "[12:34:56] [main/DEBUG]: Registered %1 entries in registry minecraft:item",
+        "[12:34:57] [Server thread/ERROR]: Failed to load recipe example:recipe_%1",
+        "[12:34:57] [main/TRACE]: Scanning class net.example.mod%1.Main",
+        "2024-01-01 12:34:56 [INFO] [ForgeModLoader] Found mod file example%1.jar",
+        "2024-01-01 12:34:56 [SEVERE] [ForgeModLoader] Could not load example%1",
+        "java.lang.IllegalStateException: Invalid state %1",
+        "\tat net.example.mod%1.Main.init(Main.java:%1)",
+        "Caused by: java.io.IOException: Stream closed %1",
+        "\t... %1 more",
+        "Setting user: Player%1",
+        "Some plain output from a mod, nothing to see here %1",
+        "[12:34:58] [Render thread/FATAL]: Reported exception thrown! %1",
+        "Model overwriting existing one %1",
+    };
+    QStringList lines;
+    lines.reserve(3000);
+    for (int i = 0; i < 3000; i++) {
+        // the log4j info lines are by far the most common ones
+        auto& pattern = i % 3 ? templates[0] : templates[(i / 3) % templates.size()];
+        lines.append(pattern.arg(i));
+    }
+    return lines;
+}
+}  // namespace
+
+class GuessLevelTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_matchesReference()
+    {
+        for (auto& line : sampleLog()) {
+            for (auto level : { MessageLevel::Unknown, MessageLevel::Launcher, MessageLevel::StdOut, MessageLevel::StdErr }) {
+                QCOMPARE(MinecraftInstance::guessLogLevel(line, level), referenceGuessLevel(line, level));
+            }
+        }
+    }
+
+    void test_levels()
+    {
+        QCOMPARE(MinecraftInstance::guessLogLevel("[12:00:00] [main/WARN]: something", MessageLevel::StdOut), MessageLevel::Warning);
+        QCOMPARE(MinecraftInstance::guessLogLevel("\tat net.minecraft.client.Main.main(Main.java:1)", MessageLevel::StdOut),
+                 MessageLevel::Error);
+        QCOMPARE(MinecraftInstance::guessLogLevel("plain text", MessageLevel::StdOut), MessageLevel::StdOut);
+    }
+};
+
+QTEST_GUILESS_MAIN(GuessLevelTest)
+
+#include "GuessLevel_test.moc"
@@ -0,0 +1,121 @@
+#include <QCryptographicHash>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <Json.h>
+#include <modplatform/helpers/HashCache.h>
+
+#include "FileTestUtils.h"
+
+using namespace FileTestUtils;
+
+class HashCacheTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_Digests()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("mod.jar");
+        QByteArray data("some mod\tcontents\n");
+        writeFile(path, data);
+
+        Hashing::HashCache cache(tempDir.filePath("hashcache.json"));
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Sha1), QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Sha512), QCryptographicHash::hash(data, QCryptographicHash::Sha512).toHex());
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Md5), QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Murmur2), Hashing::hash(data, Hashing::Algorithm::Murmur2));
+        // not cached, but still hashed
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Sha256), QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+
+        QVERIFY(cache.hash(tempDir.filePath("missing.jar"), Hashing::Algorithm::Sha1).isEmpty());
+    }
+
+    void test_MultiHasher()
+    {
+        // bigger than a chunk, so the hashes see several of them
+        QByteArray data;
+        for (int i = 0; i < 100000; i++)
+            data.append(QByteArray::number(i) + ' ');
+
+        Hashing::MultiHasher hasher({ Hashing::Algorithm::Sha1, Hashing::Algorithm::Sha512, Hashing::Algorithm::Murmur2 });
+        QVERIFY(hasher.hashData(data));
+        auto digests = hasher.results();
+        QCOMPARE(digests.size(), 3);
+        QCOMPARE(digests[Hashing::Algorithm::Sha1], Hashing::hash(data, Hashing::Algorithm::Sha1));
+        QCOMPARE(digests[Hashing::Algorithm::Sha512], Hashing::hash(data, Hashing::Algorithm::Sha512));
+        QCOMPARE(digests[Hashing::Algorithm::Murmur2], Hashing::hash(data, Hashing::Algorithm::Murmur2));
+    }
+
+    void test_HashFiles()
+    {
+        QTemporaryDir tempDir;
+        QStringList paths;
+        for (int i = 0; i < 20; i++) {
+            paths.append(tempDir.filePath(QString("mod%1.jar").arg(i)));
+            writeFile(paths.last(), QByteArray::number(i));
+        }
+        paths.append(tempDir.filePath("missing.jar"));
+
+        auto future = Hashing::hashFiles(paths, { Hashing::Algorithm::Sha512, Hashing::Algorithm::Sha1 });
+        future.waitForFinished();
+        QCOMPARE(future.resultCount(), paths.size());
+        for (int i = 0; i < 20; i++) {
+            auto digests = future.resultAt(i);
+            QCOMPARE(digests[Hashing::Algorithm::Sha1], QCryptographicHash::hash(QByteArray::number(i), QCryptographicHash::Sha1).toHex());
+            QCOMPARE(digests[Hashing::Algorithm::Sha512],
+                     QCryptographicHash::hash(QByteArray::number(i), QCryptographicHash::Sha512).toHex());
+        }
+        QVERIFY(future.resultAt(20).isEmpty());
+    }
+
+    void test_Invalidation()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("mod.jar");
+        writeFile(path, "first");
+
+        Hashing::HashCache cache(tempDir.filePath("hashcache.json"));
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Sha1), QCryptographicHash::hash("first", QCryptographicHash::Sha1).toHex());
+
+        // a different size is enough to notice the change, even within the same mtime
+        writeFile(path, "second");
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Sha1), QCryptographicHash::hash("second", QCryptographicHash::Sha1).toHex());
+    }
+
+    void test_Persistence()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("mod.jar");
+        writeFile(path, "contents");
+        auto cacheFile = tempDir.filePath("hashcache.json");
+
+        {
+            Hashing::HashCache cache(cacheFile);
+            QCOMPARE(cache.hash(path, Hashing::Algorithm::Sha1), QCryptographicHash::hash("contents", QCryptographicHash::Sha1).toHex());
+        }
+        QVERIFY(QFile::exists(cacheFile));
+
+        // the digests come from the file now, the mod itself isn't read again
+        auto root = Json::requireObject(Json::requireDocument(cacheFile));
+        auto entries = Json::requireArray(root, "entries");
+        QCOMPARE(entries.size(), 1);
+        auto entry = entries.first().toObject();
+        auto digests = Json::requireObject(entry, "value");
+        digests.insert("sha1", "cached sha1");
+        entry.insert("value", digests);
+        root.insert("entries", QJsonArray{ entry });
+        writeFile(cacheFile, QJsonDocument(root).toJson());
+
+        Hashing::HashCache cache(cacheFile);
+        QCOMPARE(cache.hash(path, Hashing::Algorithm::Sha1), QString("cached sha1"));
+    }
+};
+
+QTEST_GUILESS_MAIN(HashCacheTest)
+
+#include "HashCache_test.moc"
@@ -3,12 +3,24 @@
 #include <settings/INIFile.h>
 #include <QList>
 #include <QSettings>
+#include <QSize>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QVariant>
 #include "FileSystem.h"
 
 #include <QVariantUtils.h>
 
+// QSettings hands back strings for most types, so compare what callers actually read out of the values
+void compareValues(const QVariant& actual, const QVariant& expected)
+{
+    QCOMPARE(actual.isValid(), expected.isValid());
+    QCOMPARE(actual.userType(), expected.userType());
+    QCOMPARE(actual.toString(), expected.toString());
+    QCOMPARE(actual.toStringList(), expected.toStringList());
+    QCOMPARE(actual.toByteArray(), expected.toByteArray());
+}
+
 class IniFileTest : public QObject {
     Q_OBJECT
    private slots:
@@ -190,6 +202,127 @@ PreLaunchCommand=)";
         FS::deletePath(fileName);
 #endif
     }
+
+    void test_QSettingsCompat_data()
+    {
+        QTest::addColumn<QVariant>("value");
+
+        QTest::newRow("plain") << QVariant("value");
+        QTest::newRow("padded") << QVariant("  padded  ");
+        QTest::newRow("quotes") << QVariant(R"("value2" with quotes)");
+        QTest::newRow("special characters") << QVariant("val=\"$INST_JAVA\" -jar; ls ");
+        QTest::newRow("commas") << QVariant("1,2,3,4");
+        QTest::newRow("escapes") << QVariant(QString("a\nb\t\\c\r\x01") + "1f");
+        QTest::newRow("null character") << QVariant(QString("a") + QChar(0) + "1");
+        QTest::newRow("unicode") << QVariant(QString::fromUtf8("Ünïcødé ☃ \xF0\x9F\x99\x82"));
+        QTest::newRow("at sign") << QVariant("@home");
+        QTest::newRow("double at sign") << QVariant("@@");
+        QTest::newRow("empty") << QVariant("");
+        QTest::newRow("string list") << QVariant(QStringList{ "a", "b, c", "\"d\"", " e " });
+        QTest::newRow("empty list") << QVariant(QStringList{});
+        QTest::newRow("single element list") << QVariant(QStringList{ "only" });
+        QTest::newRow("list with at signs") << QVariant(QStringList{ "@a", "b" });
+        QTest::newRow("variant list") << QVariant(QVariantList{ 1, "two", 3.5 });
+        QTest::newRow("int") << QVariant(42);
+        QTest::newRow("bool") << QVariant(true);
+        QTest::newRow("double") << QVariant(0.1);
+        QTest::newRow("byte array") << QVariant(QByteArray("\x00\xff binary", 9));
+        QTest::newRow("size") << QVariant(QSize(854, 480));
+    }
+
+    void test_QSettingsCompat()
+    {
+        QFETCH(QVariant, value);
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        // written by QSettings, read by both
+        QString theirs = dir.filePath("qsettings.ini");
+        {
+            QSettings settings{ theirs, QSettings::Format::IniFormat };
+            settings.setValue("ConfigVersion", "1.2");
+            settings.setValue("value", value);
+            settings.sync();
+            QCOMPARE(settings.status(), QSettings::Status::NoError);
+        }
+        INIFile f1;
+        QVERIFY(f1.loadFile(theirs));
+        QSettings reference1{ theirs, QSettings::Format::IniFormat };
+        compareValues(f1.get("value", "NOT SET"), reference1.value("value"));
+
+        // written by INIFile, read by both
+        QString ours = dir.filePath("inifile.ini");
+        INIFile f2;
+        f2.set("value", value);
+        QVERIFY(f2.saveFile(ours));
+        INIFile f3;
+        QVERIFY(f3.loadFile(ours));
+        QSettings reference2{ ours, QSettings::Format::IniFormat };
+        QCOMPARE(reference2.status(), QSettings::Status::NoError);
+        compareValues(f3.get("value", "NOT SET"), reference2.value("value"));
+        compareValues(f3.get("value", "NOT SET"), f1.get("value", "NOT SET"));
+    }
+
+    void test_Groups()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString fileName = dir.filePath("groups.ini");
+
+        INIFile f1;
+        f1.set("top", "level");
+        f1.set("group/key", "in a group");
+        f1.set("group/nested/key", "deeper");
+        f1.set("General/key", "not the general section");
+        f1.set(QString::fromUtf8("wéird key"), "escaped");
+        QVERIFY(f1.saveFile(fileName));
+
+        QSettings settings{ fileName, QSettings::Format::IniFormat };
+        INIFile f2;
+        QVERIFY(f2.loadFile(fileName));
+        for (auto it = f1.cbegin(); it != f1.cend(); ++it) {
+            QCOMPARE(settings.value(it.key()).toString(), it.value().toString());
+            QCOMPARE(f2.get(it.key(), "NOT SET").toString(), it.value().toString());
+        }
+        QCOMPARE(settings.allKeys().size(), f1.size());
+    }
+
+    void test_LoadFromBuffer()
+    {
+        QByteArray data =
+            "\xef\xbb\xbf[General]\r\n"
+            "; a comment\r\n"
+            "ConfigVersion=1.2\r\n"
+            "  spaced  =  value  \r\n"
+            "continued=first \\\r\nsecond\r\n"
+            "quoted=\"multi\nline\" ; trailing comment\r\n"
+            "list=a, b ,c\r\n"
+            "\r\n"
+            "[group]\r\n"
+            "key=value\r\n";
+
+        INIFile f;
+        QVERIFY(f.loadFile(data));
+        QCOMPARE(f.get("spaced", "NOT SET").toString(), QString("value"));
+        QCOMPARE(f.get("continued", "NOT SET").toString(), QString("first second"));
+        QCOMPARE(f.get("quoted", "NOT SET").toString(), QString("multi\nline"));
+        QCOMPARE(f.get("list", "NOT SET").toStringList(), (QStringList{ "a", "b", "c" }));
+        QCOMPARE(f.get("group/key", "NOT SET").toString(), QString("value"));
+        QCOMPARE(f.size(), 6);
+
+        INIFile broken;
+        QVERIFY(!broken.loadFile(QByteArray("ConfigVersion=1.2\nthis line has no value\n")));
+    }
+
+    void test_LoadMissingFile()
+    {
+        QTemporaryDir dir;
+        INIFile f;
+        f.set("key", "value");
+        // fails like it did with QSettings, and keeps what was there
+        QVERIFY(!f.loadFile(dir.filePath("missing.cfg")));
+        QCOMPARE(f.get("key", "NOT SET").toString(), QString("value"));
+    }
 };
 
 QTEST_GUILESS_MAIN(IniFileTest)
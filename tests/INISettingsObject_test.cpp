@@ -0,0 +1,283 @@
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <settings/INIFile.h>
+#include <settings/INISettingsObject.h>
+#include <settings/Setting.h>
+
+namespace {
+QVariant readBack(const QString& path, const QString& key)
+{
+    INIFile ini;
+    ini.loadFile(path);
+    return ini.get(key, QVariant());
+}
+}  // namespace
+
+class INISettingsObjectTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_synchronousWrites()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("instance.cfg");
+        INISettingsObject settings(path);
+        settings.registerSetting("TotalTimePlayed", 0);
+
+        for (int i = 1; i <= 100; i++)
+            settings.set("TotalTimePlayed", i);
+        // one write per change
+        QCOMPARE(settings.fileWrites(), quint64(100));
+        QCOMPARE(readBack(path, "TotalTimePlayed").toInt(), 100);
+    }
+
+    void test_writeBehindCoalesces()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("instance.cfg");
+        INISettingsObject settings(path);
+        settings.setWriteBehind(true);
+        settings.registerSetting("TotalTimePlayed", 0);
+        settings.registerSetting("LastLaunchTime", 0);
+
+        for (int i = 1; i <= 1000; i++) {
+            settings.set("TotalTimePlayed", i);
+            settings.set("LastLaunchTime", i * 2);
+        }
+        QCOMPARE(settings.fileWrites(), quint64(0));
+
+        settings.flush();
+        QCOMPARE(settings.fileWrites(), quint64(1));
+        QCOMPARE(readBack(path, "TotalTimePlayed").toInt(), 1000);
+        QCOMPARE(readBack(path, "LastLaunchTime").toInt(), 2000);
+
+        // nothing left to write
+        settings.flush();
+        QCOMPARE(settings.fileWrites(), quint64(1));
+    }
+
+    void test_writeBehindTimer()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("instance.cfg");
+        INISettingsObject settings(path);
+        settings.setWriteBehind(true);
+        settings.registerSetting("JoinWorldOnLaunch", "");
+
+        settings.set("JoinWorldOnLaunch", "world");
+        settings.set("JoinWorldOnLaunch", "other world");
+        QTRY_COMPARE(readBack(path, "JoinWorldOnLaunch").toString(), QString("other world"));
+        QCOMPARE(settings.fileWrites(), quint64(1));
+    }
+
+    void test_flushOnDestruction()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("instance.cfg");
+        {
+            INISettingsObject settings(path);
+            settings.setWriteBehind(true);
+            settings.registerSetting("notes", "");
+            settings.set("notes", "some notes");
+        }
+        QCOMPARE(readBack(path, "notes").toString(), QString("some notes"));
+    }
+
+    void test_flushAll()
+    {
+        QTemporaryDir dir;
+        QList<std::shared_ptr<INISettingsObject>> instances;
+        for (int i = 0; i < 10; i++) {
+            auto settings = std::make_shared<INISettingsObject>(dir.filePath(QString("%1.cfg").arg(i)));
+            settings->setWriteBehind(true);
+            settings->registerSetting("InstanceType", "");
+            instances.append(settings);
+        }
+
+        for (int round = 0; round < 10; round++) {
+            for (auto& settings : instances)
+                settings->set("InstanceType", QString("OneSix%1").arg(round));
+        }
+        INISettingsObject::flushAll();
+        // one write per file, not per change
+        for (auto& settings : instances)
+            QCOMPARE(settings->fileWrites(), quint64(1));
+        QCOMPARE(readBack(dir.filePath("3.cfg"), "InstanceType").toString(), QString("OneSix9"));
+    }
+
+    void test_deletedFolder()
+    {
+        // a pending write must not bring back the folder of a deleted instance
+        QTemporaryDir dir;
+        auto root = dir.filePath("instance");
+        QVERIFY(QDir().mkpath(root));
+        auto path = QDir(root).filePath("instance.cfg");
+
+        INISettingsObject settings(path);
+        settings.setWriteBehind(true);
+        settings.registerSetting("name", "");
+        settings.set("name", "gone");
+        QVERIFY(QDir(root).removeRecursively());
+        settings.flush();
+        QVERIFY(!QDir(root).exists());
+    }
+
+    void test_override()
+    {
+        QTemporaryDir dir;
+        INISettingsObject global(dir.filePath("global.cfg"));
+        global.registerSetting("JavaPath", "java");
+        INISettingsObject instance(dir.filePath("instance.cfg"));
+        instance.declareSetting("OverrideJavaLocation", false);
+        instance.declareOverride(global.getSetting("JavaPath"), "OverrideJavaLocation");
+
+        QCOMPARE(instance.get("JavaPath").toString(), QString("java"));
+        global.set("JavaPath", "/usr/bin/java");
+        QCOMPARE(instance.get("JavaPath").toString(), QString("/usr/bin/java"));
+
+        // stored, but only used once the gate is set
+        instance.set("JavaPath", "/opt/java");
+        QCOMPARE(instance.get("JavaPath").toString(), QString("/usr/bin/java"));
+        instance.set("OverrideJavaLocation", true);
+        QCOMPARE(instance.get("JavaPath").toString(), QString("/opt/java"));
+        QCOMPARE(instance.defValue("JavaPath").toString(), QString("/usr/bin/java"));
+
+        instance.reset("JavaPath");
+        QCOMPARE(instance.get("JavaPath").toString(), QString("/usr/bin/java"));
+        QCOMPARE(global.get("JavaPath").toString(), QString("/usr/bin/java"));
+    }
+
+    void test_passthrough()
+    {
+        QTemporaryDir dir;
+        INISettingsObject global(dir.filePath("global.cfg"));
+        global.registerSetting("JavaVersion", "");
+        INISettingsObject instance(dir.filePath("instance.cfg"));
+        instance.declareSetting("OverrideJavaLocation", false);
+        instance.declarePassthrough(global.getSetting("JavaVersion"), "OverrideJavaLocation");
+
+        // without the gate, changes only go to the original
+        instance.set("JavaVersion", "17");
+        QCOMPARE(global.get("JavaVersion").toString(), QString("17"));
+        QCOMPARE(readBack(dir.filePath("instance.cfg"), "JavaVersion"), QVariant());
+
+        instance.set("OverrideJavaLocation", true);
+        instance.set("JavaVersion", "21");
+        QCOMPARE(instance.get("JavaVersion").toString(), QString("21"));
+        QCOMPARE(global.get("JavaVersion").toString(), QString("21"));
+        QCOMPARE(readBack(dir.filePath("instance.cfg"), "JavaVersion").toString(), QString("21"));
+    }
+
+    void test_sharedSchema()
+    {
+        QTemporaryDir dir;
+        INISettingsObject global(dir.filePath("global.cfg"));
+        global.registerSetting("ShowConsole", false);
+
+        QList<std::shared_ptr<INISettingsObject>> instances;
+        for (int i = 0; i < 3; i++) {
+            auto settings = std::make_shared<INISettingsObject>(dir.filePath(QString("%1.cfg").arg(i)));
+            settings->declareSetting("name", "Unnamed Instance");
+            settings->declareSetting({ "OverrideConsole", "OverrideConsoleLegacy" }, false);
+            settings->declareOverride(global.getSetting("ShowConsole"), "OverrideConsole");
+            instances.append(settings);
+        }
+        QCOMPARE(instances[0]->schema(), instances[1]->schema());
+        QCOMPARE(instances[0]->schema(), instances[2]->schema());
+        QCOMPARE(instances[0]->schema()->size(), 3);
+
+        // values stay per instance
+        instances[1]->set("name", "second");
+        QCOMPARE(instances[0]->get("name").toString(), QString("Unnamed Instance"));
+        QCOMPARE(instances[1]->get("name").toString(), QString("second"));
+
+        // the same first setting is shared as well, a different default is a different setting
+        INISettingsObject same(dir.filePath("same.cfg"));
+        same.declareSetting("name", "Unnamed Instance");
+        QCOMPARE(same.schema()->find("name"), instances[0]->schema()->find("name"));
+        INISettingsObject other(dir.filePath("other.cfg"));
+        other.declareSetting("name", "");
+        QVERIFY(other.schema()->find("name") != instances[0]->schema()->find("name"));
+        QVERIFY(!other.declareSetting("name", "again"));
+    }
+
+    void test_settingObjects()
+    {
+        QTemporaryDir dir;
+        INISettingsObject settings(dir.filePath("instance.cfg"));
+        settings.declareSetting("notes", "");
+
+        auto setting = settings.getSetting("notes");
+        QVERIFY(setting);
+        QCOMPARE(settings.getSetting("notes"), setting);
+
+        QStringList changes;
+        connect(setting.get(), &Setting::SettingChanged, this, [&changes](const Setting&, QVariant value) { changes << value.toString(); });
+        settings.set("notes", "set through the object");
+        setting->set("set through the setting");
+        QCOMPARE(changes, (QStringList{ "set through the object", "set through the setting" }));
+        QCOMPARE(setting->get().toString(), QString("set through the setting"));
+    }
+
+    void test_deferredLoad()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("instance.cfg");
+        {
+            INISettingsObject settings(path);
+            settings.declareSetting("name", "");
+            settings.declareSetting("JvmArgs", "");
+            settings.set("name", "on disk");
+            settings.set("JvmArgs", "-Xss2M");
+        }
+
+        INIFile header;
+        header.set("name", "from the index");
+        INISettingsObject settings(path, header, QStringList{ "name", "iconKey" });
+        settings.declareSetting("name", "");
+        settings.declareSetting("iconKey", "default");
+        settings.declareSetting("JvmArgs", "");
+        // known values don't touch the file
+        QCOMPARE(settings.get("name").toString(), QString("from the index"));
+        QCOMPARE(settings.get("iconKey").toString(), QString("default"));
+
+        // changing anything reads the rest first, so it isn't lost when the file is written
+        settings.set("iconKey", "flame");
+        QCOMPARE(settings.get("name").toString(), QString("on disk"));
+        QCOMPARE(readBack(path, "JvmArgs").toString(), QString("-Xss2M"));
+        QCOMPARE(readBack(path, "iconKey").toString(), QString("flame"));
+    }
+
+    void test_deferredLoadFailure()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("instance.cfg");
+        auto writeConfig = [&path](const QByteArray& data) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            file.write(data);
+        };
+        writeConfig("ConfigVersion=1.2\nthis line has no value\n");
+
+        INIFile header;
+        header.set("name", "from the index");
+        INISettingsObject settings(path, header, QStringList{ "name" });
+        settings.declareSetting("name", "");
+        settings.declareSetting("JvmArgs", "");
+
+        // the file can't be read, the known values stay
+        QCOMPARE(settings.get("JvmArgs").toString(), QString());
+        QCOMPARE(settings.get("name").toString(), QString("from the index"));
+
+        // and it is read once it can be
+        writeConfig("ConfigVersion=1.2\nname=on disk\nJvmArgs=-Xss2M\n");
+        QCOMPARE(settings.get("JvmArgs").toString(), QString("-Xss2M"));
+        QCOMPARE(settings.get("name").toString(), QString("on disk"));
+    }
+};
+
+QTEST_GUILESS_MAIN(INISettingsObjectTest)
+
+#include "INISettingsObject_test.moc"
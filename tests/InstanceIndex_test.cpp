@@ -0,0 +1,89 @@
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <InstanceIndex.h>
+
+#include "FileTestUtils.h"
+
+using namespace FileTestUtils;
+
+namespace {
+INIFile readConfig(const QString& path)
+{
+    INIFile config;
+    config.loadFile(path);
+    return config;
+}
+}  // namespace
+
+class InstanceIndexTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_HeaderOnly()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("instance.cfg");
+        writeFile(path, "[General]\nConfigVersion=1.2\nname=Some Instance\niconKey=flame\nJvmArgs=-Xss2M\ntotalTimePlayed=42\n");
+
+        InstanceIndex index(tempDir.filePath("instanceindex.json"));
+        auto fingerprint = FS::fingerprint(QFileInfo(path));
+        QVERIFY(!index.find(path, fingerprint).has_value());
+        index.insert(path, fingerprint, readConfig(path));
+
+        auto header = index.find(path, fingerprint);
+        QVERIFY(header.has_value());
+        QCOMPARE(header->get("name", "").toString(), QString("Some Instance"));
+        QCOMPARE(header->get("totalTimePlayed", 0).toLongLong(), qint64(42));
+        QVERIFY(!header->contains("JvmArgs"));
+        QVERIFY(!header->contains("ConfigVersion"));
+    }
+
+    void test_Invalidation()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("instance.cfg");
+        writeFile(path, "[General]\nname=first\n");
+
+        InstanceIndex index(tempDir.filePath("instanceindex.json"));
+        index.insert(path, FS::fingerprint(QFileInfo(path)), readConfig(path));
+
+        writeFile(path, "[General]\nname=second, longer\n");
+        auto fingerprint = FS::fingerprint(QFileInfo(path));
+        QVERIFY(!index.find(path, fingerprint).has_value());
+
+        // unquoted commas make a list, which is not indexed
+        index.insert(path, fingerprint, readConfig(path));
+        QVERIFY(!index.find(path, fingerprint).has_value());
+    }
+
+    void test_Persistence()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("instance.cfg");
+        auto gone = tempDir.filePath("gone.cfg");
+        writeFile(path, "[General]\nname=kept\n");
+        writeFile(gone, "[General]\nname=gone\n");
+        auto indexFile = tempDir.filePath("instanceindex.json");
+
+        {
+            InstanceIndex index(indexFile);
+            index.insert(path, FS::fingerprint(QFileInfo(path)), readConfig(path));
+            index.insert(gone, FS::fingerprint(QFileInfo(gone)), readConfig(gone));
+            index.retain({ path });
+            index.save();
+        }
+
+        InstanceIndex index(indexFile);
+        auto header = index.find(path, FS::fingerprint(QFileInfo(path)));
+        QVERIFY(header.has_value());
+        QCOMPARE(header->get("name", "").toString(), QString("kept"));
+        QVERIFY(!index.find(gone, FS::fingerprint(QFileInfo(gone))).has_value());
+    }
+};
+
+QTEST_GUILESS_MAIN(InstanceIndexTest)
+
+#include "InstanceIndex_test.moc"
@@ -0,0 +1,147 @@
+#include <QDir>
+#include <QFile>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <java/JavaChecker.h>
+#include <java/JavaProbeCache.h>
+
+#include "FileTestUtils.h"
+
+using namespace FileTestUtils;
+
+namespace {
+JavaChecker::Result someResult(const QString& path)
+{
+    JavaChecker::Result result = { path, 0 };
+    result.validity = JavaChecker::Result::Validity::Valid;
+    result.is_64bit = true;
+    result.mojangPlatform = "64";
+    result.realPlatform = "amd64";
+    result.javaVersion = QString("17.0.8");
+    result.javaVendor = "Eclipse Adoptium";
+    return result;
+}
+}  // namespace
+
+class JavaProbeCacheTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_ReleaseFile()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(QDir(tempDir.path()).mkpath("bin"));
+        auto java = tempDir.filePath("bin/java");
+        writeFile(java, "not really java");
+        QVERIFY(!JavaChecker::readReleaseFile(java).has_value());
+
+        // a runtime for this CPU, as the JDK build names it
+        auto hostArch = QSysInfo::currentCpuArchitecture();
+        auto arch = hostArch == "arm64" ? QString("aarch64") : hostArch;
+        auto release = QString("IMPLEMENTOR=\"Eclipse Adoptium\"\nJAVA_VERSION=\"17.0.8\"\nOS_ARCH=\"%1\"\nOS_NAME=\"Linux\"\n").arg(arch);
+        writeFile(tempDir.filePath("release"), release.toUtf8());
+        auto result = JavaChecker::readReleaseFile(java, 3);
+        QVERIFY(result.has_value());
+        QCOMPARE(result->path, java);
+        QCOMPARE(result->id, 3);
+        QVERIFY(result->validity == JavaChecker::Result::Validity::Valid);
+        QCOMPARE(result->javaVersion.toString(), QString("17.0.8"));
+        QCOMPARE(result->javaVendor, QString("Eclipse Adoptium"));
+        QVERIFY(JavaChecker::canRunArch(result->realPlatform, hostArch));
+
+        // one for another CPU might only run through emulation, so it has to be started
+        writeFile(tempDir.filePath("release"), "IMPLEMENTOR=\"IBM\"\nJAVA_VERSION=\"17.0.8\"\nOS_ARCH=\"s390x\"\n");
+        QVERIFY(!JavaChecker::readReleaseFile(java).has_value());
+
+        // without the vendor the checker has to run after all
+        writeFile(tempDir.filePath("release"), "JAVA_VERSION=\"1.8.0_291\"\nOS_ARCH=\"i586\"\n");
+        QVERIFY(!JavaChecker::readReleaseFile(java).has_value());
+    }
+
+    void test_CanRunArch_data()
+    {
+        QTest::addColumn<QString>("arch");
+        QTest::addColumn<QString>("hostArch");
+        QTest::addColumn<bool>("native");
+
+        QTest::newRow("amd64 on x86_64") << "amd64" << "x86_64" << true;
+        QTest::newRow("x86_64 on x86_64") << "x86_64" << "x86_64" << true;
+        QTest::newRow("x86 on x86_64") << "x86" << "x86_64" << true;
+        QTest::newRow("x86 on i386") << "x86" << "i386" << true;
+        QTest::newRow("amd64 on i386") << "amd64" << "i386" << false;
+        QTest::newRow("aarch64 on arm64") << "aarch64" << "arm64" << true;
+        QTest::newRow("amd64 on arm64") << "amd64" << "arm64" << false;
+        QTest::newRow("aarch64 on x86_64") << "aarch64" << "x86_64" << false;
+        QTest::newRow("aarch64 on arm") << "aarch64" << "arm" << false;
+        QTest::newRow("riscv64 on riscv64") << "riscv64" << "riscv64" << true;
+    }
+
+    void test_CanRunArch()
+    {
+        QFETCH(QString, arch);
+        QFETCH(QString, hostArch);
+        QFETCH(bool, native);
+        QCOMPARE(JavaChecker::canRunArch(arch, hostArch), native);
+    }
+
+    void test_Invalidation()
+    {
+        QTemporaryDir tempDir;
+        auto java = tempDir.filePath("java");
+        writeFile(java, "first");
+
+        JavaProbeCache cache(tempDir.filePath("javaprobes.json"));
+        QVERIFY(!cache.find(java).has_value());
+        cache.insert(java, someResult(java));
+        QVERIFY(cache.find(java).has_value());
+
+        writeFile(java, "second, updated");
+        QVERIFY(!cache.find(java).has_value());
+
+        // failing to start or invalid output may be temporary
+        JavaChecker::Result errored = { java, 0 };
+        cache.insert(java, errored);
+        QVERIFY(!cache.find(java).has_value());
+        auto invalid = someResult(java);
+        invalid.validity = JavaChecker::Result::Validity::ReturnedInvalidData;
+        cache.insert(java, invalid);
+        QVERIFY(!cache.find(java).has_value());
+
+        // another binary with the same size and modification time
+        cache.insert(java, someResult(java));
+        QVERIFY(cache.find(java).has_value());
+        replaceFile(java, "SECOND, UPDATED");
+        QVERIFY(!cache.find(java).has_value());
+    }
+
+    void test_Persistence()
+    {
+        QTemporaryDir tempDir;
+        auto java = tempDir.filePath("java");
+        writeFile(java, "contents");
+        auto cacheFile = tempDir.filePath("javaprobes.json");
+
+        {
+            JavaProbeCache cache(cacheFile);
+            cache.insert(java, someResult(java));
+        }
+        QVERIFY(QFile::exists(cacheFile));
+
+        JavaProbeCache cache(cacheFile);
+        auto result = cache.find(java);
+        QVERIFY(result.has_value());
+        QCOMPARE(result->path, java);
+        QVERIFY(result->validity == JavaChecker::Result::Validity::Valid);
+        QCOMPARE(result->javaVersion.toString(), QString("17.0.8"));
+        QCOMPARE(result->javaVendor, QString("Eclipse Adoptium"));
+        QCOMPARE(result->realPlatform, QString("amd64"));
+        QCOMPARE(result->mojangPlatform, QString("64"));
+        QVERIFY(result->is_64bit);
+    }
+};
+
+QTEST_GUILESS_MAIN(JavaProbeCacheTest)
+
+#include "JavaProbeCache_test.moc"
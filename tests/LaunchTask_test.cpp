@@ -0,0 +1,190 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <launch/LaunchStep.h>
+#include <launch/LaunchTask.h>
+#include <minecraft/MinecraftInstance.h>
+#include <settings/INISettingsObject.h>
+
+/* Records what the launch task does with it. Finishes right away, or when the test says so. */
+class TestStep : public LaunchStep {
+    Q_OBJECT
+   public:
+    TestStep(LaunchTask* parent, QString name, QStringList* events, bool finishRightAway)
+        : LaunchStep(parent), m_name(name), m_events(events), m_finishRightAway(finishRightAway)
+    {
+        setAbortable(true);
+    }
+
+    QString name() const override { return m_name; }
+
+    void succeed() { emitSucceeded(); }
+    void fail() { emitFailed(m_name + " failed"); }
+
+    bool abort() override
+    {
+        m_events->append("abort " + m_name);
+        emitAborted();
+        return true;
+    }
+    void finalize() override { m_events->append("finalize " + m_name); }
+
+   protected:
+    void executeTask() override
+    {
+        m_events->append("start " + m_name);
+        if (m_finishRightAway)
+            emitSucceeded();
+    }
+
+   private:
+    QString m_name;
+    QStringList* m_events;
+    bool m_finishRightAway;
+};
+
+class LaunchTaskTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_tempDir;
+    SettingsObjectPtr m_globalSettings;
+    QStringList m_events;
+
+    MinecraftInstancePtr createInstance()
+    {
+        auto settings = std::make_shared<INISettingsObject>(m_tempDir.filePath("instance.cfg"));
+        return std::make_shared<MinecraftInstance>(m_globalSettings, settings, m_tempDir.path());
+    }
+
+    shared_qobject_ptr<TestStep> step(const shared_qobject_ptr<LaunchTask>& task, const QString& name, bool finishRightAway = false)
+    {
+        return makeShared<TestStep>(task.get(), name, &m_events, finishRightAway);
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        // what the instances pull from the global settings
+        m_globalSettings = std::make_shared<INISettingsObject>(m_tempDir.filePath("global.cfg"));
+        m_globalSettings->registerSetting("ShowGameTime", true);
+        m_globalSettings->registerSetting("RecordGameTime", true);
+        m_globalSettings->registerSetting({ "PreLaunchCommand", "PreLaunchCmd" }, "");
+        m_globalSettings->registerSetting("WrapperCommand", "");
+        m_globalSettings->registerSetting({ "PostExitCommand", "PostExitCmd" }, "");
+        m_globalSettings->registerSetting("ShowConsole", false);
+        m_globalSettings->registerSetting("AutoCloseConsole", false);
+        m_globalSettings->registerSetting("ShowConsoleOnError", true);
+        m_globalSettings->registerSetting("LogPrePostOutput", true);
+        m_globalSettings->registerSetting("ConsoleMaxLines", 100000);
+        m_globalSettings->registerSetting("ConsoleOverflowStop", true);
+    }
+
+    void init() { m_events.clear(); }
+
+    void test_dependencyOrder()
+    {
+        auto task = LaunchTask::create(createInstance());
+        auto a = step(task, "a", true);
+        auto b = step(task, "b", true);
+        auto c = step(task, "c", true);
+        // added in a different order than they have to run in, b waits for c
+        task->appendStep(a);
+        task->appendStep(c, { a });
+        task->appendStep(b);
+
+        task->start();
+        QTRY_VERIFY(task->isFinished());
+        QVERIFY(task->wasSuccessful());
+        QCOMPARE(m_events, QStringList({ "start a", "start c", "start b", "finalize b", "finalize c", "finalize a" }));
+    }
+
+    void test_independentStepsOverlap()
+    {
+        auto task = LaunchTask::create(createInstance());
+        auto a = step(task, "a");
+        auto b = step(task, "b");
+        auto c = step(task, "c");
+        auto d = step(task, "d");
+        task->appendStep(a);
+        task->appendStep(b, { a });
+        task->appendStep(c, { a });
+        task->appendStep(d);
+
+        task->start();
+        QTRY_VERIFY(a->isRunning());
+        QVERIFY(!b->isRunning());
+        a->succeed();
+        QTRY_VERIFY(b->isRunning() && c->isRunning());
+
+        // d depends on everything before it
+        c->succeed();
+        QTest::qWait(10);
+        QVERIFY(!d->isRunning());
+        b->succeed();
+        QTRY_VERIFY(d->isRunning());
+        d->succeed();
+
+        QTRY_VERIFY(task->isFinished());
+        QVERIFY(task->wasSuccessful());
+        QCOMPARE(m_events,
+                 QStringList({ "start a", "start b", "start c", "start d", "finalize d", "finalize c", "finalize b", "finalize a" }));
+    }
+
+    void test_failureCancelsDependents()
+    {
+        auto task = LaunchTask::create(createInstance());
+        auto a = step(task, "a");
+        auto b = step(task, "b");
+        auto c = step(task, "c");
+        auto d = step(task, "d");
+        task->appendStep(a);
+        task->appendStep(b, { a });
+        task->appendStep(c, { a });
+        task->appendStep(d, { b });
+
+        task->start();
+        QTRY_VERIFY(a->isRunning());
+        a->succeed();
+        QTRY_VERIFY(b->isRunning() && c->isRunning());
+        b->fail();
+
+        QTRY_VERIFY(task->isFinished());
+        QVERIFY(!task->wasSuccessful());
+        QCOMPARE(task->failReason(), QString("b failed"));
+        // the step running alongside is stopped and the one depending on the failed step never starts
+        QVERIFY(!c->isRunning());
+        QVERIFY(!m_events.contains("start d"));
+        QCOMPARE(m_events, QStringList({ "start a", "start b", "start c", "abort c", "finalize c", "finalize b", "finalize a" }));
+    }
+
+    void test_finalizeInReverseStartOrder()
+    {
+        auto task = LaunchTask::create(createInstance());
+        auto a = step(task, "a");
+        auto b = step(task, "b");
+        auto c = step(task, "c");
+        task->appendStep(a);
+        task->appendStep(b, { a });
+        task->appendStep(c, { a });
+        // a step that runs before everything else is started first, and finalized last
+        auto first = step(task, "first", true);
+        task->prependStep(first);
+
+        task->start();
+        QTRY_VERIFY(a->isRunning());
+        a->succeed();
+        QTRY_VERIFY(b->isRunning() && c->isRunning());
+        // the order they finish in doesn't matter
+        c->succeed();
+        b->succeed();
+
+        QTRY_VERIFY(task->isFinished());
+        QVERIFY(task->wasSuccessful());
+        QCOMPARE(m_events, QStringList({ "start first", "start a", "start b", "start c", "finalize c", "finalize b", "finalize a",
+                                         "finalize first" }));
+    }
+};
+
+QTEST_GUILESS_MAIN(LaunchTaskTest)
+
+#include "LaunchTask_test.moc"
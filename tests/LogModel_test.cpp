@@ -0,0 +1,77 @@
+#include <QTest>
+
+#include <launch/LogModel.h>
+
+class LogModelTest : public QObject {
+    Q_OBJECT
+
+    static QStringList contents(LogModel& model)
+    {
+        QStringList out;
+        for (int i = 0; i < model.rowCount(); i++)
+            out << model.data(model.index(i), Qt::DisplayRole).toString();
+        return out;
+    }
+
+   private slots:
+    void test_wrap()
+    {
+        LogModel model;
+        model.setMaxLines(5);
+        for (int i = 0; i < 12; i++)
+            model.append(MessageLevel::Info, QString::number(i));
+        QCOMPARE(contents(model), QStringList({ "7", "8", "9", "10", "11" }));
+        QCOMPARE(model.toPlainText(), QString("7\n8\n9\n10\n11\n"));
+
+        model.setMaxLines(3);
+        QCOMPARE(contents(model), QStringList({ "9", "10", "11" }));
+        model.setMaxLines(6);
+        model.append(MessageLevel::Info, "12");
+        QCOMPARE(model.toPlainText(), QString("9\n10\n11\n12\n"));
+
+        model.clear();
+        QCOMPARE(model.rowCount(), 0);
+        QCOMPARE(model.toPlainText(), QString());
+    }
+
+    void test_text()
+    {
+        LogModel model;
+        QString unicode = QString::fromUtf8("Grüße aus \xe6\x9d\xb1\xe4\xba\xac \xf0\x9f\x8e\xae");
+        model.append(MessageLevel::Warning, unicode);
+        model.append(MessageLevel::Error, QString());
+        model.append(MessageLevel::Info, QString(100000, 'x'));
+        QCOMPARE(contents(model), QStringList({ unicode, QString(), QString(100000, 'x') }));
+        QCOMPARE(model.data(model.index(0), LogModel::LevelRole).toInt(), int(MessageLevel::Warning));
+        QCOMPARE(model.data(model.index(1), LogModel::LevelRole).toInt(), int(MessageLevel::Error));
+        QCOMPARE(model.toPlainText(), unicode + "\n\n" + QString(100000, 'x') + "\n");
+    }
+
+    void test_memory()
+    {
+        // a full log of ordinary lines should cost little more than the text itself, even after wrapping around a few times
+        const int maxLines = 100000;
+        LogModel model;
+        model.setMaxLines(maxLines);
+        qint64 textSize = 0;
+        for (int i = 0; i < maxLines * 3; i++) {
+            auto line = QString("[12:34:56] [Server thread/INFO] [minecraft/DedicatedServer]: Preparing spawn area: %1%").arg(i % 100);
+            if (i >= maxLines * 2)
+                textSize += line.toUtf8().size() + 1;
+            model.append(MessageLevel::Info, line);
+        }
+        QCOMPARE(model.rowCount(), maxLines);
+
+        auto usage = model.memoryUsage();
+        // the retained text itself has to be in there
+        QVERIFY(usage >= textSize);
+        // the index plus at most one partially used chunk on either end
+        QVERIFY(usage < textSize + maxLines * 32 + 256 * 1024);
+        // the same lines as separate QStrings would take at least twice the UTF-8 size
+        QVERIFY(usage < textSize * 2);
+    }
+};
+
+QTEST_GUILESS_MAIN(LogModelTest)
+
+#include "LogModel_test.moc"
@@ -0,0 +1,146 @@
+#include <QTest>
+#include <QTextCodec>
+
+#include <SpscRingBuffer.h>
+#include <launch/LogModel.h>
+#include <launch/LogPipeline.h>
+
+#include <thread>
+
+class LogPipelineTest : public QObject {
+    Q_OBJECT
+
+    static QStringList contents(LogModel& model)
+    {
+        QStringList out;
+        for (int i = 0; i < model.rowCount(); i++)
+            out << model.data(model.index(i), Qt::DisplayRole).toString();
+        return out;
+    }
+
+   private slots:
+    void test_ringBuffer()
+    {
+        SpscRingBuffer<int> ring(3);
+        QCOMPARE(ring.capacity(), std::size_t(4));
+        QVERIFY(ring.isEmpty());
+        for (int i = 0; i < 4; i++) {
+            int value = i;
+            QVERIFY(ring.push(std::move(value)));
+        }
+        int rejected = 4;
+        QVERIFY(!ring.push(std::move(rejected)));
+        for (int i = 0; i < 4; i++) {
+            auto value = ring.pop();
+            QVERIFY(value.has_value());
+            QCOMPARE(*value, i);
+        }
+        QVERIFY(!ring.pop().has_value());
+    }
+
+    void test_ringBufferThreaded()
+    {
+        SpscRingBuffer<int> ring(64);
+        const int count = 100000;
+        std::thread producer([&ring] {
+            for (int i = 0; i < count; i++) {
+                int value = i;
+                while (!ring.push(std::move(value)))
+                    std::this_thread::yield();
+            }
+        });
+        int expected = 0;
+        while (expected < count) {
+            if (auto value = ring.pop()) {
+                QCOMPARE(*value, expected);
+                expected++;
+            }
+        }
+        producer.join();
+        QVERIFY(ring.isEmpty());
+    }
+
+    void test_batchAppend_data()
+    {
+        QTest::addColumn<bool>("stopOnOverflow");
+        QTest::addColumn<int>("batchSize");
+
+        for (bool stop : { false, true })
+            for (int size : { 1, 3, 7, 25 })
+                QTest::addRow("%s, batches of %d", stop ? "stop" : "wrap", size) << stop << size;
+    }
+
+    void test_batchAppend()
+    {
+        QFETCH(bool, stopOnOverflow);
+        QFETCH(int, batchSize);
+
+        // appending in batches has to end up with the same content as appending line by line
+        LogModel single;
+        LogModel batched;
+        for (auto model : { &single, &batched }) {
+            model->setMaxLines(10);
+            model->setStopOnOverflow(stopOnOverflow);
+            model->setOverflowMessage("OVERFLOW");
+        }
+        QVector<LogModel::Line> batch;
+        for (int i = 0; i < 42; i++) {
+            single.append(MessageLevel::Info, QString::number(i));
+            batch.append({ MessageLevel::Info, QString::number(i) });
+            if (batch.size() == batchSize) {
+                batched.append(batch);
+                batch.clear();
+            }
+        }
+        batched.append(batch);
+        QCOMPARE(contents(batched), contents(single));
+    }
+
+    void test_pipeline()
+    {
+        LogPipeline pipeline;
+        LogModel model;
+        connect(&pipeline, &LogPipeline::linesReady, &model, [&model](const QVector<LogModel::Line>& lines) { model.append(lines); });
+        pipeline.setCensorFilter(CensorFilter({ { "hunter2", "<PASSWORD>" } }));
+        pipeline.setClassifier([](const QString& line, MessageLevel::Enum level) {
+            return line.contains("WARN") ? MessageLevel::Warning : level;
+        });
+
+        auto codec = QTextCodec::codecForName("UTF-8");
+        pipeline.addLines({ "Launching" }, MessageLevel::Launcher);
+        // lines and multi-byte characters split between reads
+        pipeline.addData("first line\r\nsecond ", MessageLevel::StdOut, codec);
+        pipeline.addData("line with hunter2\nthird \xc3", MessageLevel::StdOut, codec);
+        pipeline.addData("\xa4 WARN\n", MessageLevel::StdOut, codec);
+        pipeline.addData("!![Error]!broken\n", MessageLevel::StdErr, codec);
+        pipeline.flush();
+
+        QCOMPARE(contents(model),
+                 QStringList({ "Launching", "first line", "second line with <PASSWORD>", QString::fromUtf8("third \xc3\xa4 WARN"), "broken" }));
+        auto level = [&model](int row) { return model.data(model.index(row), LogModel::LevelRole).toInt(); };
+        QCOMPARE(level(0), int(MessageLevel::Launcher));
+        QCOMPARE(level(1), int(MessageLevel::StdOut));
+        QCOMPARE(level(3), int(MessageLevel::Warning));
+        QCOMPARE(level(4), int(MessageLevel::Error));
+    }
+
+    void test_pipelineBatches()
+    {
+        // a log spamming lines is handed out in a few large batches instead of line by line
+        LogPipeline pipeline;
+        int batches = 0;
+        int lines = 0;
+        connect(&pipeline, &LogPipeline::linesReady, this, [&](const QVector<LogModel::Line>& batch) {
+            batches++;
+            lines += batch.size();
+        });
+        for (int i = 0; i < 10000; i++)
+            pipeline.addLines({ QString("spam %1").arg(i) }, MessageLevel::StdOut);
+        QTRY_COMPARE(lines, 10000);
+        QVERIFY(batches < 10000);
+    }
+};
+
+QTEST_GUILESS_MAIN(LogPipelineTest)
+
+#include "LogPipeline_test.moc"
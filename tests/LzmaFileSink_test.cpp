@@ -0,0 +1,147 @@
+#include <QCryptographicHash>
+#include <QFile>
+#include <QNetworkReply>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <lzma.h>
+
+#include <FileSystem.h>
+#include <net/ChecksumValidator.h>
+#include <net/LzmaFileSink.h>
+
+namespace {
+// a finished download, as far as the sink cares
+class FinishedReply : public QNetworkReply {
+   public:
+    FinishedReply()
+    {
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 200);
+        open(QIODevice::ReadOnly);
+    }
+    void abort() override {}
+
+   protected:
+    qint64 readData(char*, qint64) override { return -1; }
+};
+
+QByteArray someData()
+{
+    // bigger than the decoder's output buffer, so it gets written in several pieces
+    QByteArray data;
+    for (int i = 0; i < 20000; i++)
+        data.append(QString("line %1 of some runtime file\n").arg(i).toUtf8());
+    return data;
+}
+
+QByteArray compress(const QByteArray& data, bool legacy)
+{
+    lzma_stream strm = LZMA_STREAM_INIT;
+    lzma_ret ret;
+    if (legacy) {
+        lzma_options_lzma options;
+        lzma_lzma_preset(&options, LZMA_PRESET_DEFAULT);
+        ret = lzma_alone_encoder(&strm, &options);
+    } else {
+        ret = lzma_easy_encoder(&strm, LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64);
+    }
+    if (ret != LZMA_OK)
+        return {};
+    QByteArray out(data.size() + 64 * 1024, Qt::Uninitialized);
+    strm.next_in = reinterpret_cast<const uint8_t*>(data.constData());
+    strm.avail_in = data.size();
+    strm.next_out = reinterpret_cast<uint8_t*>(out.data());
+    strm.avail_out = out.size();
+    ret = lzma_code(&strm, LZMA_FINISH);
+    out.resize(strm.total_out);
+    lzma_end(&strm);
+    return ret == LZMA_STREAM_END ? out : QByteArray();
+}
+
+// feeds the data to the sink in small pieces, like a network reply would
+Task::State feed(Net::LzmaFileSink& sink, const QByteArray& data)
+{
+    for (int pos = 0; pos < data.size(); pos += 4096) {
+        auto chunk = data.mid(pos, 4096);
+        auto state = sink.write(chunk);
+        if (state != Task::State::Running)
+            return state;
+    }
+    return Task::State::Running;
+}
+}  // namespace
+
+class LzmaFileSinkTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_RoundTrip_data()
+    {
+        QTest::addColumn<bool>("legacy");
+        QTest::newRow("lzma") << true;
+        QTest::newRow("xz") << false;
+    }
+
+    void test_RoundTrip()
+    {
+        QFETCH(bool, legacy);
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("lib/runtime.so");
+        auto data = someData();
+        auto compressed = compress(data, legacy);
+        QVERIFY(!compressed.isEmpty());
+
+        Net::LzmaFileSink sink(path);
+        // the validators check what ends up on disk, not what was downloaded
+        sink.addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, QCryptographicHash::hash(data, QCryptographicHash::Sha1)));
+        QNetworkRequest request;
+        QCOMPARE(sink.init(request), Task::State::Running);
+        QCOMPARE(feed(sink, compressed), Task::State::Running);
+        FinishedReply reply;
+        QCOMPARE(sink.finalize(reply), Task::State::Succeeded);
+        QCOMPARE(FS::read(path), data);
+    }
+
+    void test_Truncated()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("runtime.so");
+        auto compressed = compress(someData(), false);
+
+        Net::LzmaFileSink sink(path);
+        QNetworkRequest request;
+        QCOMPARE(sink.init(request), Task::State::Running);
+        QCOMPARE(feed(sink, compressed.left(compressed.size() / 2)), Task::State::Running);
+        FinishedReply reply;
+        QCOMPARE(sink.finalize(reply), Task::State::Failed);
+        QVERIFY(!QFile::exists(path));
+    }
+
+    void test_TrailingData()
+    {
+        QTemporaryDir tempDir;
+        auto compressed = compress(someData(), false);
+
+        Net::LzmaFileSink sink(tempDir.filePath("runtime.so"));
+        QNetworkRequest request;
+        QCOMPARE(sink.init(request), Task::State::Running);
+        QCOMPARE(feed(sink, compressed), Task::State::Running);
+        QByteArray garbage("not part of the stream");
+        QCOMPARE(sink.write(garbage), Task::State::Failed);
+    }
+
+    void test_Garbage()
+    {
+        QTemporaryDir tempDir;
+        Net::LzmaFileSink sink(tempDir.filePath("runtime.so"));
+        QNetworkRequest request;
+        QCOMPARE(sink.init(request), Task::State::Running);
+        // not a valid .xz or .lzma header
+        QByteArray garbage(1024, '\xff');
+        QCOMPARE(sink.write(garbage), Task::State::Failed);
+    }
+};
+
+QTEST_GUILESS_MAIN(LzmaFileSinkTest)
+
+#include "LzmaFileSink_test.moc"
@@ -0,0 +1,154 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <MMCZip.h>
+#include <minecraft/mod/Mod.h>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
+class MMCZipTest : public QObject {
+    Q_OBJECT
+
+    static void createZip(const QString& path, const QMap<QString, QByteArray>& entries)
+    {
+        QuaZip zip(path);
+        QVERIFY(zip.open(QuaZip::mdCreate));
+        for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+            QuaZipFile file(&zip);
+            QVERIFY(file.open(QIODevice::WriteOnly, QuaZipNewInfo(it.key())));
+            file.write(it.value());
+            file.close();
+        }
+        zip.close();
+        QCOMPARE(zip.getZipError(), 0);
+    }
+
+    static QMap<QString, QByteArray> readZip(const QString& path)
+    {
+        QMap<QString, QByteArray> entries;
+        QuaZip zip(path);
+        if (!zip.open(QuaZip::mdUnzip))
+            return entries;
+        QuaZipFile file(&zip);
+        for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+            if (!file.open(QIODevice::ReadOnly))
+                continue;
+            entries.insert(zip.getCurrentFileName(), file.readAll());
+            file.close();
+        }
+        return entries;
+    }
+
+    static QMap<QString, QuaZipFileInfo64> readInfos(const QString& path)
+    {
+        QMap<QString, QuaZipFileInfo64> infos;
+        QuaZip zip(path);
+        if (!zip.open(QuaZip::mdUnzip))
+            return infos;
+        for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+            QuaZipFileInfo64 info;
+            if (zip.getCurrentFileInfo(&info))
+                infos.insert(info.name, info);
+        }
+        return infos;
+    }
+
+    // the entry was copied as it was stored, not decompressed and compressed again
+    static void compareRaw(const QuaZipFileInfo64& actual, const QuaZipFileInfo64& expected)
+    {
+        QCOMPARE(actual.method, expected.method);
+        QCOMPARE(actual.compressedSize, expected.compressedSize);
+        QCOMPARE(actual.uncompressedSize, expected.uncompressedSize);
+        QCOMPARE(actual.crc, expected.crc);
+    }
+
+   private slots:
+    void test_mergeZipFiles()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto modPath = dir.filePath("mod.zip");
+        auto jarPath = dir.filePath("minecraft.jar");
+        auto outPath = dir.filePath("out.jar");
+
+        QByteArray compressible(200000, 'a');
+        createZip(modPath, { { "a.class", "modded a" }, { "big.txt", compressible } });
+        createZip(jarPath, { { "a.class", "vanilla a" }, { "b.class", "vanilla b" }, { "META-INF/MANIFEST.MF", "signed" } });
+
+        QuaZip out(outPath);
+        QVERIFY(out.open(QuaZip::mdCreate));
+        QSet<QString> contained;
+        QVERIFY(MMCZip::mergeZipFiles(&out, QFileInfo(modPath), contained));
+        QVERIFY(MMCZip::mergeZipFiles(&out, QFileInfo(jarPath), contained, [](const QString& name) { return !name.contains("META-INF"); }));
+        out.close();
+        QCOMPARE(out.getZipError(), 0);
+
+        // the entries are copied without recompressing them, but still read back the same
+        QMap<QString, QByteArray> expected{ { "a.class", "modded a" }, { "big.txt", compressible }, { "b.class", "vanilla b" } };
+        QCOMPARE(readZip(outPath), expected);
+        QVERIFY(QFileInfo(outPath).size() < compressible.size());
+
+        auto modInfos = readInfos(modPath);
+        auto jarInfos = readInfos(jarPath);
+        auto outInfos = readInfos(outPath);
+        QCOMPARE(outInfos.size(), 3);
+        compareRaw(outInfos["a.class"], modInfos["a.class"]);
+        compareRaw(outInfos["big.txt"], modInfos["big.txt"]);
+        compareRaw(outInfos["b.class"], jarInfos["b.class"]);
+        QVERIFY(outInfos["big.txt"].compressedSize < quint64(compressible.size()));
+    }
+
+    void test_createCachedModdedJar()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QVERIFY(QDir(dir.path()).mkpath("bin"));
+        QVERIFY(QDir(dir.path()).mkpath("jarmods"));
+        auto jarPath = dir.filePath("minecraft-vanilla.jar");
+        auto modPath = dir.filePath("jarmods/mod.jar");
+        auto finalJarPath = dir.filePath("bin/minecraft.jar");
+        auto cachedJarPath = dir.filePath("bin/minecraft.cached.jar");
+        auto keyPath = dir.filePath("bin/minecraft.cached.key");
+
+        createZip(jarPath, { { "a.class", "vanilla a" }, { "b.class", "vanilla b" }, { "META-INF/MANIFEST.MF", "signed" } });
+        createZip(modPath, { { "a.class", "modded a" } });
+        Mod mod(modPath);
+        QList<Mod*> jarMods{ &mod };
+
+        QMap<QString, QByteArray> modded{ { "a.class", "modded a" }, { "b.class", "vanilla b" } };
+        QVERIFY(MMCZip::createCachedModdedJar(jarPath, finalJarPath, jarMods));
+        QCOMPARE(readZip(finalJarPath), modded);
+        QVERIFY(QFileInfo::exists(cachedJarPath));
+        QVERIFY(QFileInfo::exists(keyPath));
+        auto built = FS::fingerprint(QFileInfo(cachedJarPath));
+        auto key = FS::read(keyPath);
+
+        // the launch removes the jar again afterwards, nothing changed for the next one
+        QVERIFY(QFile::remove(finalJarPath));
+        QVERIFY(MMCZip::createCachedModdedJar(jarPath, finalJarPath, jarMods));
+        QCOMPARE(readZip(finalJarPath), modded);
+        QVERIFY(FS::fingerprint(QFileInfo(cachedJarPath)) == built);
+        QCOMPARE(FS::read(keyPath), key);
+
+        // disabling the jar mod changes what the jar is built from
+        QVERIFY(QFile::remove(finalJarPath));
+        QVERIFY(mod.enable(EnableAction::DISABLE));
+        QVERIFY(MMCZip::createCachedModdedJar(jarPath, finalJarPath, jarMods));
+        QMap<QString, QByteArray> vanilla{ { "a.class", "vanilla a" }, { "b.class", "vanilla b" } };
+        QCOMPARE(readZip(finalJarPath), vanilla);
+        QVERIFY(FS::read(keyPath) != key);
+
+        // and enabling it again brings the modded one back
+        QVERIFY(QFile::remove(finalJarPath));
+        QVERIFY(mod.enable(EnableAction::ENABLE));
+        QVERIFY(MMCZip::createCachedModdedJar(jarPath, finalJarPath, jarMods));
+        QCOMPARE(readZip(finalJarPath), modded);
+        QCOMPARE(FS::read(keyPath), key);
+    }
+};
+
+QTEST_GUILESS_MAIN(MMCZipTest)
+
+#include "MMCZip_test.moc"
@@ -0,0 +1,240 @@
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <net/HttpMetaCache.h>
+#include <net/MetaCacheIndex.h>
+
+namespace {
+MetaCacheRecord makeRecord(const QString& base, const QString& path, int n)
+{
+    MetaCacheRecord record;
+    record.base = base;
+    record.path = path;
+    record.md5sum = QString("md5-%1").arg(n);
+    record.etag = QString("\"etag-%1\"").arg(n);
+    record.remoteChangedTimestamp = "Tue, 01 Oct 2024 12:00:00 GMT";
+    record.localChangedTimestamp = 1000 + n;
+    record.currentAge = n;
+    record.maxAge = 100 + n;
+    record.eternal = n % 2;
+    record.size = 10 * n;
+    record.inode = Q_UINT64_C(0x100000000) + n;
+    record.metadataChangedTimestamp = 2000 + n;
+    return record;
+}
+
+MetaCacheJournalEntry put(const MetaCacheRecord& record)
+{
+    MetaCacheJournalEntry entry;
+    entry.record = record;
+    return entry;
+}
+
+MetaCacheJournalEntry removal(const QString& base, const QString& path)
+{
+    MetaCacheJournalEntry entry;
+    entry.removed = true;
+    entry.record.base = base;
+    entry.record.path = path;
+    return entry;
+}
+
+void compareRecords(const MetaCacheRecord& actual, const MetaCacheRecord& expected)
+{
+    QCOMPARE(actual.base, expected.base);
+    QCOMPARE(actual.path, expected.path);
+    QCOMPARE(actual.md5sum, expected.md5sum);
+    QCOMPARE(actual.etag, expected.etag);
+    QCOMPARE(actual.remoteChangedTimestamp, expected.remoteChangedTimestamp);
+    QCOMPARE(actual.localChangedTimestamp, expected.localChangedTimestamp);
+    QCOMPARE(actual.currentAge, expected.currentAge);
+    QCOMPARE(actual.maxAge, expected.maxAge);
+    QCOMPARE(actual.eternal, expected.eternal);
+    QCOMPARE(actual.size, expected.size);
+    QCOMPARE(actual.inode, expected.inode);
+    QCOMPARE(actual.metadataChangedTimestamp, expected.metadataChangedTimestamp);
+}
+}  // namespace
+
+class MetaCacheIndexTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_SnapshotRoundTrip()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("metacache");
+
+        QList<MetaCacheRecord> records;
+        for (int i = 0; i < 100; i++)
+            records.append(makeRecord(i % 3 ? "libraries" : "assets", QString("some/path/%1.jar").arg(i), i));
+        {
+            MetaCacheIndex index(path);
+            QVERIFY(!index.open());
+            QVERIFY(index.compact(records));
+        }
+        QVERIFY(QFile::exists(path + ".idx"));
+
+        MetaCacheIndex index(path);
+        QVERIFY(index.open());
+        QCOMPARE(index.size(), 100u);
+        for (auto& expected : records) {
+            MetaCacheRecord actual;
+            QVERIFY(index.find(expected.base, expected.path, actual));
+            compareRecords(actual, expected);
+        }
+        MetaCacheRecord unused;
+        QVERIFY(!index.find("libraries", "some/path/0.jar", unused));
+        QVERIFY(!index.find("assets", "missing.jar", unused));
+        QCOMPARE(index.records().size(), records.size());
+    }
+
+    void test_InvalidSnapshot()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("metacache");
+        QFile file(path + ".idx");
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("PMCI but not really an index");
+        file.close();
+
+        MetaCacheIndex index(path);
+        QVERIFY(!index.open());
+        QVERIFY(!index.isOpen());
+    }
+
+    void test_JournalReplay()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("metacache");
+        auto first = makeRecord("libraries", "a.jar", 1);
+        auto second = makeRecord("libraries", "b.jar", 2);
+        {
+            MetaCacheIndex index(path);
+            QVERIFY(index.appendToJournal({ put(first), put(second) }));
+            QVERIFY(index.appendToJournal({ removal("libraries", "a.jar") }));
+            QCOMPARE(index.journalLength(), 3);
+        }
+
+        MetaCacheIndex index(path);
+        auto journal = index.readJournal();
+        QCOMPARE(journal.size(), 3);
+        QCOMPARE(index.journalLength(), 3);
+        QVERIFY(!journal[0].removed);
+        compareRecords(journal[0].record, first);
+        compareRecords(journal[1].record, second);
+        QVERIFY(journal[2].removed);
+        QCOMPARE(journal[2].record.path, QString("a.jar"));
+
+        // compacting folds the journal away
+        QVERIFY(index.compact({ second }));
+        QVERIFY(!QFile::exists(path + ".journal"));
+        QCOMPARE(index.journalLength(), 0);
+        QVERIFY(index.readJournal().isEmpty());
+    }
+
+    void test_TornJournal()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("metacache");
+        auto first = makeRecord("libraries", "a.jar", 1);
+        auto second = makeRecord("libraries", "b.jar", 2);
+        {
+            MetaCacheIndex index(path);
+            QVERIFY(index.appendToJournal({ put(first) }));
+        }
+        auto goodSize = QFileInfo(path + ".journal").size();
+        {
+            // the start of a record that was never finished
+            QFile journal(path + ".journal");
+            QVERIFY(journal.open(QIODevice::WriteOnly | QIODevice::Append));
+            journal.write(QByteArray("\x02\x00\x00", 3));
+        }
+
+        {
+            MetaCacheIndex index(path);
+            auto journal = index.readJournal();
+            QCOMPARE(journal.size(), 1);
+            compareRecords(journal[0].record, first);
+            QCOMPARE(QFileInfo(path + ".journal").size(), goodSize);
+            QVERIFY(index.appendToJournal({ put(second) }));
+        }
+
+        // what was appended after the recovery is not hidden behind the torn record
+        MetaCacheIndex index(path);
+        auto journal = index.readJournal();
+        QCOMPARE(journal.size(), 2);
+        compareRecords(journal[0].record, first);
+        compareRecords(journal[1].record, second);
+    }
+
+    void test_JsonMigration()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("metacache");
+        auto root = tempDir.filePath("libraries");
+
+        QJsonObject entry;
+        entry["base"] = "libraries";
+        entry["path"] = "a.jar";
+        entry["md5sum"] = "0123456789abcdef";
+        entry["etag"] = "\"etag\"";
+        entry["last_changed_timestamp"] = 1234.0;
+        entry["remote_changed_timestamp"] = "Tue, 01 Oct 2024 12:00:00 GMT";
+        entry["eternal"] = false;
+        entry["current_age"] = 10.0;
+        entry["max_age"] = 20.0;
+        QJsonObject unknownBase = entry;
+        unknownBase["base"] = "unknown";
+        QJsonObject json;
+        json["version"] = "1";
+        json["entries"] = QJsonArray{ entry, unknownBase };
+        {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(QJsonDocument(json).toJson());
+        }
+
+        {
+            HttpMetaCache cache(path);
+            cache.addBase("libraries", root);
+            cache.Load();
+            auto loaded = cache.getEntry("libraries", "a.jar");
+            QVERIFY(loaded);
+            QCOMPARE(loaded->getMD5Sum(), QString("0123456789abcdef"));
+            QCOMPARE(loaded->getETag(), QString("\"etag\""));
+            QCOMPARE(loaded->getCurrentAge(), qint64(10));
+            QCOMPARE(loaded->getMaximumAge(), qint64(20));
+            QVERIFY(!loaded->isEternal());
+        }
+        QVERIFY(QFile::exists(path + ".idx"));
+
+        // the old file is not looked at once the binary index exists
+        QFile::remove(path);
+        MetaCacheIndex index(path);
+        QVERIFY(index.open());
+        QCOMPARE(index.size(), 1u);
+        MetaCacheRecord record;
+        QVERIFY(index.find("libraries", "a.jar", record));
+        QCOMPARE(record.md5sum, QString("0123456789abcdef"));
+        QCOMPARE(record.localChangedTimestamp, qint64(1234));
+        QCOMPARE(record.size, qint64(-1));
+        index.close();
+
+        HttpMetaCache cache(path);
+        cache.addBase("libraries", root);
+        cache.Load();
+        auto loaded = cache.getEntry("libraries", "a.jar");
+        QVERIFY(loaded);
+        QCOMPARE(loaded->getMD5Sum(), QString("0123456789abcdef"));
+    }
+};
+
+QTEST_GUILESS_MAIN(MetaCacheIndexTest)
+
+#include "MetaCacheIndex_test.moc"
@@ -0,0 +1,117 @@
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <net/HttpMetaCache.h>
+#include <net/MetaCacheVerifyTask.h>
+
+#include "FileTestUtils.h"
+
+using namespace FileTestUtils;
+
+class MetaCacheVerifyTaskTest : public QObject {
+    Q_OBJECT
+
+    // an entry for the file as it is on disk right now, with the given md5sum
+    MetaEntryPtr addEntry(HttpMetaCache& cache, const QString& path, const QString& md5sum)
+    {
+        auto entry = cache.resolveEntry("libraries", path);
+        entry->setMD5Sum(md5sum);
+        entry->setLocalFingerprint(FS::fingerprint(QFileInfo(entry->getFullPath())));
+        entry->setStale(false);
+        cache.updateEntry(entry);
+        return entry;
+    }
+
+    void verify(HttpMetaCache& cache, const QStringList& paths)
+    {
+        Net::MetaCacheVerifyTask task(&cache, "libraries", paths);
+        task.start();
+        QTRY_VERIFY(task.isFinished());
+        QVERIFY(task.wasSuccessful());
+    }
+
+   private slots:
+
+    void test_UnchangedSkipsHashing()
+    {
+        QTemporaryDir tempDir;
+        writeFile(tempDir.filePath("a.jar"), "contents");
+        HttpMetaCache cache(tempDir.filePath("metacache"));
+        cache.addBase("libraries", tempDir.path());
+
+        // the md5sum is wrong, it would be removed if the file got hashed
+        auto entry = addEntry(cache, "a.jar", "not the md5sum");
+        verify(cache, { "a.jar" });
+        QCOMPARE(cache.getEntry("libraries", "a.jar"), entry);
+        QVERIFY(!cache.resolveEntry("libraries", "a.jar")->isStale());
+    }
+
+    void test_ChangedModificationTime()
+    {
+        QTemporaryDir tempDir;
+        QByteArray data("contents");
+        auto md5sum = QString(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
+        auto time = QDateTime::currentDateTimeUtc().addSecs(-3600);
+        for (auto name : { "same.jar", "wrong.jar" }) {
+            writeFile(tempDir.filePath(name), data);
+            setModified(tempDir.filePath(name), time);
+        }
+        HttpMetaCache cache(tempDir.filePath("metacache"));
+        cache.addBase("libraries", tempDir.path());
+        auto same = addEntry(cache, "same.jar", md5sum);
+        addEntry(cache, "wrong.jar", "not the md5sum");
+
+        for (auto name : { "same.jar", "wrong.jar" })
+            setModified(tempDir.filePath(name), time.addSecs(1));
+        verify(cache, { "same.jar", "wrong.jar" });
+
+        // rehashed, the one with the right content stays
+        QCOMPARE(cache.getEntry("libraries", "same.jar"), same);
+        QVERIFY(!cache.getEntry("libraries", "wrong.jar"));
+        QVERIFY(cache.resolveEntry("libraries", "wrong.jar")->isStale());
+    }
+
+    void test_ChangedInode()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("a.jar");
+        auto time = QDateTime::currentDateTimeUtc().addSecs(-3600);
+        writeFile(path, "contents");
+        setModified(path, time);
+        HttpMetaCache cache(tempDir.filePath("metacache"));
+        cache.addBase("libraries", tempDir.path());
+        addEntry(cache, "a.jar", "not the md5sum");
+
+        // same size and modification time, but a different file
+        replaceFile(path, "CONTENTS");
+        verify(cache, { "a.jar" });
+
+        QVERIFY(!cache.getEntry("libraries", "a.jar"));
+    }
+
+    void test_ChangedSize()
+    {
+        QTemporaryDir tempDir;
+        auto path = tempDir.filePath("a.jar");
+        QByteArray data("contents");
+        writeFile(path, data);
+        HttpMetaCache cache(tempDir.filePath("metacache"));
+        cache.addBase("libraries", tempDir.path());
+        addEntry(cache, "a.jar", QString(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex()));
+
+        // a different size is never hashed, resolveEntry drops the entry without reading the file
+        writeFile(path, data + data);
+        verify(cache, { "a.jar" });
+        QVERIFY(cache.resolveEntry("libraries", "a.jar")->isStale());
+        QVERIFY(!cache.getEntry("libraries", "a.jar"));
+    }
+};
+
+QTEST_GUILESS_MAIN(MetaCacheVerifyTaskTest)
+
+#include "MetaCacheVerifyTask_test.moc"
@@ -0,0 +1,75 @@
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <minecraft/mod/ModDetailsCache.h>
+
+#include "FileTestUtils.h"
+
+using namespace FileTestUtils;
+
+namespace {
+ModDetails someDetails()
+{
+    ModDetails details;
+    details.mod_id = "examplemod";
+    details.name = "Example";
+    details.version = "1.2.3";
+    details.authors = QStringList{ "someone", "someone else" };
+    details.licenses.append(ModLicense("MIT", "MIT", "https://opensource.org/licenses/MIT", "MIT License"));
+    details.icon_file = "assets/examplemod/icon.png";
+    return details;
+}
+}  // namespace
+
+class ModDetailsCacheTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    // the invalidation itself is covered by the FingerprintCache test
+    void test_Invalidation()
+    {
+        QTemporaryDir tempDir;
+        QFileInfo mod(tempDir.filePath("mod.jar"));
+        writeFile(mod.filePath(), "first");
+
+        ModDetailsCache cache(tempDir.filePath("moddetails.json"));
+        QVERIFY(!cache.find(mod).has_value());
+        cache.insert(mod, someDetails());
+        QVERIFY(cache.find(mod).has_value());
+
+        // the file info passed in may be outdated
+        writeFile(mod.filePath(), "second");
+        QVERIFY(!cache.find(mod).has_value());
+    }
+
+    void test_Persistence()
+    {
+        QTemporaryDir tempDir;
+        QFileInfo mod(tempDir.filePath("mod.jar"));
+        writeFile(mod.filePath(), "contents");
+        auto cacheFile = tempDir.filePath("moddetails.json");
+
+        {
+            ModDetailsCache cache(cacheFile);
+            cache.insert(mod, someDetails());
+        }
+        QVERIFY(QFile::exists(cacheFile));
+
+        ModDetailsCache cache(cacheFile);
+        auto details = cache.find(mod);
+        QVERIFY(details.has_value());
+        auto expected = someDetails();
+        QCOMPARE(details->mod_id, expected.mod_id);
+        QCOMPARE(details->name, expected.name);
+        QCOMPARE(details->version, expected.version);
+        QCOMPARE(details->authors, expected.authors);
+        QCOMPARE(details->icon_file, expected.icon_file);
+        QCOMPARE(details->licenses.size(), 1);
+        QCOMPARE(details->licenses.first().url, expected.licenses.first().url);
+    }
+};
+
+QTEST_GUILESS_MAIN(ModDetailsCacheTest)
+
+#include "ModDetailsCache_test.moc"
@@ -0,0 +1,141 @@
+#include <QTest>
+
+#include <MurmurHash2.h>
+#include <cstring>
+#include <random>
+
+namespace {
+// the byte at a time implementation the launcher used before, kept as the reference for the fingerprints
+uint32_t referenceHash(const QByteArray& data)
+{
+    const uint32_t m = 0x5bd1e995;
+    const int r = 24;
+    auto filtered_out = [](char c) { return c == 9 || c == 10 || c == 13 || c == 32; };
+
+    uint32_t size = 0;
+    for (auto c : data) {
+        if (!filtered_out(c))
+            size++;
+    }
+
+    uint32_t h = 1 ^ size;
+    unsigned char buffer[4];
+    int index = 0;
+    for (auto c : data) {
+        if (filtered_out(c))
+            continue;
+        buffer[index] = c;
+        index = (index + 1) % 4;
+        if (index == 0) {
+            uint32_t k;
+            memcpy(&k, buffer, 4);
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+            h *= m;
+            h ^= k;
+        }
+    }
+
+    switch (index) {
+        case 3:
+            h ^= buffer[2] << 16;
+            /* fall through */
+        case 2:
+            h ^= buffer[1] << 8;
+            /* fall through */
+        case 1:
+            h ^= buffer[0];
+            h *= m;
+    };
+    h ^= h >> 13;
+    h *= m;
+    h ^= h >> 15;
+    return h;
+}
+
+// random bytes, with some more whitespace than usual
+QByteArray randomData(int size, std::default_random_engine& eng)
+{
+    std::uniform_int_distribution<int> idis(0, 299);
+    QByteArray data(size, Qt::Uninitialized);
+    for (auto& c : data) {
+        auto value = idis(eng);
+        c = value < 256 ? static_cast<char>(value) : " \t\n\r"[value % 4];
+    }
+    return data;
+}
+}  // namespace
+
+class MurmurHash2Test : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_knownValue_data()
+    {
+        QTest::addColumn<QByteArray>("data");
+        QTest::addColumn<uint32_t>("expected");
+        // MurmurHash2 with seed 1 over the data without whitespace, which is what CurseForge uses for its file fingerprints
+        QTest::newRow("empty") << QByteArray("") << uint32_t(1540447798);
+        QTest::newRow("one byte") << QByteArray("a") << uint32_t(626045324);
+        QTest::newRow("two bytes") << QByteArray("ab") << uint32_t(1692487918);
+        QTest::newRow("three bytes") << QByteArray("abc") << uint32_t(1621425345);
+        QTest::newRow("one word") << QByteArray("abcd") << uint32_t(3376380438);
+        QTest::newRow("words and tail") << QByteArray("Hello, World!") << uint32_t(1961219979);
+        // whitespace doesn't change the fingerprint
+        QTest::newRow("whitespace") << QByteArray("a b\tc\r\nd") << uint32_t(3376380438);
+        QTest::newRow("pack.mcmeta") << QByteArray("{\n  \"pack\": {\n    \"pack_format\": 15\n  }\n}\n") << uint32_t(3417099307);
+        QByteArray bytes;
+        for (int i = 0; i < 256; i++)
+            bytes.append(static_cast<char>(i));
+        QTest::newRow("all bytes") << bytes << uint32_t(2094645347);
+    }
+
+    void test_knownValue()
+    {
+        QFETCH(QByteArray, data);
+        QFETCH(uint32_t, expected);
+        QCOMPARE(Murmur2::hashWithoutWhitespace(data.constData(), data.size()), expected);
+        QCOMPARE(referenceHash(data), expected);
+    }
+
+    void test_matchesReference()
+    {
+        std::default_random_engine eng(1);
+        // the sizes around the block and chunk boundaries are the interesting ones
+        for (int size : { 1, 3, 4, 5, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 64 * 1024 - 1, 64 * 1024, 64 * 1024 + 3, 300 * 1024 }) {
+            auto data = randomData(size, eng);
+            QCOMPARE(Murmur2::hashWithoutWhitespace(data.constData(), data.size()), referenceHash(data));
+        }
+    }
+
+    void test_incremental()
+    {
+        std::default_random_engine eng(4);
+        auto data = randomData(100000, eng);
+        Murmur2::Hasher hasher(static_cast<uint32_t>(Murmur2::countNonWhitespace(data.constData(), data.size())));
+        // odd chunk sizes, so the words span chunks
+        for (int pos = 0; pos < data.size(); pos += 777)
+            hasher.addData(data.constData() + pos, qMin(777, data.size() - pos));
+        QCOMPARE(hasher.result(), referenceHash(data));
+    }
+
+    void test_stripWhitespace()
+    {
+        std::default_random_engine eng(2);
+        auto data = randomData(10000, eng);
+        QByteArray expected;
+        for (auto c : data) {
+            if (c != 9 && c != 10 && c != 13 && c != 32)
+                expected.append(c);
+        }
+        QCOMPARE(Murmur2::countNonWhitespace(data.constData(), data.size()), static_cast<std::size_t>(expected.size()));
+        // in place
+        auto written = Murmur2::stripWhitespace(data.constData(), data.size(), data.data());
+        QCOMPARE(data.left(written), expected);
+    }
+};
+
+QTEST_GUILESS_MAIN(MurmurHash2Test)
+
+#include "MurmurHash2_test.moc"
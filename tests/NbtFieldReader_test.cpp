@@ -0,0 +1,130 @@
+#include <QTest>
+#include <QtEndian>
+
+#include <GZip.h>
+#include <minecraft/NbtFieldReader.h>
+
+namespace {
+using Type = NbtFieldReader::TagType;
+
+// minimal NBT writer, enough to lay out level.dat like files
+class Writer {
+   public:
+    template <typename T>
+    Writer& number(T value)
+    {
+        char raw[sizeof(T)];
+        qToBigEndian(value, raw);
+        data.append(raw, sizeof(T));
+        return *this;
+    }
+    Writer& string(const QByteArray& value)
+    {
+        number<quint16>(value.size());
+        data.append(value);
+        return *this;
+    }
+    Writer& tag(Type type, const QByteArray& name)
+    {
+        number<quint8>(static_cast<quint8>(type));
+        return string(name);
+    }
+    Writer& end() { return number<quint8>(0); }
+
+    QByteArray data;
+};
+
+// a modded level.dat, with a big registry next to the few fields that are shown
+QByteArray levelDat(int registryEntries)
+{
+    Writer w;
+    w.tag(Type::Compound, "");
+    {
+        w.tag(Type::Compound, "FML");
+        w.tag(Type::List, "Registries").number<quint8>(static_cast<quint8>(Type::Compound)).number<qint32>(registryEntries);
+        for (int i = 0; i < registryEntries; i++) {
+            w.tag(Type::String, "K").string("somemod:block_" + QByteArray::number(i));
+            w.tag(Type::Int, "V").number<qint32>(i);
+            w.tag(Type::LongArray, "States").number<qint32>(4);
+            for (int j = 0; j < 4; j++)
+                w.number<qint64>(j);
+            w.end();
+        }
+        w.end();
+
+        w.tag(Type::Compound, "Data");
+        w.tag(Type::String, "LevelName").string("A World");
+        w.tag(Type::Long, "LastPlayed").number<qint64>(Q_INT64_C(1700000000000));
+        w.tag(Type::Int, "GameType").number<qint32>(1);
+        w.tag(Type::ByteArray, "Blob").number<qint32>(3).number<qint8>(1).number<qint8>(2).number<qint8>(3);
+        w.tag(Type::List, "Empty").number<quint8>(0).number<qint32>(0);
+        w.tag(Type::Compound, "WorldGenSettings");
+        w.tag(Type::Long, "seed").number<qint64>(-42);
+        w.end();
+        w.end();
+    }
+    w.end();
+    return w.data;
+}
+
+NbtFieldReader levelDatReader()
+{
+    return NbtFieldReader({ "Data.LevelName", "Data.LastPlayed", "Data.GameType", "Data.WorldGenSettings.seed", "Data.RandomSeed" });
+}
+}  // namespace
+
+class NbtFieldReaderTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_read_data()
+    {
+        QTest::addColumn<bool>("compress");
+        QTest::newRow("gzip") << true;
+        QTest::newRow("uncompressed") << false;
+    }
+
+    void test_read()
+    {
+        QFETCH(bool, compress);
+        auto data = levelDat(1000);
+        if (compress)
+            QVERIFY(GZip::zip(QByteArray(data), data));
+
+        auto reader = levelDatReader();
+        QVERIFY(reader.read(data));
+        QVERIFY(reader.hasCompound("Data"));
+        auto name = reader.string("Data.LevelName");
+        QVERIFY(name.has_value());
+        QCOMPARE(*name, QString("A World"));
+        auto lastPlayed = reader.longValue("Data.LastPlayed");
+        QVERIFY(lastPlayed.has_value());
+        QCOMPARE(*lastPlayed, Q_INT64_C(1700000000000));
+        auto gameType = reader.intValue("Data.GameType");
+        QVERIFY(gameType.has_value());
+        QCOMPARE(*gameType, 1);
+        auto seed = reader.longValue("Data.WorldGenSettings.seed");
+        QVERIFY(seed.has_value());
+        QCOMPARE(*seed, Q_INT64_C(-42));
+        QVERIFY(!reader.longValue("Data.RandomSeed").has_value());
+        // the type has to match as well
+        QVERIFY(!reader.intValue("Data.LastPlayed").has_value());
+    }
+
+    void test_malformed()
+    {
+        auto data = levelDat(10);
+        auto reader = levelDatReader();
+        QVERIFY(!reader.read(data.left(data.size() / 2)));
+        QVERIFY(!reader.read(QByteArray()));
+        QVERIFY(!reader.read("not nbt at all"));
+
+        QByteArray compressed;
+        QVERIFY(GZip::zip(data, compressed));
+        QVERIFY(!reader.read(compressed.left(compressed.size() - 20)));
+    }
+};
+
+QTEST_GUILESS_MAIN(NbtFieldReaderTest)
+
+#include "NbtFieldReader_test.moc"
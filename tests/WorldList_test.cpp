@@ -0,0 +1,101 @@
+#include <QDir>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/WorldList.h>
+
+#include "FileTestUtils.h"
+
+using namespace FileTestUtils;
+
+class WorldListTest : public QObject {
+    Q_OBJECT
+
+    static void addWorld(const QString& saves, const QString& name)
+    {
+        QString levelDat = QFINDTESTDATA("testdata/WorldSaveParse/minecraft_save_3/world_3/level.dat");
+        QVERIFY(QDir(saves).mkpath(name));
+        QVERIFY(QFile::copy(levelDat, FS::PathCombine(saves, name, "level.dat")));
+    }
+
+    static QStringList folderNames(const WorldList& list)
+    {
+        QStringList names;
+        for (auto& world : list.allWorlds())
+            names.append(world.folderName());
+        names.sort();
+        return names;
+    }
+
+   private slots:
+    void test_IncrementalScan()
+    {
+        QTemporaryDir tempDir;
+        auto saves = tempDir.filePath("saves");
+        addWorld(saves, "first");
+        addWorld(saves, "second");
+        // no level.dat, not a world
+        QVERIFY(QDir(saves).mkpath("screenshots"));
+
+        WorldList list(saves, nullptr);
+        QVERIFY(list.update());
+        list.waitForUpdate();
+        QCOMPARE(folderNames(list), QStringList({ "first", "second" }));
+
+        // nothing changed, so nothing gets parsed again
+        QSignalSpy changed(&list, &WorldList::dataChanged);
+        QSignalSpy inserted(&list, &WorldList::rowsInserted);
+        QVERIFY(list.update());
+        list.waitForUpdate();
+        QCOMPARE(changed.count(), 0);
+        QCOMPARE(inserted.count(), 0);
+
+        // saving the world writes level.dat, only that one is parsed again
+        auto levelDat = FS::PathCombine(saves, "second", "level.dat");
+        setModified(levelDat, QFileInfo(levelDat).lastModified().addSecs(10));
+        QVERIFY(list.update());
+        list.waitForUpdate();
+        QCOMPARE(changed.count(), 1);
+        auto topLeft = changed.first().at(0).value<QModelIndex>();
+        QCOMPARE(list.allWorlds().at(topLeft.row()).folderName(), QString("second"));
+
+        // new and deleted worlds
+        addWorld(saves, "third");
+        QVERIFY(FS::deletePath(FS::PathCombine(saves, "first")));
+        QVERIFY(list.update());
+        list.waitForUpdate();
+        QCOMPARE(folderNames(list), QStringList({ "second", "third" }));
+        QCOMPARE(inserted.count(), 1);
+
+        // a world that loses its level.dat is dropped as well
+        QVERIFY(QFile::remove(FS::PathCombine(saves, "third", "level.dat")));
+        QVERIFY(list.update());
+        list.waitForUpdate();
+        QCOMPARE(folderNames(list), QStringList({ "second" }));
+    }
+
+    void test_Size()
+    {
+        QTemporaryDir tempDir;
+        auto saves = tempDir.filePath("saves");
+        addWorld(saves, "world");
+        WorldList list(saves, nullptr);
+        QVERIFY(list.update());
+        list.waitForUpdate();
+        QCOMPARE(list.size(), size_t(1));
+        QCOMPARE(list.allWorlds().first().bytes(), int64_t(-1));
+
+        QVERIFY(QDir(saves).mkpath("world/region"));
+        writeFile(FS::PathCombine(saves, "world", "region", "r.0.0.mca"), QByteArray(1000, 'x'));
+        int64_t expected = QFileInfo(FS::PathCombine(saves, "world", "level.dat")).size() + 1000;
+
+        list.requestSize(0);
+        QTRY_COMPARE(list.allWorlds().first().bytes(), expected);
+    }
+};
+
+QTEST_GUILESS_MAIN(WorldListTest)
+
+#include "WorldList_test.moc"
@@ -0,0 +1,205 @@
+#include <QBuffer>
+#include <QDirIterator>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <ZipProbe.h>
+#include <minecraft/mod/tasks/LocalModParseTask.h>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
+namespace {
+void createZip(const QString& path, const QMap<QString, QByteArray>& entries, bool compress)
+{
+    QuaZip zip(path);
+    // mod jars have UTF-8 names, with the flag for it set
+    zip.setUtf8Enabled(true);
+    QVERIFY(zip.open(QuaZip::mdCreate));
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        QuaZipFile file(&zip);
+        QVERIFY(file.open(QIODevice::WriteOnly, QuaZipNewInfo(it.key()), nullptr, 0, compress ? Z_DEFLATED : 0));
+        file.write(it.value());
+        file.close();
+    }
+    zip.close();
+    QCOMPARE(zip.getZipError(), 0);
+}
+
+// what parsing a mod used to cost: one lookup per candidate metadata file, and opening the zip again for the icon
+void referenceProbe(const QString& path)
+{
+    QuaZip zip(path);
+    if (!zip.open(QuaZip::mdUnzip))
+        return;
+    QuaZipFile file(&zip);
+    for (auto name : { "META-INF/mods.toml", "META-INF/neoforge.mods.toml", "mcmod.info", "quilt.mod.json", "fabric.mod.json",
+                       "forgeversion.properties", "META-INF/nil/mappings.json" }) {
+        if (zip.setCurrentFile(name)) {
+            if (file.open(QIODevice::ReadOnly)) {
+                file.readAll();
+                file.close();
+            }
+            break;
+        }
+    }
+    zip.close();
+
+    QuaZip iconZip(path);
+    if (iconZip.open(QuaZip::mdUnzip) && iconZip.setCurrentFile("icon.png")) {
+        QuaZipFile icon(&iconZip);
+        if (icon.open(QIODevice::ReadOnly))
+            icon.readAll();
+    }
+}
+
+// real world jars can be benchmarked by pointing PRISM_BENCHMARK_MODS at a mods folder
+QStringList benchmarkJars()
+{
+    QString dir = qEnvironmentVariable("PRISM_BENCHMARK_MODS");
+    if (dir.isEmpty())
+        dir = QFINDTESTDATA("testdata");
+    QStringList jars;
+    QDirIterator it(dir, { "*.jar" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        jars.append(it.next());
+    return jars;
+}
+}  // namespace
+
+class ZipProbeTest : public QObject {
+    Q_OBJECT
+   private slots:
+
+    void test_read_data()
+    {
+        QTest::addColumn<bool>("compress");
+        QTest::newRow("deflated") << true;
+        QTest::newRow("stored") << false;
+    }
+
+    void test_read()
+    {
+        QFETCH(bool, compress);
+        QTemporaryDir dir;
+        auto path = dir.filePath("mod.jar");
+        QMap<QString, QByteArray> entries{ { "fabric.mod.json", R"({"id": "examplemod"})" },
+                                           { "assets/examplemod/icon.png", QByteArray(10000, '\x89') },
+                                           { "empty.txt", "" },
+                                           { "ünïcode.txt", "name" } };
+        createZip(path, entries, compress);
+
+        ZipProbe zip(path);
+        QVERIFY(zip.open());
+        QCOMPARE(zip.fileNames().size(), entries.size());
+        for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+            QVERIFY(zip.contains(it.key()));
+            auto data = zip.read(it.key());
+            QVERIFY(!data.isNull());
+            QCOMPARE(data, it.value());
+        }
+        QVERIFY(!zip.contains("missing"));
+        QVERIFY(zip.read("missing").isNull());
+    }
+
+    void test_prefixedArchive()
+    {
+        // self-extracting archives have their offsets relative to the start of the zip, not the file
+        QTemporaryDir dir;
+        auto zipPath = dir.filePath("plain.zip");
+        createZip(zipPath, { { "mcmod.info", "[]" } }, true);
+        QFile plain(zipPath);
+        QVERIFY(plain.open(QIODevice::ReadOnly));
+
+        auto path = dir.filePath("prefixed.jar");
+        QFile prefixed(path);
+        QVERIFY(prefixed.open(QIODevice::WriteOnly));
+        prefixed.write(QByteArray(1234, 'x'));
+        prefixed.write(plain.readAll());
+        prefixed.close();
+
+        ZipProbe zip(path);
+        QVERIFY(zip.open());
+        QCOMPARE(zip.read("mcmod.info"), QByteArray("[]"));
+    }
+
+    void test_notAZip()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("mod.jar");
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(100, 'x'));
+        file.close();
+
+        ZipProbe zip(path);
+        QVERIFY(!zip.open());
+        QVERIFY(!ZipProbe(dir.filePath("missing.jar")).open());
+    }
+
+    void test_caseSensitivity()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("mod.jar");
+        createZip(path, { { "META-INF/mods.toml", "modLoader=\"javafml\"" }, { "ÜNÏCODE.txt", "name" } }, true);
+
+        ZipProbe zip(path);
+        QVERIFY(zip.open());
+        QuaZip quazip(path);
+        quazip.setUtf8Enabled(true);
+        QVERIFY(quazip.open(QuaZip::mdUnzip));
+        // the lookups have to find the same entries as the QuaZip based parsing did
+        for (auto name : { "META-INF/mods.toml", "meta-inf/MODS.toml", "META-INF/mods.toml.bak", "ünïcode.txt" }) {
+            bool found = quazip.setCurrentFile(name);
+            QCOMPARE(zip.contains(name), found);
+            QCOMPARE(zip.read(name).isNull(), !found);
+        }
+    }
+
+    void test_iconInSamePass()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("mod.jar");
+        QImage image(16, 16, QImage::Format_ARGB32);
+        image.fill(Qt::red);
+        QByteArray png;
+        QBuffer buffer(&png);
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(image.save(&buffer, "PNG"));
+        createZip(path, { { "fabric.mod.json", R"({"schemaVersion": 1, "id": "examplemod", "icon": "icon.png"})" }, { "icon.png", png } },
+                  true);
+
+        Mod mod{ QFileInfo(path) };
+        QImage icon;
+        QVERIFY(ModUtils::processZIP(mod, ModUtils::ProcessingLevel::Full, &icon));
+        QCOMPARE(mod.details().mod_id, QString("examplemod"));
+        QCOMPARE(icon.size(), QSize(16, 16));
+    }
+
+    void benchmark_quazip()
+    {
+        auto jars = benchmarkJars();
+        QBENCHMARK
+        {
+            for (auto& jar : jars)
+                referenceProbe(jar);
+        }
+    }
+
+    void benchmark_zipProbe()
+    {
+        auto jars = benchmarkJars();
+        QBENCHMARK
+        {
+            for (auto& jar : jars) {
+                Mod mod{ QFileInfo(jar) };
+                QImage icon;
+                ModUtils::processZIP(mod, ModUtils::ProcessingLevel::Full, &icon);
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(ZipProbeTest)
+
+#include "ZipProbe_test.moc"